@@ -8,7 +8,7 @@
 // Event handlers for Object hover events
 void handleObjectHover(const ObjectHoverEvent& event) {
     std::cout << "\n🖱️ === Object Hovering ===" << std::endl;
-    std::cout << "Object: " << event.object.getIdentifier() << std::endl;
+    std::cout << "Object: " << (event.object() ? event.object()->getIdentifier() : std::string("(destroyed)")) << std::endl;
     std::cout << "Hover Point: (" << event.hoverPoint.x << ", " << event.hoverPoint.y << ", " << event.hoverPoint.z << ")" << std::endl;
     std::cout << "Screen Position: (" << event.screenPosition.x << ", " << event.screenPosition.y << ")" << std::endl;
     std::cout << "Timestamp: " << event.timestamp << std::endl;
@@ -17,7 +17,7 @@ void handleObjectHover(const ObjectHoverEvent& event) {
 
 void handleObjectHoverEnter(const ObjectHoverEnterEvent& event) {
     std::cout << "\n🎯 === Object Hover Enter ===" << std::endl;
-    std::cout << "Object: " << event.object.getIdentifier() << std::endl;
+    std::cout << "Object: " << (event.object() ? event.object()->getIdentifier() : std::string("(destroyed)")) << std::endl;
     std::cout << "Enter Point: (" << event.hoverPoint.x << ", " << event.hoverPoint.y << ", " << event.hoverPoint.z << ")" << std::endl;
     std::cout << "Screen Position: (" << event.screenPosition.x << ", " << event.screenPosition.y << ")" << std::endl;
     std::cout << "Timestamp: " << event.timestamp << std::endl;
@@ -26,7 +26,7 @@ void handleObjectHoverEnter(const ObjectHoverEnterEvent& event) {
 
 void handleObjectHoverExit(const ObjectHoverExitEvent& event) {
     std::cout << "\n👋 === Object Hover Exit ===" << std::endl;
-    std::cout << "Object: " << event.object.getIdentifier() << std::endl;
+    std::cout << "Object: " << (event.object() ? event.object()->getIdentifier() : std::string("(destroyed)")) << std::endl;
     std::cout << "Exit Point: (" << event.lastHoverPoint.x << ", " << event.lastHoverPoint.y << ", " << event.lastHoverPoint.z << ")" << std::endl;
     std::cout << "Screen Position: (" << event.lastScreenPosition.x << ", " << event.lastScreenPosition.y << ")" << std::endl;
     std::cout << "Timestamp: " << event.timestamp << std::endl;
@@ -95,6 +95,9 @@ int main() {
         
         std::cout << std::endl;
     }
+
+    // Hover events are deferred; the game loop delivers them before rendering
+    Core::EventBus::instance().flushDeferred(Core::EventBus::FramePhase::PreRender);
     
     std::cout << "\n--- Checking Object States ---" << std::endl;
     
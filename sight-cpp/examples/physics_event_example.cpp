@@ -14,7 +14,8 @@ void setupPhysicsEventSystem() {
     // Listen for collisions involving specific object types
     eventBus.subscribe<Physics::PhysicsCollisionEvent>([](const Physics::PhysicsCollisionEvent& event) {
         // Check if this is a player-object collision
-        if (event.objectA && event.objectA->getIdentifier().find("Player") != std::string::npos) {
+        const Object* a = event.objectA();   // null if destroyed before delivery
+        if (a && a->getIdentifier().find("Player") != std::string::npos) {
             std::cout << "Player hit something!" << std::endl;
             // Trigger player-specific collision response
         }
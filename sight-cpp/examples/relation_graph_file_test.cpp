@@ -0,0 +1,147 @@
+#include "../src/Relation/RelationGraphFile.hpp"
+#include "../src/Relation/RelationManager.hpp"
+#include <iostream>
+#include <fstream>
+#include <iterator>
+#include <cstdio>
+
+// Round trip of a RelationManager through RelationGraphFile, checked against
+// the JSON path, plus rejection of damaged files.
+
+namespace {
+
+int failures = 0;
+
+void check(bool ok, const std::string& what) {
+    std::cout << "  " << (ok ? "✅ " : "❌ ") << what << std::endl;
+    if (!ok) ++failures;
+}
+
+std::vector<char> readBytes(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+void writeBytes(const std::string& path, const std::vector<char>& bytes) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+// The file is little-endian whatever the host
+uint64_t loadLE(const std::vector<char>& bytes, size_t at, size_t width) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < width; ++i) value |= uint64_t(static_cast<uint8_t>(bytes[at + i])) << (8 * i);
+    return value;
+}
+
+void storeLE(std::vector<char>& bytes, size_t at, size_t width, uint64_t value) {
+    for (size_t i = 0; i < width; ++i) bytes[at + i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+}
+
+// Header field offsets (see RelationGraphFile.hpp)
+constexpr size_t StringCountField = 16;
+constexpr size_t ReservedField = 12;
+constexpr size_t AColumnField = 56;
+constexpr size_t RecentOffsetsField = 96;
+
+bool opens(const std::vector<char>& bytes, bool verifyChecksum) {
+    const std::string path = "relation_graph_file_test_bad.bin";
+    writeBytes(path, bytes);
+    RelationGraphFile file;
+    return file.open(path, verifyChecksum);
+}
+
+} // namespace
+
+int main() {
+    std::cout << "🔗 RelationGraphFile Round Trip Test" << std::endl;
+    std::cout << "====================================" << std::endl;
+
+    RelationManager original;
+    for (int i = 0; i < 3000; ++i) {
+        original.add(Relation(i % 3 ? "friend" : "owns", "e" + std::to_string(i % 700),
+                              "e" + std::to_string((i * 31 + 7) % 700), i % 3 == 0, 1.0f + i % 4));
+    }
+    // Reversed undirected endpoints and enough repeats to overflow the
+    // recent-event ring into buckets
+    for (int i = 0; i < 200; ++i) original.add(Relation("friend", "e9", "e1"));
+    original.removeBetween("e5", "e6");
+
+    const std::string path = "relation_graph_file_test.bin";
+    std::cout << "\n1. Binary vs JSON:" << std::endl;
+    check(RelationGraphFile::write(original, path), "write binary file");
+
+    RelationManager fromBinary;
+    check(RelationGraphFile::load(fromBinary, path), "load binary file");
+    RelationManager fromJson;
+    fromJson.loadFromJson(nlohmann::json::parse(original.toJson().dump()));
+
+    check(fromBinary.size() == original.size() && fromJson.size() == original.size(), "same relation count");
+    size_t mismatches = 0;
+    for (const Relation& r : original.getAll()) {
+        const Relation* b = fromBinary.find(r.type, r.entityA, r.entityB, r.directed);
+        const Relation* j = fromJson.find(r.type, r.entityA, r.entityB, r.directed);
+        if (!b || !j || b->weight != r.weight || b->entityA != r.entityA || b->weight != j->weight) {
+            ++mismatches;
+            continue;
+        }
+        const auto& tm = original.timeline();
+        const auto& tb = fromBinary.timeline();
+        const auto& tj = fromJson.timeline();
+        const uint32_t sm = original.slotOf(r), sb = fromBinary.slotOf(*b), sj = fromJson.slotOf(*j);
+        const auto all = tm.summarize(sm, 0, std::time_t(1) << 40);
+        const auto bin = tb.summarize(sb, 0, std::time_t(1) << 40);
+        const auto json = tj.summarize(sj, 0, std::time_t(1) << 40);
+        if (all.count != bin.count || all.weight != bin.weight || bin.count != json.count || bin.weight != json.weight ||
+            tm.totalCount(sm) != tb.totalCount(sb) || tb.totalCount(sb) != tj.totalCount(sj) ||
+            tm.recentEvents(sm).size() != tb.recentEvents(sb).size() ||
+            tb.recentEvents(sb).size() != tj.recentEvents(sj).size()) {
+            ++mismatches;
+        }
+    }
+    check(mismatches == 0, "relations, timelines and summaries match both paths");
+
+    std::cout << "\n2. Lazy access:" << std::endl;
+    RelationGraphFile file;
+    check(file.open(path), "open with checksum");
+    auto range = file.relationsFrom("e9");
+    size_t found = 0, expected = 0;
+    for (uint32_t i = range.first; i < range.second; ++i) found += file.relationAt(i).entityA == "e9";
+    for (const Relation& r : original.getAll()) expected += r.entityA == "e9";
+    check(found == expected && found == range.second - range.first, "relationsFrom(\"e9\") walks exactly its relations");
+    file.close();
+
+    std::cout << "\n3. Damaged files:" << std::endl;
+    const std::vector<char> good = readBytes(path);
+
+    std::vector<char> bytes(good.begin(), good.end() - 8);
+    check(!opens(bytes, true), "truncated file rejected");
+
+    bytes = good;
+    bytes[bytes.size() - 20] ^= 0x55;
+    check(!opens(bytes, true), "flipped body byte fails the checksum");
+
+    bytes = good;
+    bytes[ReservedField] ^= 0x01;
+    check(!opens(bytes, true), "flipped header byte fails the checksum");
+
+    // Structural checks run without the checksum too
+    bytes = good;
+    storeLE(bytes, StringCountField, 8, ~uint64_t(0) / 8);
+    check(!opens(bytes, false), "overflowing string count rejected");
+
+    bytes = good;
+    storeLE(bytes, loadLE(good, AColumnField, 8), 4, 0xFFFFFF00u);
+    check(!opens(bytes, false), "out-of-range string ID rejected");
+
+    bytes = good;
+    storeLE(bytes, loadLE(good, RecentOffsetsField, 8) + 4, 4, 0xFFFFFFFFu);
+    check(!opens(bytes, false), "decreasing event offsets rejected");
+
+    check(opens(good, false), "undamaged file opens without the checksum");
+
+    std::remove(path.c_str());
+    std::remove("relation_graph_file_test_bad.bin");
+    std::cout << "\n" << (failures ? "❌ FAILED" : "✅ PASSED") << std::endl;
+    return failures ? 1 : 0;
+}
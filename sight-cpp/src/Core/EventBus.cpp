@@ -1,20 +1,298 @@
 #include "EventBus.hpp"
+#include "Util/BoundedQueue.hpp"
+#include "Util/StringInterner.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <unordered_set>
+#if defined(__GNUG__)
+#include <cxxabi.h>
+#endif
 
 namespace Core {
 
+namespace {
+
+// Worker shard owned by the current thread, if it is an async worker
+thread_local const void* t_currentShard = nullptr;
+
+constexpr size_t DefaultQueueCapacity = 1024;
+constexpr size_t CoalesceCapacity = 64;
+// Longest a worker thread waits on a full queue under Backpressure::Block.
+// Workers waiting on each other's queues would otherwise never return.
+constexpr auto WorkerBlockLimit = std::chrono::milliseconds(2);
+
+size_t defaultWorkerCount()
+{
+    unsigned cores = std::thread::hardware_concurrency();
+    return std::max<size_t>(1, std::min<size_t>(4, cores / 2));
+}
+
+// Event type names, history source/target IDs and the like
+StringInterner& internedNames()
+{
+    static StringInterner names;
+    return names;
+}
+
+// Interned name of each event type ID
+std::atomic<uint32_t> g_typeNameIds[EventBus::MaxEventTypes] = {};
+
+std::string demangle(const char* name)
+{
+#if defined(__GNUG__)
+    int status = 0;
+    char* readable = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+    if (status == 0 && readable) {
+        std::string result(readable);
+        std::free(readable);
+        return result;
+    }
+#endif
+    return name;
+}
+
+int64_t nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Log-linear latency buckets (HDR style): exact below 8ns, then 8 linear
+// sub-buckets per power of two, i.e. within 12.5% up to ~9 minutes.
+constexpr int LatencySubBits = 3;
+constexpr int LatencySubBuckets = 1 << LatencySubBits;
+constexpr int LatencyMaxBit = 39;
+constexpr int LatencyBuckets = (LatencyMaxBit - LatencySubBits + 2) * LatencySubBuckets;
+
+int latencyBucket(uint64_t ns)
+{
+    if (ns < LatencySubBuckets) return static_cast<int>(ns);
+    int msb = 63 - __builtin_clzll(ns);
+    if (msb > LatencyMaxBit) return LatencyBuckets - 1;
+    int sub = static_cast<int>((ns >> (msb - LatencySubBits)) & (LatencySubBuckets - 1));
+    return (msb - LatencySubBits + 1) * LatencySubBuckets + sub;
+}
+
+uint64_t latencyBucketStart(int bucket)
+{
+    if (bucket < LatencySubBuckets) return static_cast<uint64_t>(bucket);
+    int msb = bucket / LatencySubBuckets + LatencySubBits - 1;
+    uint64_t sub = static_cast<uint64_t>(bucket % LatencySubBuckets);
+    return (LatencySubBuckets + sub) << (msb - LatencySubBits);
+}
+
+} // namespace
+
+struct EventBus::HandlerStats {
+    uint64_t id = 0;
+    uint32_t type = 0;
+    ScopeId scope = GlobalScope;
+    std::string label;   // guarded by EventBus::_mutex
+
+    std::atomic<uint64_t> calls{0};
+    std::atomic<uint64_t> totalNs{0};
+    std::atomic<uint64_t> maxNs{0};
+    std::atomic<uint32_t> buckets[LatencyBuckets] = {};
+
+    void record(uint64_t ns)
+    {
+        calls.fetch_add(1, std::memory_order_relaxed);
+        totalNs.fetch_add(ns, std::memory_order_relaxed);
+        buckets[latencyBucket(ns)].fetch_add(1, std::memory_order_relaxed);
+        uint64_t previous = maxNs.load(std::memory_order_relaxed);
+        while (ns > previous && !maxNs.compare_exchange_weak(previous, ns, std::memory_order_relaxed)) {}
+    }
+
+    // Start of the bucket holding the given fraction of calls
+    double percentileUs(double fraction) const
+    {
+        uint64_t total = 0;
+        for (const auto& bucket : buckets) total += bucket.load(std::memory_order_relaxed);
+        if (total == 0) return 0.0;
+        uint64_t rank = static_cast<uint64_t>(fraction * static_cast<double>(total - 1)) + 1;
+        uint64_t seen = 0;
+        for (int i = 0; i < LatencyBuckets; ++i) {
+            seen += buckets[i].load(std::memory_order_relaxed);
+            if (seen >= rank) return latencyBucketStart(i) / 1000.0;
+        }
+        return maxNs.load(std::memory_order_relaxed) / 1000.0;
+    }
+
+    void reset()
+    {
+        calls.store(0);
+        totalNs.store(0);
+        maxNs.store(0);
+        for (auto& bucket : buckets) bucket.store(0);
+    }
+};
+
+// Fixed-size history, written without locks. Each slot is a small seqlock:
+// writers mark it busy, fill it, then stamp it with its position; readers keep
+// a copy only if the stamp is unchanged across the read.
+struct EventBus::HistoryRing {
+    static constexpr size_t Capacity = 1024;
+
+    struct Slot {
+        std::atomic<uint64_t> stamp{0};   // position + 1; 0 while being written
+        std::atomic<uint32_t> name{0};
+        std::atomic<uint32_t> source{0};
+        std::atomic<uint32_t> target{0};
+        std::atomic<uint32_t> scope{0};
+        std::atomic<int64_t> time{0};
+    };
+
+    Slot slots[Capacity];
+    std::atomic<uint64_t> head{0};
+    std::atomic<uint64_t> floor{0};   // positions before this were reset
+
+    void push(uint32_t name, ScopeId scope, uint32_t source, uint32_t target)
+    {
+        uint64_t pos = head.fetch_add(1, std::memory_order_relaxed);
+        Slot& slot = slots[pos % Capacity];
+        slot.stamp.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.name.store(name, std::memory_order_relaxed);
+        slot.source.store(source, std::memory_order_relaxed);
+        slot.target.store(target, std::memory_order_relaxed);
+        slot.scope.store(scope, std::memory_order_relaxed);
+        slot.time.store(nowNs(), std::memory_order_relaxed);
+        slot.stamp.store(pos + 1, std::memory_order_release);
+    }
+};
+
+// One queued event, stored inline in its queue slot
+struct EventBus::AsyncEvent {
+    alignas(std::max_align_t) unsigned char storage[InlineEventSize];
+    const AsyncOps* ops = nullptr;
+    uint32_t type = 0;
+    ScopeId scope = GlobalScope;
+    uint64_t key = 0;
+};
+
+struct EventBus::AsyncShard {
+    explicit AsyncShard(size_t capacity) : queue(capacity), coalesced(CoalesceCapacity) {}
+
+    BoundedQueue<AsyncEvent> queue;
+    std::thread worker;
+
+    std::mutex sleepMutex;
+    std::condition_variable cv;
+    std::atomic<bool> sleeping{false};
+    bool stopping = false;   // guarded by sleepMutex
+
+    // Events parked by Backpressure::Coalesce while the queue was full. Each
+    // waits until the queue has moved past everything enqueued before it, so
+    // per-key order holds.
+    struct Coalesced {
+        AsyncEvent event;
+        uint64_t ticket = 0;
+        bool used = false;
+    };
+    std::mutex coalesceMutex;
+    std::vector<Coalesced> coalesced;
+    std::atomic<uint32_t> coalescedCount{0};
+};
+
+// Events waiting for a frame phase. Slots live in fixed-size chunks that are
+// kept between frames, so steady-state publishing doesn't allocate.
+struct EventBus::DeferredQueue {
+    static constexpr size_t ChunkSize = 256;
+
+    struct CoalesceKey {
+        uint32_t type;
+        ScopeId scope;
+        DeferredKey key;
+        bool operator==(const CoalesceKey& other) const {
+            return type == other.type && scope == other.scope && key == other.key;
+        }
+    };
+    struct CoalesceKeyHash {
+        size_t operator()(const CoalesceKey& k) const {
+            uint64_t h = k.key.first * 0x9E3779B97F4A7C15ull ^ k.key.second;
+            return std::hash<uint64_t>()(h * 0x9E3779B97F4A7C15ull + (static_cast<uint64_t>(k.scope) << 32 | k.type));
+        }
+    };
+
+    std::vector<std::unique_ptr<AsyncEvent[]>> chunks;
+    size_t count = 0;
+    std::unordered_map<CoalesceKey, size_t, CoalesceKeyHash> coalesced;   // -> slot index
+
+    AsyncEvent& slot(size_t index) { return chunks[index / ChunkSize][index % ChunkSize]; }
+
+    AsyncEvent& append()
+    {
+        if (count == chunks.size() * ChunkSize) chunks.emplace_back(new AsyncEvent[ChunkSize]);
+        return slot(count++);
+    }
+
+    void clear()
+    {
+        for (size_t i = 0; i < count; ++i) {
+            AsyncEvent& event = slot(i);
+            if (event.ops) event.ops->destroy(event.storage);
+            event.ops = nullptr;
+        }
+        count = 0;
+        coalesced.clear();
+    }
+
+    ~DeferredQueue() { clear(); }
+};
+
 // Order of Events
 // local or global
 
 EventBus::EventBus()
+    : _history(std::make_unique<HistoryRing>())
 {
-    _running = true;
-    _worker  = std::thread(&EventBus::processQueue, this);
+    for (auto& phase : _deferred) {
+        phase.buffers[0] = std::make_unique<DeferredQueue>();
+        phase.buffers[1] = std::make_unique<DeferredQueue>();
+    }
+    auto* global = new ScopeNode;
+    global->name = "Global";
+    _scopes[GlobalScope].store(global);
+    _scopeCount = 1;
+    startAsync(defaultWorkerCount(), DefaultQueueCapacity);
 }
 
 EventBus::~EventBus()
 
 {
     shutdown();
+    for (auto& slot : _scopes) {
+        ScopeNode* node = slot.load();
+        if (!node) continue;
+        for (auto& list : node->listeners) delete list.load();
+        delete node;
+    }
+    for (const Retired& retired : _retired) delete retired.list;
+}
+
+uint32_t EventBus::typeIdFor(const std::type_index& type)
+{
+    static std::mutex registryMutex;
+    static std::unordered_map<std::type_index, uint32_t> registry;
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    auto it = registry.find(type);
+    if (it != registry.end()) return it->second;
+
+    uint32_t id = static_cast<uint32_t>(registry.size());
+    if (id >= MaxEventTypes) {
+        printf("EventBus: too many event types, ignoring %s\n", type.name());
+        return MaxEventTypes;
+    }
+    registry.emplace(type, id);
+    g_typeNameIds[id].store(internedNames().intern(demangle(type.name())));
+    return id;
+}
+
+std::string EventBus::getTypeName(uint32_t type)
+{
+    if (type >= MaxEventTypes) return std::string();
+    return internedNames().lookup(g_typeNameIds[type].load());
 }
 
 EventBus& EventBus::instance() {
@@ -29,45 +307,529 @@ EventBus& EventBus::instance() {
 // The priority is an integer that determines the order in which the subscribers are called.
 // The higher the priority, the earlier the subscriber is called.
 // The default priority is 0.
-void EventBus::subscribe(const std::type_index& type, const Listener& listener, int priority)
+EventBus::Subscription EventBus::subscribe(const std::type_index& type, const Listener& listener, int priority, ScopeId scope)
+{
+    return addListener(scope, typeIdFor(type), listener, priority);
+}
+
+EventBus::ScopeId EventBus::createScope(ScopeId parent, const std::string& name)
 {
     std::lock_guard<std::mutex> lock(_mutex);
-    auto& vec = _listeners[type];
-    vec.emplace_back(ListenerEntry{priority, listener});
-    // Keep highest priority first for deterministic ordering.
-    std::sort(vec.begin(), vec.end(), [](const ListenerEntry& a, const ListenerEntry& b){
-        return a.priority > b.priority;
+    if (parent >= _scopeCount || !_scopes[parent].load()->live) parent = GlobalScope;
+    ScopeId id;
+    if (!_freeScopes.empty()) {
+        id = _freeScopes.back();
+        _freeScopes.pop_back();
+    } else if (_scopeCount < MaxScopes) {
+        id = _scopeCount++;
+        _scopes[id].store(new ScopeNode);
+    } else {
+        printf("EventBus: scope limit reached, '%s' shares its parent's scope\n", name.c_str());
+        return parent;
+    }
+    ScopeNode* node = _scopes[id].load();
+    node->parent.store(parent);
+    node->name = name;
+    node->live = true;
+    return id;
+}
+
+void EventBus::releaseScope(ScopeId scope)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (scope == GlobalScope || scope >= _scopeCount) return;
+    ScopeNode* node = _scopes[scope].load();
+    if (!node->live) return;
+
+    // Publishers already inside this scope finish with the lists they
+    // loaded; the lists are retired like any other replaced list
+    for (auto& slot : node->listeners) {
+        const ListenerList* list = slot.load();
+        if (!list) continue;
+        for (const auto& entry : list->entries) retireStats(entry.id);
+        replaceList(slot, nullptr);
+    }
+    const ScopeId parent = node->parent.load();
+    for (uint32_t i = 1; i < _scopeCount; ++i) {
+        ScopeNode* child = _scopes[i].load();
+        if (child->live && child->parent.load() == scope) child->parent.store(parent);
+    }
+    node->live = false;
+    node->name.clear();
+    _freeScopes.push_back(scope);
+}
+
+EventBus::ScopeId EventBus::getScopeParent(ScopeId scope) const
+{
+    const ScopeNode* node = scope < MaxScopes ? _scopes[scope].load() : nullptr;
+    return node ? node->parent.load() : GlobalScope;
+}
+
+std::string EventBus::getScopeName(ScopeId scope) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    const ScopeNode* node = scope < MaxScopes ? _scopes[scope].load() : nullptr;
+    return node ? node->name : std::string();
+}
+
+EventBus::ScopeHandle::ScopeHandle(ScopeId parent, const std::string& name)
+{
+    _id = EventBus::instance().createScope(parent, name);
+    // At the scope limit createScope hands back the parent, which is not ours
+    _owned = _id != parent;
+}
+
+void EventBus::ScopeHandle::reset()
+{
+    if (_owned) EventBus::instance().releaseScope(_id);
+    _id = GlobalScope;
+    _owned = false;
+}
+
+EventBus::Subscription EventBus::addListener(ScopeId scope, uint32_t type, const Listener& listener, int priority)
+{
+    if (type >= MaxEventTypes || scope >= MaxScopes) return {};
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    ScopeNode* node = _scopes[scope].load();
+    if (!node || !node->live) return {};
+    const ListenerList* current = node->listeners[type].load();
+    auto* next = new ListenerList(current ? *current : ListenerList{});
+
+    // Keep highest priority first; equal priorities stay in subscription order.
+    auto pos = std::find_if(next->entries.begin(), next->entries.end(), [priority](const ListenerEntry& e){
+        return e.priority < priority;
     });
+    uint64_t id = _nextListenerId++;
+    auto stats = std::make_unique<HandlerStats>();
+    stats->id = id;
+    stats->type = type;
+    stats->scope = scope;
+    next->entries.insert(pos, ListenerEntry{priority, id, listener, stats.get()});
+    _handlerStats.push_back(std::move(stats));
+
+    replaceList(node->listeners[type], next);
+    return Subscription{type, scope, id};
+}
+
+void EventBus::unsubscribe(const Subscription& subscription)
+{
+    if (!subscription.isValid() || subscription.type >= MaxEventTypes || subscription.scope >= MaxScopes) return;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    ScopeNode* node = _scopes[subscription.scope].load();
+    if (!node) return;
+    const ListenerList* current = node->listeners[subscription.type].load();
+    if (!current) return;
+
+    auto it = std::find_if(current->entries.begin(), current->entries.end(), [&](const ListenerEntry& e){
+        return e.id == subscription.id;
+    });
+    if (it == current->entries.end()) return;
+
+    ListenerList* next = nullptr;
+    if (current->entries.size() > 1) {
+        next = new ListenerList;
+        next->entries.reserve(current->entries.size() - 1);
+        for (const auto& entry : current->entries) {
+            if (entry.id != subscription.id) next->entries.push_back(entry);
+        }
+    }
+    replaceList(node->listeners[subscription.type], next);
+
+    retireStats(subscription.id);
+    reclaimRetired();
+}
+
+void EventBus::retireStats(uint64_t listenerId)
+{
+    // In-flight publishes may still be timing this handler
+    for (size_t i = 0; i < _handlerStats.size(); ++i) {
+        if (_handlerStats[i]->id == listenerId) {
+            _retired.push_back(Retired{_epoch.fetch_add(1), nullptr, std::move(_handlerStats[i])});
+            _handlerStats[i] = std::move(_handlerStats.back());
+            _handlerStats.pop_back();
+            _hasRetired.store(true);
+            break;
+        }
+    }
+}
+
+void EventBus::dispatch(ScopeId scope, uint32_t type, const void* event)
+{
+    if (type >= MaxEventTypes || scope >= MaxScopes) return;
+    {
+        // A list loaded here stays alive until the guard ends: this thread's
+        // epoch keeps everything retired since it entered (and even a
+        // throwing handler leaves)
+        struct Guard {
+            EventBus* bus;
+            explicit Guard(EventBus* b) : bus(b) { bus->enterPublish(); }
+            ~Guard() { bus->leavePublish(); }
+        } guard(this);
+        const bool instrumented = _instrumented.load(std::memory_order_relaxed);
+        if (instrumented) {
+            _publishCounts[type].fetch_add(1, std::memory_order_relaxed);
+            _history->push(g_typeNameIds[type].load(std::memory_order_relaxed), scope, 0, 0);
+        }
+        for (const ScopeNode* node = _scopes[scope].load(); node; ) {
+            const ListenerList* list = node->listeners[type].load();
+            if (list) {
+                for (const auto& entry : list->entries) {
+                    if (instrumented) {
+                        int64_t start = nowNs();
+                        entry.listener(event);
+                        entry.stats->record(static_cast<uint64_t>(nowNs() - start));
+                    } else {
+                        entry.listener(event);
+                    }
+                }
+            }
+            if (node == _scopes[GlobalScope].load()) break;
+            node = _scopes[node->parent.load()].load();
+        }
+    }
+
+    if (_hasRetired.load()) {
+        // Never wait here; whoever holds the lock will reclaim later
+        std::unique_lock<std::mutex> lock(_mutex, std::try_to_lock);
+        if (lock.owns_lock()) reclaimRetired();
+    }
+}
+
+bool EventBus::hasListeners(ScopeId scope, uint32_t type) const
+{
+    if (type >= MaxEventTypes || scope >= MaxScopes) return false;
+    for (const ScopeNode* node = _scopes[scope].load(); node; ) {
+        if (node->listeners[type].load()) return true;
+        if (node == _scopes[GlobalScope].load()) break;
+        node = _scopes[node->parent.load()].load();
+    }
+    return false;
+}
+
+void EventBus::replaceList(std::atomic<const ListenerList*>& slot, const ListenerList* list)
+{
+    const ListenerList* old = slot.exchange(list);
+    if (old) {
+        // Stamped after the swap: a publisher entering at a later epoch can
+        // only load the new list
+        _retired.push_back(Retired{_epoch.fetch_add(1), old, nullptr});
+        _hasRetired.store(true);
+    }
+    reclaimRetired();
+}
+
+void EventBus::reclaimRetired()
+{
+    if (_retired.empty() || _untrackedPublishers.load() != 0) return;
+    // A thread that entered at epoch e may hold anything retired at e or
+    // later. A thread about to record its epoch has not loaded a list yet,
+    // and will load only current ones.
+    uint64_t oldest = UINT64_MAX;
+    for (const auto& slot : _publisherEpochs) {
+        uint64_t epoch = slot.epoch.load();
+        if (epoch != 0 && epoch < oldest) oldest = epoch;
+    }
+    auto stillVisible = std::partition(_retired.begin(), _retired.end(), [oldest](const Retired& r){
+        return r.epoch >= oldest;
+    });
+    for (auto it = stillVisible; it != _retired.end(); ++it) delete it->list;
+    _retired.erase(stillVisible, _retired.end());
+    _hasRetired.store(!_retired.empty());
+}
+
+struct EventBus::PublisherThread {
+    EpochSlot* slot = nullptr;   // null if every slot was taken
+    bool registered = false;
+    uint32_t depth = 0;          // nested publish() calls (handlers publishing)
+
+    ~PublisherThread() {
+        if (slot) slot->claimed.store(false);
+    }
+};
+
+EventBus::PublisherThread& EventBus::publisherThread()
+{
+    thread_local PublisherThread thread;
+    return thread;
+}
+
+void EventBus::enterPublish()
+{
+    PublisherThread& thread = publisherThread();
+    if (thread.depth++ > 0) return;
+    if (!thread.registered) {
+        thread.registered = true;
+        for (auto& slot : _publisherEpochs) {
+            bool expected = false;
+            if (slot.claimed.compare_exchange_strong(expected, true)) {
+                thread.slot = &slot;
+                break;
+            }
+        }
+    }
+    // Sequentially consistent: the epoch is visible before any list is loaded
+    if (thread.slot) thread.slot->epoch.store(_epoch.load());
+    else _untrackedPublishers.fetch_add(1);
+}
+
+void EventBus::leavePublish()
+{
+    PublisherThread& thread = publisherThread();
+    if (--thread.depth > 0) return;
+    if (thread.slot) thread.slot->epoch.store(0);
+    else _untrackedPublishers.fetch_sub(1);
 }
 
 void EventBus::shutdown()
 {
-    if (!_running) return;
+    stopAsync();
+}
+
+void EventBus::configureAsync(size_t workerCount, size_t queueCapacity)
+{
+    stopAsync();
+    startAsync(std::max<size_t>(1, workerCount), std::max<size_t>(2, queueCapacity));
+}
+
+void EventBus::setBackpressure(uint32_t type, Backpressure policy)
+{
+    if (type < MaxEventTypes) _backpressure[type].store(static_cast<uint8_t>(policy));
+}
+
+void EventBus::startAsync(size_t workerCount, size_t queueCapacity)
+{
+    _shards.clear();
+    for (size_t i = 0; i < workerCount; ++i) {
+        _shards.push_back(std::make_unique<AsyncShard>(queueCapacity));
+    }
+    _asyncRunning.store(true);
+    for (auto& shard : _shards) {
+        shard->worker = std::thread(&EventBus::runWorker, this, std::ref(*shard));
+    }
+}
+
+void EventBus::stopAsync()
+{
+    if (!_asyncRunning.exchange(false)) return;
+    for (auto& shard : _shards) {
+        {
+            std::lock_guard<std::mutex> lock(shard->sleepMutex);
+            shard->stopping = true;
+        }
+        shard->cv.notify_all();
+    }
+    for (auto& shard : _shards) {
+        if (shard->worker.joinable()) shard->worker.join();
+        // Anything a racing publisher slipped in after the worker exited
+        while (shard->queue.tryPop([](AsyncEvent& e){ e.ops->destroy(e.storage); })) {}
+    }
+}
+
+void EventBus::enqueueAsync(uint32_t type, uint64_t key, const void* event, const AsyncOps& ops)
+{
+    if (!hasListeners(GlobalScope, type) || !_asyncRunning.load()) return;
+
+    // Same type and key always map to the same worker
+    uint64_t hash = (static_cast<uint64_t>(type) + 1) * 0x9E3779B97F4A7C15ull ^ key;
+    hash ^= hash >> 32;
+    AsyncShard& shard = *_shards[hash % _shards.size()];
+    auto policy = static_cast<Backpressure>(_backpressure[type].load());
+
+    // Once an event is parked for coalescing, later ones with its key join it
+    // rather than overtaking it through the queue.
+    if (policy == Backpressure::Coalesce && shard.coalescedCount.load() > 0 &&
+        tryCoalesce(shard, type, key, event, ops, false)) {
+        wake(shard);
+        return;
+    }
+
+    auto fill = [&](AsyncEvent& slot) {
+        slot.type = type;
+        slot.scope = GlobalScope;
+        slot.key = key;
+        slot.ops = &ops;
+        ops.construct(slot.storage, event);
+    };
+    if (shard.queue.tryPush(fill)) {
+        wake(shard);
+        return;
+    }
+
+    switch (policy) {
+    case Backpressure::Drop:
+        _droppedAsync.fetch_add(1);
+        return;
+    case Backpressure::Coalesce:
+        if (tryCoalesce(shard, type, key, event, ops, true)) wake(shard);
+        else _droppedAsync.fetch_add(1);
+        return;
+    case Backpressure::Block: {
+        // Delivering inline would overtake the queued events. A worker
+        // publishing into its own full queue cannot wait for itself, and
+        // workers waiting on each other could wait forever, so from a worker
+        // the wait is bounded and the event is dropped after it.
+        const bool fromWorker = t_currentShard != nullptr;
+        if (t_currentShard == &shard) {
+            _droppedAsync.fetch_add(1);
+            return;
+        }
+        const auto deadline = std::chrono::steady_clock::now() + WorkerBlockLimit;
+        while (!shard.queue.tryPush(fill)) {
+            if (!_asyncRunning.load()) return;
+            if (fromWorker && std::chrono::steady_clock::now() >= deadline) {
+                _droppedAsync.fetch_add(1);
+                return;
+            }
+            wake(shard);
+            std::this_thread::yield();
+        }
+        wake(shard);
+        return;
+    }
+    }
+}
+
+bool EventBus::tryCoalesce(AsyncShard& shard, uint32_t type, uint64_t key, const void* event, const AsyncOps& ops, bool allowNew)
+{
+    std::lock_guard<std::mutex> lock(shard.coalesceMutex);
+    AsyncShard::Coalesced* freeEntry = nullptr;
+    for (auto& entry : shard.coalesced) {
+        if (entry.used && entry.event.type == type && entry.event.key == key) {
+            // Latest wins
+            ops.destroy(entry.event.storage);
+            ops.construct(entry.event.storage, event);
+            return true;
+        }
+        if (!entry.used && !freeEntry) freeEntry = &entry;
+    }
+    if (!allowNew || !freeEntry) return false;
+
+    freeEntry->event.type = type;
+    freeEntry->event.scope = GlobalScope;
+    freeEntry->event.key = key;
+    freeEntry->event.ops = &ops;
+    ops.construct(freeEntry->event.storage, event);
+    freeEntry->ticket = shard.queue.enqueuePosition();
+    freeEntry->used = true;
+    shard.coalescedCount.fetch_add(1);
+    return true;
+}
+
+void EventBus::wake(AsyncShard& shard)
+{
+    if (shard.sleeping.load()) {
+        std::lock_guard<std::mutex> lock(shard.sleepMutex);
+        shard.cv.notify_one();
+    }
+}
+
+void EventBus::deliver(AsyncEvent& event)
+{
+    dispatch(event.scope, event.type, event.ops->get(event.storage));
+    event.ops->destroy(event.storage);
+    event.ops = nullptr;
+}
+
+bool EventBus::drainCoalesced(AsyncShard& shard)
+{
+    bool delivered = false;
+    while (shard.coalescedCount.load() > 0) {
+        AsyncEvent event;
+        {
+            std::lock_guard<std::mutex> lock(shard.coalesceMutex);
+            uint64_t consumed = shard.queue.dequeuePosition();
+            for (auto& entry : shard.coalesced) {
+                if (entry.used && entry.ticket <= consumed) {
+                    event.type = entry.event.type;
+                    event.scope = entry.event.scope;
+                    event.key = entry.event.key;
+                    event.ops = entry.event.ops;
+                    event.ops->relocate(event.storage, entry.event.storage);
+                    entry.used = false;
+                    shard.coalescedCount.fetch_sub(1);
+                    break;
+                }
+            }
+        }
+        if (!event.ops) break;
+        deliver(event);
+        delivered = true;
+    }
+    return delivered;
+}
+
+void EventBus::enqueueDeferred(FramePhase phase, ScopeId scope, uint32_t type, bool coalesce, const DeferredKey& key, const void* event, const AsyncOps& ops)
+{
+    if (!hasListeners(scope, type)) return;
+
+    DeferredPhase& target = _deferred[static_cast<size_t>(phase)];
+    std::lock_guard<std::mutex> lock(target.mutex);
+    DeferredQueue& queue = *target.buffers[target.active];
+
+    if (coalesce) {
+        auto inserted = queue.coalesced.emplace(DeferredQueue::CoalesceKey{type, scope, key}, queue.count);
+        if (!inserted.second) {
+            // Latest wins, in the earlier event's place
+            AsyncEvent& existing = queue.slot(inserted.first->second);
+            ops.destroy(existing.storage);
+            ops.construct(existing.storage, event);
+            return;
+        }
+    }
+
+    AsyncEvent& slot = queue.append();
+    slot.type = type;
+    slot.scope = scope;
+    slot.key = key.first;   // unused for delivery
+    slot.ops = &ops;
+    ops.construct(slot.storage, event);
+}
+
+void EventBus::flushDeferred(FramePhase phase)
+{
+    DeferredPhase& source = _deferred[static_cast<size_t>(phase)];
+    DeferredQueue* queue;
     {
-        std::lock_guard<std::mutex> lock(_queueMutex);
-        _running = false;
+        std::lock_guard<std::mutex> lock(source.mutex);
+        queue = source.buffers[source.active].get();
+        if (queue->count == 0) return;
+        source.active ^= 1;
     }
-    _cv.notify_all();
-    if (_worker.joinable()) _worker.join();
+
+    for (size_t i = 0; i < queue->count; ++i) {
+        deliver(queue->slot(i));
+    }
+    queue->clear();
 }
 
 // The sum of all Queues should be conceptualized as a Formations instance.
 // Formation of relations should have Queues.
 // Before publishing an event, add the event to the relation, 
 // Relations should be the channel through which queues are connected.
-void EventBus::processQueue()
+void EventBus::runWorker(AsyncShard& shard)
 {
+    t_currentShard = &shard;
     while (true) {
-        Job job;
-        {
-            std::unique_lock<std::mutex> lock(_queueMutex);
-            _cv.wait(lock, [this]{ return !_queue.empty() || !_running; });
-            if (!_running && _queue.empty()) return;
-            job = std::move(_queue.front()); 
-            _queue.pop();
+        bool worked = false;
+        while (shard.queue.tryPop([this](AsyncEvent& e){ deliver(e); })) worked = true;
+        if (drainCoalesced(shard)) worked = true;
+        if (worked) continue;
+
+        if (!shard.queue.empty() || shard.coalescedCount.load() > 0) {
+            // A producer has claimed a slot but not filled it yet
+            std::this_thread::yield();
+            continue;
         }
-        // Execute job without holding queue lock
-        if (job) job();
+
+        std::unique_lock<std::mutex> lock(shard.sleepMutex);
+        if (shard.stopping) return;
+        shard.sleeping.store(true);
+        shard.cv.wait(lock, [&]{
+            return shard.stopping || !shard.queue.empty() || shard.coalescedCount.load() > 0;
+        });
+        shard.sleeping.store(false);
     }
 }
 
@@ -125,26 +887,106 @@ void EventBus::addEventToFormationRelations(const std::string& eventType, const
     
     // For now, we can store the event information in a way that can be
     // later converted to proper Relation objects when the dependencies are available
-    {
-        std::lock_guard<std::mutex> lock(_eventHistoryMutex);
-        _eventHistory.push_back({eventType, sourceId, targetId, std::time(nullptr)});
+    auto& names = internedNames();
+    _history->push(names.intern(eventType), GlobalScope, names.intern(sourceId), names.intern(targetId));
+}
+
+// --------------------------------------------------------------
+// Instrumentation queries
+// --------------------------------------------------------------
+void EventBus::setListenerLabel(const Subscription& subscription, const std::string& label)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto& stats : _handlerStats) {
+        if (stats->id == subscription.id) {
+            stats->label = label;
+            return;
+        }
+    }
+}
+
+std::vector<EventBus::TypeReport> EventBus::getTypeStats() const
+{
+    std::vector<TypeReport> reports;
+    for (uint32_t type = 0; type < MaxEventTypes; ++type) {
+        uint64_t count = _publishCounts[type].load(std::memory_order_relaxed);
+        if (count > 0) reports.push_back({type, getTypeName(type), count});
     }
+    return reports;
+}
+
+std::vector<EventBus::HandlerReport> EventBus::getHandlerStats() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::vector<HandlerReport> reports;
+    for (const auto& stats : _handlerStats) {
+        uint64_t calls = stats->calls.load(std::memory_order_relaxed);
+        if (calls == 0) continue;
+        HandlerReport report;
+        report.id = stats->id;
+        report.eventType = getTypeName(stats->type);
+        report.label = stats->label.empty() ? report.eventType + "#" + std::to_string(stats->id) : stats->label;
+        report.scope = stats->scope;
+        report.calls = calls;
+        double totalNs = static_cast<double>(stats->totalNs.load(std::memory_order_relaxed));
+        report.totalMs = totalNs / 1e6;
+        report.meanUs = totalNs / static_cast<double>(calls) / 1000.0;
+        report.p50Us = stats->percentileUs(0.50);
+        report.p90Us = stats->percentileUs(0.90);
+        report.p99Us = stats->percentileUs(0.99);
+        report.maxUs = stats->maxNs.load(std::memory_order_relaxed) / 1000.0;
+        reports.push_back(std::move(report));
+    }
+    return reports;
+}
+
+std::vector<EventBus::HistoryReport> EventBus::getRecentHistory(size_t maxEntries) const
+{
+    std::vector<HistoryReport> reports;
+    const HistoryRing& ring = *_history;
+    uint64_t head = ring.head.load(std::memory_order_acquire);
+    uint64_t oldest = std::max(ring.floor.load(), head > HistoryRing::Capacity ? head - HistoryRing::Capacity : 0);
+    int64_t now = nowNs();
+    auto& names = internedNames();
+
+    for (uint64_t pos = head; pos > oldest && reports.size() < maxEntries; --pos) {
+        const HistoryRing::Slot& slot = ring.slots[(pos - 1) % HistoryRing::Capacity];
+        uint64_t stamp = slot.stamp.load(std::memory_order_acquire);
+        uint32_t name = slot.name.load(std::memory_order_relaxed);
+        uint32_t source = slot.source.load(std::memory_order_relaxed);
+        uint32_t target = slot.target.load(std::memory_order_relaxed);
+        ScopeId scope = slot.scope.load(std::memory_order_relaxed);
+        int64_t time = slot.time.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        // Skip slots still being written or already overwritten by a newer lap
+        if (stamp != pos || slot.stamp.load(std::memory_order_relaxed) != stamp) continue;
+
+        reports.push_back({pos, names.lookup(name), names.lookup(source), names.lookup(target),
+                           scope, static_cast<double>(now - time) / 1e9});
+    }
+    return reports;
+}
+
+void EventBus::resetStats()
+{
+    for (auto& count : _publishCounts) count.store(0);
+    _history->floor.store(_history->head.load());
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto& stats : _handlerStats) stats->reset();
 }
 
 // Helper method to determine event scope (local vs global)
 EventBus::EventScope EventBus::determineEventScope(const std::string& eventType, const std::string& sourceId)
 {
     // Global events are typically system-wide events
-    static const std::vector<std::string> globalEventTypes = {
+    static const std::unordered_set<std::string> globalEventTypes = {
         "system_startup", "system_shutdown", "user_login", "user_logout",
         "zone_created", "zone_destroyed", "formation_created", "formation_destroyed"
     };
     
     // Check if this is a global event type
-    for (const auto& globalType : globalEventTypes) {
-        if (eventType == globalType) {
-            return EventScope::Global;
-        }
+    if (globalEventTypes.count(eventType)) {
+        return EventScope::Global;
     }
     
     // Local events are typically within a specific formation or zone
@@ -5,25 +5,71 @@
 #include <vector>
 #include <typeindex>
 #include <mutex>
-#include <queue>
 #include <condition_variable>
 #include <thread>
 #include <memory>
 #include <chrono>
 #include <algorithm>
 #include <string>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 // Forward declarations
 class Formations;
 
 namespace Core {
 
+// Identity of a coalesced deferred event. Two words, so an event about a
+// pair of 64-bit IDs is compared exactly instead of through a hash of both.
+struct DeferredKey {
+    uint64_t first = 0;
+    uint64_t second = 0;
+
+    DeferredKey() = default;
+    DeferredKey(uint64_t key) : first(key) {}
+    DeferredKey(uint64_t a, uint64_t b) : first(a), second(b) {}
+    bool operator==(const DeferredKey& other) const { return first == other.first && second == other.second; }
+};
+
+// Coalescing rule for deferred events. A type that defines
+// `coalesceKey() const` (returning uint64_t or DeferredKey) keeps only its
+// latest event per key until the phase is flushed; specialize this for types
+// that can't carry the member.
+template<typename Event, typename = void>
+struct DeferredCoalesce {
+    static constexpr bool enabled = false;
+};
+
+template<typename Event>
+struct DeferredCoalesce<Event, std::void_t<decltype(std::declval<const Event&>().coalesceKey())>> {
+    static constexpr bool enabled = true;
+    static DeferredKey key(const Event& event) { return event.coalesceKey(); }
+};
+
 // Very lightweight, header-only publish/subscribe Event Bus.
 //  - Any struct/class can be used as an event type.
 //  - Listeners register with subscribe<T>(handler).
 //  - Publishers emit with publish(const T&).
 //  - Delivery is synchronous and happens on the thread that calls publish().
-//  - Internally stores type-erased function pointers keyed by std::type_index.
+//  - subscribe() returns a Subscription token; unsubscribe() removes the listener.
+//  - Each event type gets a dense ID on first use. Its listeners live in an
+//    immutable list that subscribe/unsubscribe replace atomically, so publish()
+//    takes no lock and handlers may publish or (un)subscribe freely.
+//  - publishAsync() copies the event into a preallocated slot of a bounded
+//    queue and a pool of worker threads delivers it. Events of one type (or
+//    one key, with publishAsyncByKey) always go to the same worker, in order.
+//  - publishDeferred() holds an event until the game flushes its frame phase,
+//    keeping handlers out of hot loops (see DeferredCoalesce for de-duplication).
+//  - Scopes form a tree (global -> zone -> formation). A listener subscribes
+//    in one scope; an event published to a scope reaches that scope and its
+//    ancestors only, so other zones' listeners cost nothing.
+//  - With instrumentation on, the bus counts publishes per type, times every
+//    handler into a latency histogram and keeps a fixed-size history ring.
+//    Off, it costs one relaxed load per publish.
 //
 // Example:
 //     struct PlayerJumped { int playerId; };
@@ -38,7 +84,35 @@ public:
     // Public types
     // ------------------------------------------------------------------
     using Listener = std::function<void(const void*)>;
-    struct ListenerEntry { int priority; Listener listener; };
+    struct HandlerStats;
+    struct ListenerEntry { int priority; uint64_t id; Listener listener; HandlerStats* stats; };
+
+    using ScopeId = uint32_t;
+    static constexpr ScopeId GlobalScope = 0;
+
+    // Handle for one registered listener
+    struct Subscription {
+        uint32_t type = 0;
+        ScopeId scope = GlobalScope;
+        uint64_t id = 0;   // 0 = not subscribed
+        bool isValid() const { return id != 0; }
+    };
+
+    // Upper bound on distinct event types
+    static constexpr uint32_t MaxEventTypes = 256;
+    // Upper bound on scopes alive at once (released IDs are reused)
+    static constexpr uint32_t MaxScopes = 1024;
+
+    // Points in the frame where deferred events are delivered
+    enum class FramePhase : uint8_t { PostInput, PostPhysics, PreRender };
+    static constexpr size_t FramePhaseCount = 3;
+
+    // What publishAsync() does when the worker's queue is full
+    enum class Backpressure : uint8_t {
+        Block,     // wait for space; from a worker thread, wait briefly and then drop
+        Drop,      // discard the new event
+        Coalesce   // replace the pending event with the same type and key
+    };
     
     // Lightweight metadata automatically attached to each event. Can be
     // extended later without breaking the templated interface.
@@ -58,69 +132,177 @@ public:
     // ------------------------------------------------------------------
     static EventBus& instance();
 
+    // ------------------------------------------------------------------
+    // Event type IDs ----------------------------------------------------
+    // ------------------------------------------------------------------
+    template<typename Event>
+    static uint32_t typeId()
+    {
+        static const uint32_t id = typeIdFor(typeid(Event));
+        return id;
+    }
+
+    static uint32_t typeIdFor(const std::type_index& type);
+
+    // ------------------------------------------------------------------
+    // Scopes ------------------------------------------------------------
+    // ------------------------------------------------------------------
+    // New child scope; falls back to `parent` once MaxScopes is reached.
+    ScopeId createScope(ScopeId parent, const std::string& name);
+    // Drops the scope's listeners and frees its ID for reuse; its children
+    // move up to its parent. The global scope cannot be released.
+    void releaseScope(ScopeId scope);
+    ScopeId getScopeParent(ScopeId scope) const;
+    std::string getScopeName(ScopeId scope) const;
+
+    // Owns one scope from createScope() and releases it when destroyed.
+    // Move-only, so an owner that is copied has to create its own.
+    class ScopeHandle {
+    public:
+        ScopeHandle() = default;
+        ScopeHandle(ScopeId parent, const std::string& name);
+        ~ScopeHandle() { reset(); }
+        ScopeHandle(ScopeHandle&& other) noexcept
+            : _id(std::exchange(other._id, GlobalScope)), _owned(std::exchange(other._owned, false)) {}
+        ScopeHandle& operator=(ScopeHandle&& other) noexcept
+        {
+            if (this != &other) {
+                reset();
+                _id = std::exchange(other._id, GlobalScope);
+                _owned = std::exchange(other._owned, false);
+            }
+            return *this;
+        }
+        ScopeHandle(const ScopeHandle&) = delete;
+        ScopeHandle& operator=(const ScopeHandle&) = delete;
+
+        ScopeId id() const { return _id; }
+        void reset();
+
+    private:
+        ScopeId _id = GlobalScope;
+        bool _owned = false;   // false at the scope limit, when _id is the parent's
+    };
+
     // ------------------------------------------------------------------
     // Subscription ------------------------------------------------------
     // ------------------------------------------------------------------
     template<typename Event>
-    void subscribe(const std::function<void(const Event&)>& handler, int priority = 0)
+    Subscription subscribe(const std::function<void(const Event&)>& handler, int priority = 0, ScopeId scope = GlobalScope)
     {
-        std::lock_guard<std::mutex> lock(_mutex);
-        auto& vec = _listeners[typeid(Event)];
-        vec.emplace_back(ListenerEntry{priority, [handler](const void* ePtr){
+        return addListener(scope, typeId<Event>(), [handler](const void* ePtr){
             handler(*static_cast<const Event*>(ePtr));
-        }});
-        // Keep highest priority first for deterministic ordering.
-        std::sort(vec.begin(), vec.end(), [](const ListenerEntry& a, const ListenerEntry& b){
-            return a.priority > b.priority;
-        });
+        }, priority);
     }
 
     // Non-template version for internal use
-    void subscribe(const std::type_index& type, const Listener& listener, int priority = 0);
+    Subscription subscribe(const std::type_index& type, const Listener& listener, int priority = 0, ScopeId scope = GlobalScope);
+
+    void unsubscribe(const Subscription& subscription);
 
     // ------------------------------------------------------------------
     // Publication (synchronous) -----------------------------------------
     // ------------------------------------------------------------------
+    // Global listeners only
     template<typename Event>
     void publish(const Event& event, const Metadata& meta = {})
     {
-        std::lock_guard<std::mutex> lock(_mutex);
-        auto it = _listeners.find(typeid(Event));
-        if (it == _listeners.end()) return;
-        for (auto& entry : it->second) {
-            entry.listener(&event);
-        }
+        dispatch(GlobalScope, typeId<Event>(), &event);
+    }
+
+    // Listeners in `scope` first, then each ancestor up to global
+    template<typename Event>
+    void publishTo(ScopeId scope, const Event& event, const Metadata& meta = {})
+    {
+        dispatch(scope, typeId<Event>(), &event);
     }
 
     // ------------------------------------------------------------------
     // Publication (asynchronous) ---------------------------------------
     // ------------------------------------------------------------------
+    // Ordered per event type
     template<typename Event>
     void publishAsync(const Event& event, const Metadata& meta = {})
     {
-        // Copy listeners snapshot under lock, then enqueue work item.
-        std::vector<ListenerEntry> listenersCopy;
-        {
-            std::lock_guard<std::mutex> lock(_mutex);
-            auto it = _listeners.find(typeid(Event));
-            if (it != _listeners.end()) listenersCopy = it->second;
-        }
-        if (listenersCopy.empty()) return;
+        enqueueAsync(typeId<Event>(), 0, &event, asyncOpsFor<Event>());
+    }
 
-        auto ePtr = std::make_shared<Event>(event); // shared to outlive lambda
-        auto job  = [listenersCopy, ePtr]() {
-            for (auto& entry : listenersCopy) {
-                entry.listener(ePtr.get());
-            }
-        };
+    // Ordered per key only, so different keys can be delivered in parallel
+    // (e.g. one key per object). No ordering against publishAsync().
+    template<typename Event>
+    void publishAsyncByKey(uint64_t key, const Event& event, const Metadata& meta = {})
+    {
+        enqueueAsync(typeId<Event>(), key, &event, asyncOpsFor<Event>());
+    }
 
-        {
-            std::lock_guard<std::mutex> lock(_queueMutex);
-            _queue.emplace(std::move(job));
+    template<typename Event>
+    void setBackpressure(Backpressure policy) { setBackpressure(typeId<Event>(), policy); }
+    void setBackpressure(uint32_t type, Backpressure policy);
+
+    // Restart the async workers; call while no other thread is publishing.
+    // Pending events are delivered first.
+    void configureAsync(size_t workerCount, size_t queueCapacity);
+    size_t getAsyncWorkerCount() const { return _shards.size(); }
+    uint64_t getDroppedAsyncCount() const { return _droppedAsync.load(); }
+
+    // ------------------------------------------------------------------
+    // Publication (deferred to a frame phase) ---------------------------
+    // ------------------------------------------------------------------
+    // Delivered as publishTo(scope, event) when `phase` is flushed
+    template<typename Event>
+    void publishDeferred(FramePhase phase, const Event& event, ScopeId scope = GlobalScope)
+    {
+        if constexpr (DeferredCoalesce<Event>::enabled) {
+            enqueueDeferred(phase, scope, typeId<Event>(), true, DeferredCoalesce<Event>::key(event), &event, asyncOpsFor<Event>());
+        } else {
+            enqueueDeferred(phase, scope, typeId<Event>(), false, DeferredKey(), &event, asyncOpsFor<Event>());
         }
-        _cv.notify_one();
     }
 
+    // Deliver everything queued for `phase`, in publish order (a coalesced
+    // event keeps the position of the first one it replaced). Events
+    // published while flushing wait for the next flush. Called from the game
+    // loop; flushes of one phase must not nest.
+    void flushDeferred(FramePhase phase);
+
+    // ------------------------------------------------------------------
+    // Instrumentation ---------------------------------------------------
+    // ------------------------------------------------------------------
+    struct TypeReport {
+        uint32_t type;
+        std::string name;
+        uint64_t publishCount;
+    };
+    struct HandlerReport {
+        uint64_t id;
+        std::string label;
+        std::string eventType;
+        ScopeId scope;
+        uint64_t calls;
+        double totalMs;
+        double meanUs, p50Us, p90Us, p99Us, maxUs;
+    };
+    struct HistoryReport {
+        uint64_t sequence;
+        std::string eventType;
+        std::string sourceId;   // empty for plain publishes
+        std::string targetId;
+        ScopeId scope;
+        double ageSeconds;
+    };
+
+    void setInstrumentation(bool enabled) { _instrumented.store(enabled); }
+    bool isInstrumented() const { return _instrumented.load(std::memory_order_relaxed); }
+
+    // Name shown for a listener in reports (defaults to "<event type>#<id>")
+    void setListenerLabel(const Subscription& subscription, const std::string& label);
+
+    static std::string getTypeName(uint32_t type);
+    std::vector<TypeReport> getTypeStats() const;       // types published at least once
+    std::vector<HandlerReport> getHandlerStats() const; // live listeners that ran
+    std::vector<HistoryReport> getRecentHistory(size_t maxEntries) const; // newest first
+    void resetStats();
+
     // ------------------------------------------------------------------
     // Formation and Relation Integration ---------------------------------
     // ------------------------------------------------------------------
@@ -134,33 +316,138 @@ public:
     // ------------------------------------------------------------------
     // Lifecycle ---------------------------------------------------------
     // ------------------------------------------------------------------
-    void shutdown(); // gracefully stop worker thread
+    void shutdown(); // deliver pending async events and stop the workers
 
 private:
-    // Listener registry keyed by event type ---------------------------------
-    std::unordered_map<std::type_index, std::vector<ListenerEntry>> _listeners;
-    std::mutex   _mutex;
+    // Listener registry, per scope and indexed by event type ID -------------
+    // Lists are never modified once published. Writers hold _mutex, build a new
+    // list and swap it in. A replaced list is stamped with the epoch it was
+    // retired in and freed once every thread that was already publishing by
+    // then has left publish(), so steady publishing never holds it back.
+    struct ListenerList { std::vector<ListenerEntry> entries; };
+    struct ScopeNode {
+        std::atomic<ScopeId> parent{GlobalScope};
+        std::string name;    // guarded by _mutex
+        bool live = true;    // guarded by _mutex
+        std::atomic<const ListenerList*> listeners[MaxEventTypes] = {};
+    };
+    // Nodes are created under _mutex and live as long as the bus; a released
+    // scope's node is emptied and reused for the next scope created
+    std::atomic<ScopeNode*>        _scopes[MaxScopes] = {};
+    uint32_t                       _scopeCount = 0;
+    std::vector<ScopeId>           _freeScopes;
+    uint64_t                       _nextListenerId = 1;
+    mutable std::mutex _mutex;
 
     // Async queue -----------------------------------------------------------
-    using Job = std::function<void()>;
-    std::queue<Job>                _queue;
-    std::mutex                     _queueMutex;
-    std::condition_variable        _cv;
-    std::thread                    _worker;
-    bool                           _running = false;
-
-    // Event history for formation relations ---------------------------------
-    struct EventRecord {
-        std::string eventType;
-        std::string sourceId;
-        std::string targetId;
-        std::time_t timestamp;
+    // Events up to this size are stored inside the queue slot; larger ones are
+    // boxed on the heap.
+    static constexpr size_t InlineEventSize = 128;
+
+    // Type-erased copy/destroy for an event stored in a slot
+    struct AsyncOps {
+        void (*construct)(void* slot, const void* event);
+        void (*destroy)(void* slot);
+        void (*relocate)(void* dst, void* src);   // move, then destroy src
+        const void* (*get)(const void* slot);
+    };
+
+    template<typename Event>
+    static const AsyncOps& asyncOpsFor()
+    {
+        if constexpr (sizeof(Event) <= InlineEventSize && alignof(Event) <= alignof(std::max_align_t)) {
+            static const AsyncOps ops{
+                [](void* slot, const void* e){ new (slot) Event(*static_cast<const Event*>(e)); },
+                [](void* slot){ static_cast<Event*>(slot)->~Event(); },
+                [](void* dst, void* src){
+                    new (dst) Event(std::move(*static_cast<Event*>(src)));
+                    static_cast<Event*>(src)->~Event();
+                },
+                [](const void* slot){ return slot; }
+            };
+            return ops;
+        } else {
+            static const AsyncOps ops{
+                [](void* slot, const void* e){ *static_cast<Event**>(slot) = new Event(*static_cast<const Event*>(e)); },
+                [](void* slot){ delete *static_cast<Event**>(slot); },
+                [](void* dst, void* src){ *static_cast<Event**>(dst) = *static_cast<Event**>(src); },
+                [](const void* slot) -> const void* { return *static_cast<Event* const*>(slot); }
+            };
+            return ops;
+        }
+    }
+
+    struct AsyncEvent;
+    struct AsyncShard;   // one worker thread and its queue
+    std::vector<std::unique_ptr<AsyncShard>> _shards;
+    std::atomic<bool>              _asyncRunning{false};
+    std::atomic<uint8_t>           _backpressure[MaxEventTypes] = {};
+    std::atomic<uint64_t>          _droppedAsync{0};
+
+    // Deferred queues -------------------------------------------------------
+    // Two buffers per phase: publishers fill one while the other is flushed
+    struct DeferredQueue;
+    struct DeferredPhase {
+        std::mutex mutex;
+        std::unique_ptr<DeferredQueue> buffers[2];
+        int active = 0;
     };
-    std::vector<EventRecord>       _eventHistory;
-    std::mutex                     _eventHistoryMutex;
+    DeferredPhase                  _deferred[FramePhaseCount];
+
+    // Instrumentation -------------------------------------------------------
+    // Handler stats are owned here (guarded by _mutex); listener entries point
+    // at them. Unsubscribed handlers' stats are retired like listener lists.
+    std::atomic<bool>              _instrumented{false};
+    std::atomic<uint64_t>          _publishCounts[MaxEventTypes] = {};
+    std::vector<std::unique_ptr<HandlerStats>> _handlerStats;
+
+    // Epoch reclamation ------------------------------------------------------
+    // Each publishing thread claims a slot and, for the outermost publish()
+    // on its stack, records the epoch it entered at (0 = not publishing).
+    // Anything retired at an epoch older than every recorded one is
+    // unreachable. Threads beyond MaxPublisherThreads are counted in
+    // _untrackedPublishers instead, which holds back all reclamation while
+    // one of them is publishing.
+    static constexpr size_t MaxPublisherThreads = 64;
+    struct alignas(64) EpochSlot {
+        std::atomic<uint64_t> epoch{0};
+        std::atomic<bool> claimed{false};
+    };
+    struct PublisherThread;   // this thread's slot and publish() depth
+    struct Retired {
+        uint64_t epoch;
+        const ListenerList* list;             // one of these is set
+        std::unique_ptr<HandlerStats> stats;
+    };
+    std::atomic<uint64_t>          _epoch{1};
+    EpochSlot                      _publisherEpochs[MaxPublisherThreads];
+    std::atomic<uint32_t>          _untrackedPublishers{0};
+    std::vector<Retired>           _retired;       // guarded by _mutex
+    std::atomic<bool>              _hasRetired{false};
+
+    // Recent publishes and formation relation events
+    struct HistoryRing;
+    std::unique_ptr<HistoryRing>   _history;
 
     // Internal helpers ------------------------------------------------------
-    void processQueue();
+    void enqueueAsync(uint32_t type, uint64_t key, const void* event, const AsyncOps& ops);
+    bool tryCoalesce(AsyncShard& shard, uint32_t type, uint64_t key, const void* event, const AsyncOps& ops, bool allowNew);
+    void runWorker(AsyncShard& shard);
+    bool drainCoalesced(AsyncShard& shard);
+    void deliver(AsyncEvent& event);
+    void wake(AsyncShard& shard);
+    void startAsync(size_t workerCount, size_t queueCapacity);
+    void stopAsync();
+    void enqueueDeferred(FramePhase phase, ScopeId scope, uint32_t type, bool coalesce, const DeferredKey& key, const void* event, const AsyncOps& ops);
+    Subscription addListener(ScopeId scope, uint32_t type, const Listener& listener, int priority);
+    void dispatch(ScopeId scope, uint32_t type, const void* event);
+    bool hasListeners(ScopeId scope, uint32_t type) const;
+    void replaceList(std::atomic<const ListenerList*>& slot, const ListenerList* list); // caller holds _mutex
+    void retireStats(uint64_t listenerId);                      // caller holds _mutex
+    void reclaimRetired();                                      // caller holds _mutex
+    static PublisherThread& publisherThread();
+    void enterPublish();
+    void leavePublish();
 
     // Singleton plumbing ----------------------------------------------------
     EventBus();
@@ -11,11 +11,15 @@ EventHandler& EventHandler::instance() {
 void EventHandler::removeHandler(const std::string& handlerName) {
     auto it = _handlers.find(handlerName);
     if (it != _handlers.end()) {
+        EventBus::instance().unsubscribe(it->second);
         _handlers.erase(it);
     }
 }
 
 void EventHandler::clearAllHandlers() {
+    for (const auto& [name, subscription] : _handlers) {
+        EventBus::instance().unsubscribe(subscription);
+    }
     _handlers.clear();
 }
 
@@ -21,15 +21,16 @@ public:
     // Event registration helpers
     // ------------------------------------------------------------------
     
-    // Register a handler for a specific event type
+    // Register a handler for a specific event type; re-registering a name
+    // replaces the previous handler
     template<typename Event>
     void registerHandler(const std::string& handlerName, 
                         const std::function<void(const Event&)>& handler,
                         int priority = 0) {
-        _handlers[handlerName] = [this, handler, priority]() {
-            EventBus::instance().subscribe<Event>(handler, priority);
-        };
-        _handlers[handlerName](); // Register immediately
+        removeHandler(handlerName);
+        auto subscription = EventBus::instance().subscribe<Event>(handler, priority);
+        EventBus::instance().setListenerLabel(subscription, handlerName);
+        _handlers[handlerName] = subscription;
     }
 
     // Register multiple handlers at once
@@ -60,7 +61,7 @@ public:
     // Handler management
     // ------------------------------------------------------------------
     
-    // Remove a specific handler
+    // Remove a specific handler (unsubscribes it from the bus)
     void removeHandler(const std::string& handlerName);
     
     // Clear all handlers
@@ -80,7 +81,7 @@ public:
     size_t getHandlerCount() const { return _handlers.size(); }
 
 private:
-    std::unordered_map<std::string, std::function<void()>> _handlers;
+    std::unordered_map<std::string, EventBus::Subscription> _handlers;
     
     EventHandler() = default;
     ~EventHandler() = default;
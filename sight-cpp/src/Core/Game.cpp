@@ -2,6 +2,8 @@
 #include "Core/Engine.hpp"
 #include "../../imgui/backends/imgui_impl_glfw.h"
 #include "Form/Object/Object.hpp"
+#include "Form/TransformGraph.hpp"
+#include "Relation/RelationGraph.hpp"
 #include "Rendering/BrushSystem.hpp"
 #include "Rendering/DesignSystem.hpp"
 #include "Form/Object/Formation/Formations.hpp"
@@ -13,6 +15,7 @@
 #include "Rendering/ShadingSystem.hpp"
 #include "ZonesOfEarth/Physics/Physics.hpp"
 #include "Rendering/HighlightSystem.hpp"
+#include "Rendering/TextRenderer.hpp"
 #include "ZonesOfEarth/Ourverse/Ourverse.hpp"
 #include "ZonesOfEarth/Zone/Zone.hpp"
 #include "ZonesOfEarth/ZoneManager.hpp"
@@ -108,6 +111,10 @@ bool Game::init() {
     _mainMenu.addOption("Toggle Toolbar", GLFW_KEY_T, [this]() { _showToolbar = !_showToolbar; });
     _mainMenu.addOption("Toggle Physics", GLFW_KEY_P, [this]() { _world.togglePhysics(); });
     _mainMenu.addOption("Controls / Keymap", GLFW_KEY_K, [this]() { _showKeymapWindow = true; });
+    _mainMenu.addOption("Event Bus Stats", GLFW_KEY_E, [this]() {
+        Core::EventBus::instance().setInstrumentation(true);
+        _showEventBusWindow = true;
+    });
     _mainMenu.addOption("Character Architect Forge", GLFW_KEY_C, [this]() {
         const auto& zones = mgr.zones();
         for (size_t i = 0; i < zones.size(); ++i) {
@@ -489,6 +496,7 @@ void Game::update(float dt) {
     
     // Update camera front from mouse handler
     _cameraFront = _mouseHandler.calculateCameraFront();
+    Core::EventBus::instance().flushDeferred(Core::EventBus::FramePhase::PostInput);
     
     // Check if any text input is active (ImGui)
     bool anyTextInputActive = ImGui::IsAnyItemActive() || ImGui::IsWindowFocused();
@@ -746,6 +754,7 @@ void Game::update(float dt) {
 
     // Update world (physics etc.)
     mgr.active().world().update(dt);
+    Core::EventBus::instance().flushDeferred(Core::EventBus::FramePhase::PostPhysics);
     // Sync highlight selection
     Rendering::HighlightSystem::setSelected(_selectedObject3D);
 
@@ -769,36 +778,42 @@ void Game::update(float dt) {
         for (const auto& off : offsets) {
             glm::vec3 sampleEye  = _cameraPos + off;
             glm::vec3 sampleFeet = sampleEye  - glm::vec3(0.0f, EYE_TO_FEET, 0.0f);
-            Physics::enforceCollisions(sampleEye,  mgr.active().world().getOwnedObjects());
-            Physics::enforceCollisions(sampleFeet, mgr.active().world().getOwnedObjects());
+            Physics::enforceCollisions(sampleEye,  mgr.active().world().hotStore());
+            Physics::enforceCollisions(sampleFeet, mgr.active().world().hotStore());
             // Propagate any delta back to cameraPos
             glm::vec3 resolvedCenter = sampleEye - off;
             _cameraPos = resolvedCenter; // latest correction wins (small offsets)
         }
     }
 
-    // Update body part world transforms based on (possibly corrected) player position
+    // Place the pose at the (possibly corrected) player position
+    _player.position = _cameraPos - glm::vec3(0.0f, _player.getBody().getEyeHeight(), 0.0f);
     _player.updatePose();
 
-    // Per-bodypart collision refinement – single aggregate delta
+    // Per-bodypart collision refinement – single aggregate delta. The graph
+    // has not been flushed yet this frame, so resolve each part's position
+    // from its ancestors instead of reading the cached world matrix.
+    auto& transforms = TransformGraph::instance();
     glm::vec3 totalDelta(0.0f);
     for (auto* part : _player.getBody().parts) {
         if (!part) continue;
-        glm::vec3 pos = glm::vec3(part->getTransform()[3]);
+        glm::vec3 pos = glm::vec3(transforms.resolve(part->transformNode())[3]);
         glm::vec3 corrected = pos;
-        Physics::enforceCollisions(corrected, mgr.active().world().getOwnedObjects());
+        Physics::enforceCollisions(corrected, mgr.active().world().hotStore());
         totalDelta += (corrected - pos);
     }
     if (glm::length(totalDelta) > 1e-4f) {
         _cameraPos += totalDelta;
-        _player.position += totalDelta;
-        _player.updatePose();
     }
 
     // Final sync so avatar anchors exactly to camera for next frame
     _player.position = _cameraPos - glm::vec3(0.0f, _player.getBody().getEyeHeight(), 0.0f);
     _player.updatePose();
 
+    // The frame's one transform pass. Rendering, collision zones and picking
+    // read the cached results.
+    transforms.update();
+
     // Process menu hotkeys (must be after potential cursor unlock to allow selection)
     _mainMenu.processInput(_window);
     _mouseHandler.setMenuOpen(_mainMenu.isOpen());
@@ -815,6 +830,8 @@ void Game::render() {
     }
 #endif
 
+    Core::EventBus::instance().flushDeferred(Core::EventBus::FramePhase::PreRender);
+
     // Apply active zone theme colour
     mgr.active().applyTheme();
 
@@ -875,11 +892,11 @@ void Game::render() {
     // --------------------------------------------------------------
     if (!zoneWorld.getOwnedObjects().empty()) {
         auto& owned = zoneWorld.getOwnedObjectsMutable();
-        if (!owned.empty() && owned[0] && owned[0]->hasAttribute("baseline") && owned[0]->getAttribute("baseline") == std::string("cube")) {
+        if (!owned.empty() && owned[0] && (owned[0]->hot().flags & ObjectHot::BaselineCube)) {
             glm::mat4 cubeTransform = glm::rotate(glm::mat4(1.0f), glm::radians(_cubeAngle), glm::vec3(0.5f, 1.0f, 0.0f));
             owned[0]->setTransform(cubeTransform);
         }
-        if (owned.size() > 1 && owned[1] && owned[1]->hasAttribute("baseline") && owned[1]->getAttribute("baseline") == std::string("ground")) {
+        if (owned.size() > 1 && owned[1] && (owned[1]->hot().flags & ObjectHot::BaselineGround)) {
             glm::mat4 groundTransform = glm::scale(glm::mat4(1.0f), glm::vec3(100.0f, 1.0f, 100.0f));
             owned[1]->setTransform(groundTransform);
         }
@@ -889,8 +906,16 @@ void Game::render() {
     // Draw all owned objects except index 1 (ground placeholder)
     // --------------------------------------------------------------
     const auto& objects = zoneWorld.getOwnedObjects();
+    const float pixelsPerUnitAtOne = fbH / (2.0f * tanf(fov * M_PI / 360.0f));
     for (size_t i = 0; i < objects.size(); ++i) {
         if (i == 1) continue; // skip ground placeholder
+
+        // Rough on-screen size so vector face textures rasterize at a matching resolution
+        const glm::mat4 model = objects[i]->getTransform();
+        float extent = std::max({glm::length(vec3(model[0])), glm::length(vec3(model[1])), glm::length(vec3(model[2]))});
+        float dist = std::max(nearZ, glm::length(vec3(model[3]) - eyePos));
+        objects[i]->setFaceTextureDetail(static_cast<int>(extent * pixelsPerUnitAtOne / dist));
+
         glPushMatrix();
         glMultMatrixf(&objects[i]->getTransform()[0][0]);
         objects[i]->drawObject();
@@ -1182,6 +1207,10 @@ void Game::render() {
 
     _mainMenu.draw();
 
+    // Every text queued this frame (nametags, canvas texts, menu labels) in
+    // one pass over the 3D scene and 2D overlays
+    TextRenderer::instance().flush(fbW, fbH);
+
     // Controls / Keymap window (simple quick reference)
     if (_showKeymapWindow) {
         ImGui::SetNextWindowSize(ImVec2(420, 420), ImGuiCond_FirstUseEver);
@@ -1213,6 +1242,8 @@ void Game::render() {
         ImGui::End();
     }
 
+    drawEventBusWindow();
+
     if (_showChatWindow) {
         _chat.renderUI(&_showChatWindow);
     }
@@ -1306,9 +1337,7 @@ void Game::render() {
                     glm::vec3 dims = selectedPart->getGeometry().getDimensions();
                     float dimArr[3] = {dims.x, dims.y, dims.z};
                     if (ImGui::SliderFloat3("Dimensions", dimArr, 0.05f, 1.0f, "%.2f") && !designLocked) {
-                        selectedPart->getGeometry().setDimensions({dimArr[0], dimArr[1], dimArr[2]});
-                        // Update collision zone to reflect new size
-                        selectedPart->setTransform(selectedPart->getTransform());
+                        selectedPart->setDimensions({dimArr[0], dimArr[1], dimArr[2]});
                     }
 
                     // Color picker
@@ -1803,6 +1832,12 @@ void Game::renderCreatorToolbar() {
                         _current3DMode = Mode3D::None; 
                     }
                     ImGui::SameLine();
+                    if (ImGui::Button(u8"🌫️ Gaussian")) { 
+                        _currentTool = Tool(Tool::Type::GaussianBlur); 
+                        zone.setDesignTool(Tool::Type::GaussianBlur);
+                        _current3DMode = Mode3D::None; 
+                    }
+                    ImGui::SameLine();
                     if (ImGui::Button(u8"🔪 Sharpen")) { 
                         _currentTool = Tool(Tool::Type::Sharpen); 
                         zone.setDesignTool(Tool::Type::Sharpen);
@@ -2416,6 +2451,48 @@ void Game::renderCreatorToolbar() {
             if (_current3DMode == Mode3D::FaceBrush) {
                 ImGui::Separator();
                 
+                // How the selected object's faces store paint. Sparse faces only
+                // allocate the tiles that have been painted, so they can go far
+                // past the dense 64x64 without paying for the whole surface.
+                // Vector faces keep the strokes and rasterize them at the size the
+                // face is drawn, up to a cap.
+                ImGui::Text("Face Texture:");
+                if (_selectedObject3D) {
+                    Object& obj = *_selectedObject3D;
+                    const char* storageNames[] = {"Dense 64x64", "Sparse Tiles", "Vector Strokes"};
+                    int storageIdx = obj.getVectorFaceTextureResolution() > 0 ? 2
+                                   : obj.getSparseFaceTextureSize() > 0 ? 1 : 0;
+                    if (ImGui::Combo("Storage", &storageIdx, storageNames, IM_ARRAYSIZE(storageNames))) {
+                        if (storageIdx == 2) obj.setVectorFaceTextures(1024);
+                        else obj.setSparseFaceTextures(storageIdx == 1 ? 2048 : 0);
+                    }
+                    if (storageIdx == 1) {
+                        // Larger faces would only add CPU-side detail: the GPU mirror stops at
+                        // SparseTexture::MaxGPUSize
+                        const int sparseSizes[] = {1024, 2048};
+                        const char* sparseSizeNames[] = {"1024", "2048"};
+                        int sizeIdx = 0;
+                        for (int i = 0; i < IM_ARRAYSIZE(sparseSizes); ++i) {
+                            if (sparseSizes[i] == obj.getSparseFaceTextureSize()) sizeIdx = i;
+                        }
+                        if (ImGui::Combo("Resolution", &sizeIdx, sparseSizeNames, IM_ARRAYSIZE(sparseSizeNames))) {
+                            obj.setSparseFaceTextures(sparseSizes[sizeIdx]);
+                        }
+                    } else if (storageIdx == 2) {
+                        const int vectorCaps[] = {256, 512, 1024, 2048};
+                        const char* vectorCapNames[] = {"256", "512", "1024", "2048"};
+                        int capIdx = 0;
+                        for (int i = 0; i < IM_ARRAYSIZE(vectorCaps); ++i) {
+                            if (vectorCaps[i] == obj.getVectorFaceTextureResolution()) capIdx = i;
+                        }
+                        if (ImGui::Combo("Max Resolution", &capIdx, vectorCapNames, IM_ARRAYSIZE(vectorCapNames))) {
+                            obj.setVectorFaceTextures(vectorCaps[capIdx]);
+                        }
+                    }
+                } else {
+                    ImGui::TextDisabled("Pick an object in Selection mode to change its face textures");
+                }
+                
                 // Brush Type Selection
                 ImGui::Text("Brush Type:");
                 const char* brushTypeNames[] = {"Normal", "Airbrush", "Chalk", "Spray", "Smudge", "Clone"};
@@ -2734,6 +2811,39 @@ void Game::renderCreatorToolbar() {
                     }
                 }
             }
+
+            ImGui::Separator();
+
+            // Whole-network view of the recorded physics relations. The
+            // snapshot rebuilds in the background; the analysis below reruns
+            // only when a new snapshot arrives.
+            ImGui::Text("Collision Network:");
+            static RelationGraphCache collisionGraphs;
+            static std::shared_ptr<const RelationGraph> analysed;
+            static size_t componentCount = 0;
+            static std::vector<std::pair<double, std::string>> mostConnected;
+            std::shared_ptr<const RelationGraph> graph = collisionGraphs.get(Physics::registry());
+            if (graph && graph != analysed) {
+                analysed = graph;
+                graph->connectedComponents(&componentCount);
+                const std::vector<double> rank = graph->pageRank();
+                mostConnected.clear();
+                for (RelationGraph::NodeId node = 0; node < rank.size(); ++node) {
+                    mostConnected.emplace_back(rank[node], graph->nodeName(node));
+                }
+                const size_t shown = std::min<size_t>(5, mostConnected.size());
+                std::partial_sort(mostConnected.begin(), mostConnected.begin() + shown, mostConnected.end(),
+                                  [](const auto& a, const auto& b) { return a.first > b.first; });
+                mostConnected.resize(shown);
+            }
+            if (!analysed) {
+                ImGui::TextUnformatted("<building>");
+            } else {
+                ImGui::Text("%zu entities, %zu relations, %zu groups", analysed->nodeCount(), analysed->edgeCount(), componentCount);
+                for (const auto& entry : mostConnected) {
+                    ImGui::BulletText("%s (rank %.3f)", entry.second.c_str(), entry.first);
+                }
+            }
         }
         ImGui::End();
     }
@@ -2744,6 +2854,53 @@ void Game::renderCreatorToolbar() {
     drawSaveManager();
 }
 
+void Game::drawEventBusWindow(){
+    if(!_showEventBusWindow) return;
+    auto& bus = Core::EventBus::instance();
+    ImGui::SetNextWindowSize(ImVec2(620,480), ImGuiCond_FirstUseEver);
+    if(ImGui::Begin("Event Bus", &_showEventBusWindow)){
+        bool instrumented = bus.isInstrumented();
+        if(ImGui::Checkbox("Instrument", &instrumented)) bus.setInstrumentation(instrumented);
+        ImGui::SameLine();
+        if(ImGui::Button("Reset")) bus.resetStats();
+        ImGui::SameLine();
+        ImGui::Text("Async workers: %zu  Dropped: %llu", bus.getAsyncWorkerCount(),
+                    static_cast<unsigned long long>(bus.getDroppedAsyncCount()));
+        if(!instrumented) ImGui::TextDisabled("Instrumentation is off; counters are paused.");
+
+        if(ImGui::CollapsingHeader("Publishes by type", ImGuiTreeNodeFlags_DefaultOpen)){
+            auto types = bus.getTypeStats();
+            std::sort(types.begin(), types.end(), [](const auto& a, const auto& b){ return a.publishCount > b.publishCount; });
+            for(const auto& t : types){
+                ImGui::Text("%10llu  %s", static_cast<unsigned long long>(t.publishCount), t.name.c_str());
+            }
+        }
+
+        if(ImGui::CollapsingHeader("Handlers by total time", ImGuiTreeNodeFlags_DefaultOpen)){
+            auto handlers = bus.getHandlerStats();
+            std::sort(handlers.begin(), handlers.end(), [](const auto& a, const auto& b){ return a.totalMs > b.totalMs; });
+            ImGui::TextDisabled("%8s %9s %8s %8s %8s %9s  %s", "calls", "total ms", "mean us", "p50", "p99", "max", "handler");
+            for(const auto& h : handlers){
+                ImGui::Text("%8llu %9.2f %8.1f %8.1f %8.1f %9.1f  %s", static_cast<unsigned long long>(h.calls),
+                            h.totalMs, h.meanUs, h.p50Us, h.p99Us, h.maxUs, h.label.c_str());
+            }
+        }
+
+        if(ImGui::CollapsingHeader("Recent history")){
+            ImGui::BeginChild("EventBusHistory", ImVec2(0, 200), true);
+            for(const auto& e : bus.getRecentHistory(128)){
+                if(e.sourceId.empty() && e.targetId.empty()){
+                    ImGui::Text("%7.2fs  %s  [%s]", e.ageSeconds, e.eventType.c_str(), bus.getScopeName(e.scope).c_str());
+                } else {
+                    ImGui::Text("%7.2fs  %s  %s -> %s", e.ageSeconds, e.eventType.c_str(), e.sourceId.c_str(), e.targetId.c_str());
+                }
+            }
+            ImGui::EndChild();
+        }
+    }
+    ImGui::End();
+}
+
 void Game::drawLoadWindow(){
     if(!_showLoadWindow) return;
     ImGui::SetNextWindowSize(ImVec2(500,400), ImGuiCond_FirstUseEver);
@@ -2813,6 +2970,7 @@ void Game::drawLoadWindow(){
 void Game::shutdown() {
     // Automatically save game state upon shutdown
     saveStateWithLog();
+    TextRenderer::instance().releaseGPU();
 }
 
 void Game::updateSaveFiles() {
@@ -2827,7 +2985,7 @@ void Game::saveState(const std::string& filename) {
         json zj; zj["name"]=z.name();
         zj["r"]=z.r; zj["g"]=z.g; zj["b"]=z.b;
         json strokesJ = json::array();
-        for(const auto& s : z.strokes){json sj; sj["color"]={s.r,s.g,s.b}; sj["points"]=s.points; strokesJ.push_back(sj);}
+        for(const auto& s : z.strokes){json sj; sj["color"]={s.r,s.g,s.b}; sj["lineWidth"]=s.lineWidth; sj["pointsB64"]=base64Encode(Zone::packStrokePoints(s.points)); strokesJ.push_back(sj);}
         zj["strokes"]=strokesJ;
         // Serialize the 3-D world owned by this zone
         zj["world"] = z.world();
@@ -2857,7 +3015,7 @@ void Game::saveState(const std::string& filename) {
             const auto& t = law.target;
             nlohmann::json tj; tj["allObjects"]=t.allObjects; tj["limitByGeometry"]=t.limitByGeometry; tj["limitByObjectType"]=t.limitByObjectType; tj["limitByAttribute"]=t.limitByAttribute; tj["limitByTag"]=t.limitByTag; tj["limitByExplicitList"]=t.limitByExplicitList;
             tj["geometryTypes"] = nlohmann::json::array(); for(auto g: t.geometryTypes) tj["geometryTypes"].push_back(static_cast<int>(g));
-            tj["objectTypes"] = t.objectTypes; tj["attributeKey"]=t.attributeKey; tj["attributeValue"]=t.attributeValue; tj["tag"]=t.tag; tj["objectIdentifiers"]=t.objectIdentifiers;
+            tj["objectTypes"] = t.objectTypes; tj["attributeKey"]=t.attributeKey; tj["attributeValue"]=t.attributeValue; tj["tag"]=t.tag; tj["objectIdentifiers"]=t.objectIdentifiers.names();
             lj["target"] = tj;
             lawsJ.push_back(lj);
         }
@@ -2892,7 +3050,7 @@ void Game::saveStateWithLog(const std::string& customName) {
         json zj; zj["name"]=z.name();
         zj["r"]=z.r; zj["g"]=z.g; zj["b"]=z.b;
         json strokesJ = json::array();
-        for(const auto& s : z.strokes){json sj; sj["color"]={s.r,s.g,s.b}; sj["points"]=s.points; strokesJ.push_back(sj);}
+        for(const auto& s : z.strokes){json sj; sj["color"]={s.r,s.g,s.b}; sj["lineWidth"]=s.lineWidth; sj["pointsB64"]=base64Encode(Zone::packStrokePoints(s.points)); strokesJ.push_back(sj);}
         zj["strokes"]=strokesJ;
         // Serialize the 3-D world owned by this zone
         zj["world"] = z.world();
@@ -2922,7 +3080,7 @@ void Game::saveStateWithLog(const std::string& customName) {
             const auto& t = law.target;
             nlohmann::json tj; tj["allObjects"]=t.allObjects; tj["limitByGeometry"]=t.limitByGeometry; tj["limitByObjectType"]=t.limitByObjectType; tj["limitByAttribute"]=t.limitByAttribute; tj["limitByTag"]=t.limitByTag; tj["limitByExplicitList"]=t.limitByExplicitList;
             tj["geometryTypes"] = nlohmann::json::array(); for(auto g: t.geometryTypes) tj["geometryTypes"].push_back(static_cast<int>(g));
-            tj["objectTypes"] = t.objectTypes; tj["attributeKey"]=t.attributeKey; tj["attributeValue"]=t.attributeValue; tj["tag"]=t.tag; tj["objectIdentifiers"]=t.objectIdentifiers;
+            tj["objectTypes"] = t.objectTypes; tj["attributeKey"]=t.attributeKey; tj["attributeValue"]=t.attributeValue; tj["tag"]=t.tag; tj["objectIdentifiers"]=t.objectIdentifiers.names();
             lj["target"] = tj;
             lawsJ.push_back(lj);
         }
@@ -2964,9 +3122,12 @@ void Game::loadState(const std::string& filename){
                     for(const auto& sj: zj["strokes"]) {
                         Zone::Stroke s; auto col = sj.value("color", std::vector<float>{1,1,1});
                         if(col.size()>=3){s.r=col[0]; s.g=col[1]; s.b=col[2];}
-                        s.points = sj.value("points", std::vector<float>{});
+                        s.lineWidth = sj.value("lineWidth", 2.0f);
+                        if(sj.contains("pointsB64")) s.points = Zone::unpackStrokePoints(base64Decode(sj["pointsB64"].get<std::string>()));
+                        else s.points = sj.value("points", std::vector<float>{});
                         z.strokes.push_back(std::move(s));
                     }
+                    z.strokesChanged();
                 }
                 // Load 3-D world objects for this zone
                 if(zj.contains("world")) {
@@ -3032,10 +3193,9 @@ void Game::loadState(const std::string& filename){
                 law.target.geometryTypes.clear();
                 if (tj.contains("geometryTypes")) { for (const auto& gi : tj["geometryTypes"]) law.target.geometryTypes.push_back(static_cast<Object::GeometryType>(gi.get<int>())); }
                 law.target.objectTypes.clear(); if (tj.contains("objectTypes")) { for (const auto& s : tj["objectTypes"]) law.target.objectTypes.push_back(s.get<std::string>()); }
-                law.target.attributeKey = tj.value("attributeKey", std::string(""));
-                law.target.attributeValue = tj.value("attributeValue", std::string(""));
-                law.target.tag = tj.value("tag", std::string(""));
-                law.target.objectIdentifiers.clear(); if (tj.contains("objectIdentifiers")) { for (const auto& s : tj["objectIdentifiers"]) law.target.objectIdentifiers.push_back(s.get<std::string>()); }
+                law.target.setAttributeFilter(tj.value("attributeKey", std::string("")), tj.value("attributeValue", std::string("")));
+                law.target.setTagFilter(tj.value("tag", std::string("")));
+                law.target.objectIdentifiers.clear(); if (tj.contains("objectIdentifiers")) { for (const auto& s : tj["objectIdentifiers"]) law.target.objectIdentifiers.add(s.get<std::string>()); }
                 Physics::addLaw(law);
             }
         }
@@ -352,6 +352,7 @@ private:
     bool _showChatWindow = true;
     bool _showAvatarDemo = false;  // Toggle for avatar demo
     bool _showKeymapWindow = false; // Toggle for keymap window
+    bool _showEventBusWindow = false; // EventBus counters, handler timings, history
 
     // Toggle states - now handled by KeyboardHandler
 
@@ -557,6 +558,7 @@ public:
     void drawLoadWindow();
     void drawSaveWindow();
     void drawSaveManager();
+    void drawEventBusWindow();
     
     // Polyhedron generation
     void _generateCustomPolyhedron();
@@ -0,0 +1,92 @@
+#include "EntityRegistry.hpp"
+#include <algorithm>
+
+EntityRegistry& EntityRegistry::instance() {
+    // Never destroyed: Singulars with static storage may release their IDs
+    // after function-local statics have already been torn down
+    static EntityRegistry* registry = new EntityRegistry();
+    return *registry;
+}
+
+EntityId EntityRegistry::acquire(const Singular* owner, const std::string& name) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    EntityId id = _entries.insert(Entry{owner, name, name.empty() ? NoName : _names.intern(name)});
+    linkName(name, id);
+    return id;
+}
+
+// Unnamed entities are common (objects without an ID) and are left out of the
+// name table so releasing one never scans a huge bucket
+void EntityRegistry::linkName(const std::string& name, EntityId id) {
+    if (!name.empty()) _byName[name].push_back(id);
+}
+
+void EntityRegistry::unlinkName(const std::string& name, EntityId id) {
+    if (name.empty()) return;
+    auto it = _byName.find(name);
+    if (it == _byName.end()) return;
+    auto& ids = it->second;
+    ids.erase(std::remove(ids.begin(), ids.end(), id), ids.end());
+    if (ids.empty()) _byName.erase(it);
+}
+
+void EntityRegistry::release(EntityId id) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    const Entry* entry = _entries.get(id);
+    if (!entry) return;
+    unlinkName(entry->name, id);
+    _entries.erase(id);
+}
+
+void EntityRegistry::rebind(EntityId id, const Singular* owner) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (Entry* entry = _entries.get(id)) entry->owner = owner;
+}
+
+void EntityRegistry::rename(EntityId id, const std::string& name) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    Entry* entry = _entries.get(id);
+    if (!entry || entry->name == name) return;
+    unlinkName(entry->name, id);
+    entry->name = name;
+    entry->nameKey = name.empty() ? NoName : _names.intern(name);
+    linkName(name, id);
+}
+
+bool EntityRegistry::isAlive(EntityId id) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _entries.contains(id);
+}
+
+const Singular* EntityRegistry::resolve(EntityId id) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    const Entry* entry = _entries.get(id);
+    return entry ? entry->owner : nullptr;
+}
+
+std::string EntityRegistry::nameOf(EntityId id) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    const Entry* entry = _entries.get(id);
+    return entry ? entry->name : std::string();
+}
+
+std::vector<EntityId> EntityRegistry::findByName(const std::string& name) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _byName.find(name);
+    return it != _byName.end() ? it->second : std::vector<EntityId>();
+}
+
+uint32_t EntityRegistry::nameKey(const std::string& name) {
+    return _names.intern(name);
+}
+
+uint32_t EntityRegistry::nameKeyOf(EntityId id) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    const Entry* entry = _entries.get(id);
+    return entry ? entry->nameKey : NoName;
+}
+
+size_t EntityRegistry::size() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _entries.size();
+}
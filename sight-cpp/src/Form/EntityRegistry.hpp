@@ -0,0 +1,116 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <mutex>
+#include <cstdint>
+#include "Util/SlotMap.hpp"
+#include "Util/StringInterner.hpp"
+
+class Singular;
+
+// Compact generational ID of a Singular: a slot index plus the generation the
+// slot had when the entity registered. IDs of destroyed entities stop
+// resolving, even after their slot is reused. value() packs it into a single
+// 64-bit key for hashed containers.
+using EntityId = SlotHandle;
+
+struct EntityIdHash {
+    size_t operator()(const EntityId& id) const { return std::hash<uint64_t>()(id.value()); }
+};
+
+// Process-wide table of every live Singular that has asked for an ID (see
+// Singular::entityId()), with a bidirectional name table so IDs can be turned
+// back into identifiers for serialization and UI, and names into IDs.
+// Several entities may share a name. Thread-safe.
+class EntityRegistry {
+public:
+    static EntityRegistry& instance();
+
+    EntityId acquire(const Singular* owner, const std::string& name);
+    void release(EntityId id);
+    // Point an ID at a new address after its owner was moved
+    void rebind(EntityId id, const Singular* owner);
+    void rename(EntityId id, const std::string& name);
+
+    bool isAlive(EntityId id) const;
+    const Singular* resolve(EntityId id) const;
+    // Empty string for dead IDs
+    std::string nameOf(EntityId id) const;
+    // All live entities registered under `name`
+    std::vector<EntityId> findByName(const std::string& name) const;
+
+
+    // Names are also interned to stable keys, so membership in a name list
+    // can be tested without touching strings. A name's key never changes.
+    static constexpr uint32_t NoName = StringInterner::NotFound;
+    uint32_t nameKey(const std::string& name);
+    // NoName for dead or unnamed IDs
+    uint32_t nameKeyOf(EntityId id) const;
+
+    size_t size() const;
+
+private:
+    EntityRegistry() = default;
+
+    struct Entry {
+        const Singular* owner = nullptr;
+        std::string name;
+        uint32_t nameKey = NoName;
+    };
+
+    void linkName(const std::string& name, EntityId id);
+    void unlinkName(const std::string& name, EntityId id);
+
+    mutable std::mutex _mutex;
+    SlotMap<Entry> _entries;
+    std::unordered_map<std::string, std::vector<EntityId>> _byName;
+    StringInterner _names;
+};
+
+// List of entity names with a cached set of their interned keys for
+// membership tests on hot paths. The list carries its own version, bumped by
+// every edit, and keys are re-resolved only when it changes; entities coming
+// and going elsewhere in the registry never invalidate it.
+class EntityNameSet {
+public:
+    const std::vector<std::string>& names() const { return _names; }
+    bool empty() const { return _names.empty(); }
+    uint64_t version() const { return _version; }
+
+    void add(const std::string& name) {
+        _names.push_back(name);
+        ++_version;
+    }
+    template <typename It>
+    void assign(It first, It last) {
+        _names.assign(first, last);
+        ++_version;
+    }
+    void clear() {
+        _names.clear();
+        ++_version;
+    }
+
+    // True if `id` belongs to a live entity registered under one of the names
+    bool contains(EntityId id) const {
+        auto& registry = EntityRegistry::instance();
+        if (_resolvedVersion != _version) {
+            _keys.clear();
+            for (const auto& name : _names) {
+                if (!name.empty()) _keys.insert(registry.nameKey(name));
+            }
+            _resolvedVersion = _version;
+        }
+        if (_keys.empty()) return false;
+        return _keys.count(registry.nameKeyOf(id)) != 0;
+    }
+
+private:
+    std::vector<std::string> _names;
+    uint64_t _version = 0;
+    mutable std::unordered_set<uint32_t> _keys;
+    mutable uint64_t _resolvedVersion = ~0ull;
+};
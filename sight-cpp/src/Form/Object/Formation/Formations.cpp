@@ -26,21 +26,37 @@ Formations::Formations(const std::vector<Singular*>& members, Form::ShapeType ty
 
 
 void Formations::addElement(const Singular& s) {
-    members.push_back(const_cast<Singular*>(&s));
+    addMember(const_cast<Singular*>(&s));
 }
 
 void Formations::removeElement(const Singular& s) {
-    members.erase(std::remove(members.begin(), members.end(), const_cast<Singular*>(&s)), members.end());
+    removeMember(const_cast<Singular*>(&s));
 }
 
 void Formations::addMember(Singular* s) {
     if(!s) return;
     members.push_back(s);
+    memberGraphNames.push_back(s->getIdentifier());
+    completeGraph.addMember(memberGraphNames.back());
+    if (auto* nested = dynamic_cast<Formations*>(s)) {
+        TransformGraph::instance().setParent(nested->transformNode(), transformNode());
+    }
 }
 
 void Formations::removeMember(Singular* s) {
     if(!s) return;
-    members.erase(std::remove(members.begin(), members.end(), s), members.end());
+    for (size_t i = members.size(); i-- > 0;) {
+        if (members[i] != s) continue;
+        completeGraph.removeMember(memberGraphNames[i]);
+        if (auto* nested = dynamic_cast<Formations*>(s)) {
+            auto& graph = TransformGraph::instance();
+            if (graph.parentOf(nested->transformNode()) == transformNode()) {
+                graph.setParent(nested->transformNode(), TransformNode());
+            }
+        }
+        members.erase(members.begin() + i);
+        memberGraphNames.erase(memberGraphNames.begin() + i);
+    }
 }
 
 // Applies to physical Formation objects
@@ -67,17 +83,3 @@ void Formations::draw() const {
         }
     }
 }
-
-// -----------------------------------------------------------------------------
-// Build complete graph of membership relations between objects
-// -----------------------------------------------------------------------------
-void Formations::rebuildCompleteGraph() {
-    relationMgr = RelationManager{}; // reset
-    for (size_t i = 0; i < members.size(); ++i) {
-        for (size_t j = i + 1; j < members.size(); ++j) {
-            if (!members[i] || !members[j]) continue;
-            Relation rel{"member", *members[i], *members[j]};
-            relationMgr.add(rel);
-        }
-    }
-}
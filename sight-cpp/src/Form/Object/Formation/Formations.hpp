@@ -5,6 +5,8 @@
 #include "Form/Form.hpp"
 #include <glm/glm.hpp>
 #include "Relation/RelationManager.hpp"
+#include "Relation/CompleteGraph.hpp"
+#include "Form/TransformGraph.hpp"
 #include "Singular.hpp"
 
 
@@ -46,13 +48,25 @@ public:
     // Add a relation directly (alias for addRelation)
     void add(const Relation& r) { relationMgr.add(r); }
     
-    // Build a simple fully-connected graph between all objects currently
-    // in this formation (undirected, weight 1.0, type="member")
-    void rebuildCompleteGraph();
+    // Implicit fully-connected graph between the members (undirected, weight
+    // 1.0, type="member"), kept in step as members are added and removed.
+    // Edges are not materialized; per-edge weights and events live here.
+    CompleteGraph& memberGraph() { return completeGraph; }
+    const CompleteGraph& memberGraph() const { return completeGraph; }
+
+    // The formation's node in the TransformGraph. Members that are themselves
+    // formations (body parts, nested groups) are parented under it while
+    // they belong, so moving the formation moves them in the next pass.
+    TransformNode transformNode() const { return _transform.node(); }
+    void setLocalTransform(const glm::mat4& t) { TransformGraph::instance().setLocal(_transform.node(), t); }
 
     // Render the formation and its constituent objects
     void draw() const;
 
+    // EventBus scope for events among this formation's members
+    Core::EventBus::ScopeId getEventScope() const { return _eventScope; }
+    void setEventScope(Core::EventBus::ScopeId scope) { _eventScope = scope; }
+
     // Add methods to manipulate formations, such as adding or removing elements,
     // checking relationships, etc.
 
@@ -69,5 +83,11 @@ public:
 
 private:
     std::vector<Singular*> members;
+    // Identifier each member joined memberGraph() under, parallel to members,
+    // so a later rename still removes the right one
+    std::vector<std::string> memberGraphNames;
     RelationManager relationMgr;
+    CompleteGraph completeGraph{"member", 1.0f};
+    Core::EventBus::ScopeId _eventScope = Core::EventBus::GlobalScope;
+    TransformHandle _transform;
 };
\ No newline at end of file
@@ -2,8 +2,7 @@
 #include <GLFW/glfw3.h>
 #include <iostream>
 
-#define STB_EASY_FONT_IMPLEMENTATION   // only in this translation unit
-#include "stb_easy_font.h"             // header‑only bitmap font
+#include "Rendering/TextRenderer.hpp"  // batched distance-field text
 
 Menu::Menu() {
     // Pre-reserve a small number of options to avoid early reallocations
@@ -110,15 +109,8 @@ void Menu::draw() const {
     // Title
     const float titleX = panelX + 24.0f;
     const float titleY = panelY + 34.0f;
-    {
-        char buf[8000];
-        int quads = stb_easy_font_print(titleX, titleY, const_cast<char*>("EARTHCALL"), nullptr, buf, sizeof(buf));
-        glColor3f(1.0f, 0.95f, 0.6f);
-        glEnableClientState(GL_VERTEX_ARRAY);
-        glVertexPointer(2, GL_FLOAT, 16, buf);
-        glDrawArrays(GL_QUADS, 0, quads * 4);
-        glDisableClientState(GL_VERTEX_ARRAY);
-    }
+    TextRenderer& text = TextRenderer::instance();
+    text.queue("EARTHCALL", titleX, titleY, glm::vec3(1.0f, 0.95f, 0.6f));
 
     // Options list
     const float listX = panelX + 24.0f;
@@ -129,7 +121,6 @@ void Menu::draw() const {
     int clampedSelected = _selectedIndex;
     if (options.empty()) clampedSelected = 0; else if (clampedSelected >= (int)options.size()) clampedSelected = (int)options.size() - 1;
 
-    char buf[6000];
     for (size_t i = 0; i < options.size(); ++i) {
         // Compose label: “label  [Key]” for clarity
         std::string keyStr;
@@ -158,13 +149,8 @@ void Menu::draw() const {
             glEnd();
         }
 
-        // Render text
-        int quads = stb_easy_font_print(listX, y, const_cast<char*>(line.c_str()), nullptr, buf, sizeof(buf));
-        glColor3f(0.98f, 0.98f, 0.90f);
-        glEnableClientState(GL_VERTEX_ARRAY);
-        glVertexPointer(2, GL_FLOAT, 16, buf);
-        glDrawArrays(GL_QUADS, 0, quads * 4);
-        glDisableClientState(GL_VERTEX_ARRAY);
+        // Labels are drawn with the frame's other text, on top of the panel
+        text.queue(line, listX, y, glm::vec3(0.98f, 0.98f, 0.90f));
     }
 
     // ---------------------------------------------------------------------
@@ -9,42 +9,12 @@
 #include <optional>
 #include <unordered_set>
 #include "Rendering/HighlightSystem.hpp"
+#include "Util/BlockPool.hpp"
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
 
-// Event structures for Object hover events
-struct ObjectHoverEvent {
-    const Object& object;
-    glm::vec3 hoverPoint;
-    glm::vec2 screenPosition;
-    std::time_t timestamp;
-    
-    ObjectHoverEvent(const Object& obj, const glm::vec3& point, const glm::vec2& screen)
-        : object(obj), hoverPoint(point), screenPosition(screen), timestamp(std::time(nullptr)) {}
-};
-
-struct ObjectHoverEnterEvent {
-    const Object& object;
-    glm::vec3 hoverPoint;
-    glm::vec2 screenPosition;
-    std::time_t timestamp;
-    
-    ObjectHoverEnterEvent(const Object& obj, const glm::vec3& point, const glm::vec2& screen)
-        : object(obj), hoverPoint(point), screenPosition(screen), timestamp(std::time(nullptr)) {}
-};
-
-struct ObjectHoverExitEvent {
-    const Object& object;
-    glm::vec3 lastHoverPoint;
-    glm::vec2 lastScreenPosition;
-    std::time_t timestamp;
-    
-    ObjectHoverExitEvent(const Object& obj, const glm::vec3& point, const glm::vec2& screen)
-        : object(obj), lastHoverPoint(point), lastScreenPosition(screen), timestamp(std::time(nullptr)) {}
-};
-
 // Utility: number of logical faces for each geometry type
 // Need to implement a more ground-up approach: 
 // Getter and setter method for number of sides under a unified Polygonal framework 
@@ -55,7 +25,7 @@ static int numFacesForGeometry(Object::GeometryType t) {
         case Object::GeometryType::Sphere:    return 1; // treat entire sphere as one face for now
         case Object::GeometryType::Cylinder:  return 2; // caps+side (simplified)
         case Object::GeometryType::Cone:      return 2; // base + side
-        case Object::GeometryType::Polyhedron: return 0; // Will be determined by polyhedronData
+        case Object::GeometryType::Polyhedron: return 0; // Will be determined by the polyhedron data
     }
     return 1;
 }
@@ -647,7 +617,7 @@ void Object::setDimensions(int d) {
 
 int Object::getCorners() {
     if (geometryType == GeometryType::Polyhedron) {
-        return polyhedronData.getVertexCount();
+        return getPolyhedronData().getVertexCount();
     }
     return corners;
 }
@@ -660,7 +630,7 @@ void Object::setCorners(int c) {
 
 int Object::getFaces() {
     if (geometryType == GeometryType::Polyhedron) {
-        return polyhedronData.getFaceCount();
+        return getPolyhedronData().getFaceCount();
     }
     return faces;
 }
@@ -725,6 +695,7 @@ std::string Object::getObjectID() {
 
 void Object::setObjectID(int oi) {
     objectID = std::to_string(oi);
+    syncEntityName();
 }
 
 std::string Object::getObjectType() const {
@@ -758,7 +729,7 @@ std::string Object::screenMode() {
 void Object::initFaceTextures() {
     int n;
     if (geometryType == GeometryType::Polyhedron) {
-        n = polyhedronData.getFaceCount();
+        n = getPolyhedronData().getFaceCount();
     } else {
         n = numFacesForGeometry(geometryType);
     }
@@ -776,7 +747,93 @@ void Object::initFaceTextures() {
         uint8_t b = static_cast<uint8_t>(c[2] * 255);
         uint8_t a = 255;
         uint32_t rgba = (a << 24) | (b << 16) | (g << 8) | r;
-        faceTextures[i].create(rgba);
+        if (vectorFaceTextureResolution > 0) {
+            faceTextures[i].createVector(rgba, vectorFaceTextureResolution);
+        } else if (sparseFaceTextureSize > 0) {
+            faceTextures[i].createSparse(sparseFaceTextureSize, rgba);
+        } else {
+            faceTextures[i].create(rgba);
+        }
+    }
+}
+
+void Object::setSparseFaceTextures(int virtualSize) {
+    sparseFaceTextureSize = std::max(0, virtualSize);
+    vectorFaceTextureResolution = 0;
+    if (sparseFaceTextureSize == 0) {
+        initFaceTextures();
+        return;
+    }
+
+    for (auto& tex : faceTextures) {
+        if (tex.isSparse() && tex.size == sparseFaceTextureSize) continue;
+        if (tex.isVector()) {
+            tex.createSparse(sparseFaceTextureSize, tex.vector->getBaseColor());
+            continue;
+        }
+        if (tex.isSparse()) {
+            // Resolution change on an already sparse face: resample the painted tiles
+            // into the new grid. Undo history refers to the old grid and is dropped.
+            std::unique_ptr<SparseTexture> old = std::move(tex.sparse);
+            tex.createSparse(sparseFaceTextureSize, old->getBaseColor());
+            tex.sparse->resampleFrom(*old);
+            tex.uploadToGPU();
+            continue;
+        }
+
+        if (tex.useLayers) tex.compositeLayers();
+        std::vector<uint8_t> dense = std::move(tex.pixels);
+        int denseSize = tex.size;
+        uint32_t base = 0xFFFFFFFF;
+        if (dense.size() >= 4) {
+            std::memcpy(&base, dense.data(), 4);
+        }
+
+        tex.createSparse(sparseFaceTextureSize, base);
+
+        // Carry over painted texels by scaling each differing texel to its block,
+        // so only tiles under existing paint become resident
+        int scale = std::max(1, tex.size / std::max(1, denseSize));
+        for (int y = 0; y < denseSize; ++y) {
+            for (int x = 0; x < denseSize; ++x) {
+                const uint8_t* src = &dense[(static_cast<size_t>(y) * denseSize + x) * 4];
+                if (std::memcmp(src, &base, 4) == 0) continue;
+                for (int by = 0; by < scale; ++by) {
+                    for (int bx = 0; bx < scale; ++bx) {
+                        std::memcpy(tex.sparse->texelForWrite(x * scale + bx, y * scale + by), src, 4);
+                    }
+                }
+            }
+        }
+        tex.uploadToGPU();
+    }
+}
+
+void Object::setVectorFaceTextures(int maxResolution) {
+    vectorFaceTextureResolution = std::max(0, maxResolution);
+    sparseFaceTextureSize = 0;
+    if (vectorFaceTextureResolution == 0) {
+        initFaceTextures();
+        return;
+    }
+
+    for (auto& tex : faceTextures) {
+        if (tex.isVector()) {
+            if (tex.vector->getMaxResolution() != vectorFaceTextureResolution) {
+                // Dabs are resolution independent, so only the raster cap changes
+                auto previous = std::move(tex.vector);
+                tex.createVector(previous->getBaseColor(), vectorFaceTextureResolution);
+                tex.vector->setDabs(previous->getDabs(), previous->getStrokeStarts());
+            }
+            continue;
+        }
+        uint32_t base = 0xFFFFFFFF;
+        if (tex.isSparse()) {
+            base = tex.sparse->getBaseColor();
+        } else if (tex.pixels.size() >= 4) {
+            std::memcpy(&base, tex.pixels.data(), 4);
+        }
+        tex.createVector(base, vectorFaceTextureResolution);
     }
 }
 
@@ -787,6 +844,13 @@ void Object::fillFaceColor(int faceIndex, float r, float g, float b) {
     uint8_t G = static_cast<uint8_t>(std::clamp(g, 0.f, 1.f) * 255);
     uint8_t B = static_cast<uint8_t>(std::clamp(b, 0.f, 1.f) * 255);
     uint8_t A = 255;
+    if (tex.isSparse()) {
+        // A flat fill needs no tiles at all
+        tex.sparse->clear((static_cast<uint32_t>(A) << 24) | (B << 16) | (G << 8) | R);
+    } else if (tex.isVector()) {
+        // ...and on a vector face it replaces the whole document
+        tex.vector->clear((static_cast<uint32_t>(A) << 24) | (B << 16) | (G << 8) | R);
+    }
     for (size_t i = 0; i < tex.pixels.size(); i += 4) {
         tex.pixels[i] = R;
         tex.pixels[i+1] = G;
@@ -805,6 +869,10 @@ void Object::fillFaceColor(int faceIndex, float r, float g, float b) {
 void Object::paintFace(int faceIndex, const glm::vec2& uv, float r, float g, float b, float radius, float softness) {
     if (faceIndex < 0 || faceIndex >= static_cast<int>(faceTextures.size())) return;
     FaceTexture& tex = faceTextures[faceIndex];
+    if (tex.isVector()) {
+        tex.vector->addDab(uv.x, uv.y, radius, r, g, b, 1.0f, softness, VectorTexture::Round);
+        return;
+    }
     int size = tex.size;
     int cx = static_cast<int>(uv.x * size);
     // int cy = static_cast<int>((1.0f - uv.y) * size); // flip Y so UV origin at bottom-left
@@ -835,8 +903,7 @@ void Object::paintFace(int faceIndex, const glm::vec2& uv, float r, float g, flo
                     t = std::clamp(1.0f - distNorm, 0.0f, 1.0f);
                     t = std::pow(t, 1.0f / std::max(0.001f, softness));
                 }
-                size_t idx = (y * size + x) * 4;
-                uint8_t* dst = &tex.pixels[idx];
+                uint8_t* dst = tex.texelForWrite(tex.pixels, x, y);
                 float inv = 1.0f - t;
                 dst[0] = static_cast<uint8_t>(dst[0]*inv + R*t);
                 dst[1] = static_cast<uint8_t>(dst[1]*inv + G*t);
@@ -852,9 +919,16 @@ void Object::paintFaceAdvanced(int faceIndex, const glm::vec2& uv, float r, floa
                               float radius, float softness, float opacity, float flow, int brushType) {
     if (faceIndex < 0 || faceIndex >= static_cast<int>(faceTextures.size())) return;
     FaceTexture& tex = faceTextures[faceIndex];
+
+    if (tex.isVector()) {
+        // The dab itself is the document; strokes are delimited by saveStrokeState()
+        tex.vector->addDab(uv.x, uv.y, radius, r, g, b, opacity * flow, softness, brushType);
+        return;
+    }
     
-    // Save stroke state for undo
-    tex.saveStrokeState();
+    // Save stroke state for undo. Sparse faces save touched tiles per stroke
+    // instead, delimited by saveStrokeState() as for vector faces.
+    if (!tex.isSparse()) tex.saveStrokeState();
     
     // Add stroke point to history
     if (tex.activeLayer >= 0 && tex.activeLayer < static_cast<int>(tex.strokeHistory.size())) {
@@ -914,8 +988,7 @@ void Object::paintFaceAdvanced(int faceIndex, const glm::vec2& uv, float r, floa
                 }
                 
                 t *= opacity * flow;
-                size_t idx = (y * size + x) * 4;
-                uint8_t* dst = &targetBuffer[idx];
+                uint8_t* dst = tex.texelForWrite(targetBuffer, x, y);
                 float inv = 1.0f - t;
                 dst[0] = static_cast<uint8_t>(dst[0]*inv + R*t);
                 dst[1] = static_cast<uint8_t>(dst[1]*inv + G*t);
@@ -945,6 +1018,7 @@ void Object::paintStroke(int faceIndex, const glm::vec2& startUV, const glm::vec
 void Object::smudgeFace(int faceIndex, const glm::vec2& uv, float radius, float strength) {
     if (faceIndex < 0 || faceIndex >= static_cast<int>(faceTextures.size())) return;
     FaceTexture& tex = faceTextures[faceIndex];
+    if (tex.isVector()) return; // samples existing texels, which vector faces don't keep
     
     int size = tex.size;
     int cx = static_cast<int>(uv.x * size);
@@ -969,8 +1043,7 @@ void Object::smudgeFace(int faceIndex, const glm::vec2& uv, float radius, float
                 float t = 1.0f - std::sqrt(static_cast<float>(distSq)) / static_cast<float>(radPx);
                 t = std::clamp(t, 0.0f, 1.0f) * strength;
                 
-                size_t idx = (y * size + x) * 4;
-                uint8_t* dst = &targetBuffer[idx];
+                uint8_t* dst = tex.texelForWrite(targetBuffer, x, y);
                 
                 // Blend with neighboring pixels
                 glm::vec3 avgColor(0.0f);
@@ -980,10 +1053,10 @@ void Object::smudgeFace(int faceIndex, const glm::vec2& uv, float radius, float
                         int nx = x + sx;
                         int ny = y + sy;
                         if (nx >= 0 && nx < size && ny >= 0 && ny < size) {
-                            size_t nidx = (ny * size + nx) * 4;
-                            avgColor += glm::vec3(targetBuffer[nidx]/255.0f, 
-                                                 targetBuffer[nidx+1]/255.0f, 
-                                                 targetBuffer[nidx+2]/255.0f);
+                            const uint8_t* neighbor = tex.texelAt(targetBuffer, nx, ny);
+                            avgColor += glm::vec3(neighbor[0]/255.0f, 
+                                                 neighbor[1]/255.0f, 
+                                                 neighbor[2]/255.0f);
                             samples++;
                         }
                     }
@@ -1004,6 +1077,7 @@ void Object::cloneFace(int faceIndex, const glm::vec2& destUV, const glm::vec2&
                        float radius, float opacity) {
     if (faceIndex < 0 || faceIndex >= static_cast<int>(faceTextures.size())) return;
     FaceTexture& tex = faceTextures[faceIndex];
+    if (tex.isVector()) return; // samples existing texels, which vector faces don't keep
     
     int size = tex.size;
     int destX = static_cast<int>(destUV.x * size);
@@ -1034,10 +1108,8 @@ void Object::cloneFace(int faceIndex, const glm::vec2& destUV, const glm::vec2&
                 int sx = sourceX + dx;
                 int sy = sourceY + dy;
                 if (sx >= 0 && sx < size && sy >= 0 && sy < size) {
-                    size_t destIdx = (y * size + x) * 4;
-                    size_t sourceIdx = (sy * size + sx) * 4;
-                    uint8_t* dst = &targetBuffer[destIdx];
-                    uint8_t* src = &targetBuffer[sourceIdx];
+                    uint8_t* dst = tex.texelForWrite(targetBuffer, x, y);
+                    const uint8_t* src = tex.texelAt(targetBuffer, sx, sy);
                     
                     dst[0] = static_cast<uint8_t>(dst[0]*(1.0f-t) + src[0]*t);
                     dst[1] = static_cast<uint8_t>(dst[1]*(1.0f-t) + src[1]*t);
@@ -1054,6 +1126,12 @@ void Object::airbrushFace(int faceIndex, const glm::vec2& uv, float r, float g,
                           float radius, float density, float opacity) {
     if (faceIndex < 0 || faceIndex >= static_cast<int>(faceTextures.size())) return;
     FaceTexture& tex = faceTextures[faceIndex];
+
+    if (tex.isVector()) {
+        // Recorded as a noisy soft dab; density scales its strength
+        tex.vector->addDab(uv.x, uv.y, radius, r, g, b, opacity * density, 0.5f, VectorTexture::Airbrush);
+        return;
+    }
     
     int size = tex.size;
     int cx = static_cast<int>(uv.x * size);
@@ -1077,8 +1155,7 @@ void Object::airbrushFace(int faceIndex, const glm::vec2& uv, float r, float g,
         
         if (x >= 0 && x < size && y >= 0 && y < size) {
             float t = opacity * (1.0f - static_cast<float>(rand()) / RAND_MAX * 0.5f);
-            size_t idx = (y * size + x) * 4;
-            uint8_t* dst = &targetBuffer[idx];
+            uint8_t* dst = tex.texelForWrite(targetBuffer, x, y);
             float inv = 1.0f - t;
             dst[0] = static_cast<uint8_t>(dst[0]*inv + R*t);
             dst[1] = static_cast<uint8_t>(dst[1]*inv + G*t);
@@ -1091,7 +1168,9 @@ void Object::airbrushFace(int faceIndex, const glm::vec2& uv, float r, float g,
 
 // Layer management methods
 void Object::addTextureLayer(int faceIndex) {
-    if (faceIndex >= 0 && faceIndex < static_cast<int>(faceTextures.size())) {
+    // Sparse and vector faces keep a single layer
+    if (faceIndex >= 0 && faceIndex < static_cast<int>(faceTextures.size()) &&
+        !faceTextures[faceIndex].isSparse() && !faceTextures[faceIndex].isVector()) {
         faceTextures[faceIndex].addLayer();
         faceTextures[faceIndex].useLayers = true;
     }
@@ -1137,6 +1216,7 @@ void Object::undoStroke(int faceIndex) {
 void Object::clearStrokeHistory(int faceIndex) {
     if (faceIndex >= 0 && faceIndex < static_cast<int>(faceTextures.size())) {
         FaceTexture& tex = faceTextures[faceIndex];
+        if (tex.isSparse()) tex.sparse->clearUndo();
         for (auto& history : tex.strokeHistory) {
             history.clear();
         }
@@ -1164,7 +1244,7 @@ void Object::drawCube() const {
     glColor3f(1.0f,1.0f,1.0f);
     for (int f = 0; f < 6 && f < static_cast<int>(faceTextures.size()); ++f) {
         const FaceTexture& tex = faceTextures[f];
-        glBindTexture(GL_TEXTURE_2D, tex.id);
+        glBindTexture(GL_TEXTURE_2D, tex.textureForDraw(faceTextureDetail));
     glBegin(GL_QUADS);
         glNormal3f(faceData[f].nx, faceData[f].ny, faceData[f].nz);
         glTexCoord2f(0,0); glVertex3fv(faceData[f].vx[0]);
@@ -1203,7 +1283,7 @@ void Object::drawObject() const {
         {
             glEnable(GL_TEXTURE_2D);
             if (!faceTextures.empty()) {
-                glBindTexture(GL_TEXTURE_2D, faceTextures[0].id);
+                glBindTexture(GL_TEXTURE_2D, faceTextures[0].textureForDraw(faceTextureDetail));
             }
             glColor3f(1.0f, 1.0f, 1.0f);
             drawSpherePrimitive();
@@ -1219,13 +1299,13 @@ void Object::drawObject() const {
             glTranslatef(0.0f, 0.0f, -0.5f);
 
             // Draw side
-            if (faceTextures.size() >= 1) glBindTexture(GL_TEXTURE_2D, faceTextures[0].id);
+            if (faceTextures.size() >= 1) glBindTexture(GL_TEXTURE_2D, faceTextures[0].textureForDraw(faceTextureDetail));
             drawCylinderPrimitive(0.5f);
 
             // Draw caps with second face texture if available
             GLUquadric* disk = gluNewQuadric();
             gluQuadricTexture(disk, GL_TRUE);
-            if (faceTextures.size() >= 2) glBindTexture(GL_TEXTURE_2D, faceTextures[1].id);
+            if (faceTextures.size() >= 2) glBindTexture(GL_TEXTURE_2D, faceTextures[1].textureForDraw(faceTextureDetail));
             // Bottom cap at z = 0 (world z = -0.5) - outward normal should be -Z
             glPushMatrix();
             glRotatef(180.0f, 1.0f, 0.0f, 0.0f); // flip to face -Z
@@ -1251,11 +1331,11 @@ void Object::drawObject() const {
             glTranslatef(0.0f, 0.0f, -0.5f);
 
             // Draw side
-            if (faceTextures.size() >= 1) glBindTexture(GL_TEXTURE_2D, faceTextures[0].id);
+            if (faceTextures.size() >= 1) glBindTexture(GL_TEXTURE_2D, faceTextures[0].textureForDraw(faceTextureDetail));
             drawCylinderPrimitive(0.0f); // top radius 0 = cone
 
             // Draw base disk with second face texture if available
-            if (faceTextures.size() >= 2) glBindTexture(GL_TEXTURE_2D, faceTextures[1].id);
+            if (faceTextures.size() >= 2) glBindTexture(GL_TEXTURE_2D, faceTextures[1].textureForDraw(faceTextureDetail));
             GLUquadric* disk = gluNewQuadric();
             gluQuadricTexture(disk, GL_TRUE);
             glPushMatrix();
@@ -1287,13 +1367,9 @@ void Object::drawHighlightOutline() const {
     glm::vec3 color = sel ? glm::vec3(1.0f, 0.9f, 0.2f) : glm::vec3(1.0f, 0.2f, 0.2f);
 
     // Draw 3-4 inflated shells of collision AABB as wireframes for a soft glow effect
-    // Tailored to the object shape via its collisionZone corners (AABB). For more complex shapes, this can be extended.
-    glm::vec3 minCorner = collisionZone.corners[0];
-    glm::vec3 maxCorner = collisionZone.corners[0];
-    for (int i = 1; i < 8; ++i) {
-        minCorner = glm::min(minCorner, collisionZone.corners[i]);
-        maxCorner = glm::max(maxCorner, collisionZone.corners[i]);
-    }
+    // Tailored to the object shape via its cached world AABB. For more complex shapes, this can be extended.
+    glm::vec3 minCorner = bounds().boundsMin;
+    glm::vec3 maxCorner = bounds().boundsMax;
 
     // Compute center and half-extent
     glm::vec3 center = (minCorner + maxCorner) * 0.5f;
@@ -1527,13 +1603,13 @@ bool Object::raycastFace(const glm::vec3& rayOriginWorld, const glm::vec3& rayDi
 
     auto intersectPolyhedron = [&](float& tHit, int& faceIndex, glm::vec2& uv) -> bool {
         float bestT = 1e9f; int bestFace = -1; glm::vec2 bestUV(0.0f);
-        if (polyhedronData.vertices.empty() || polyhedronData.faces.empty()) return false;
-        for (size_t fi = 0; fi < polyhedronData.faces.size(); ++fi) {
-            const auto& face = polyhedronData.faces[fi];
+        if (getPolyhedronData().vertices.empty() || getPolyhedronData().faces.empty()) return false;
+        for (size_t fi = 0; fi < getPolyhedronData().faces.size(); ++fi) {
+            const auto& face = getPolyhedronData().faces[fi];
             if (face.size() < 3) continue;
-            glm::vec3 v0 = polyhedronData.vertices[face[0]];
-            glm::vec3 v1 = polyhedronData.vertices[face[1]];
-            glm::vec3 v2 = polyhedronData.vertices[face[2]];
+            glm::vec3 v0 = getPolyhedronData().vertices[face[0]];
+            glm::vec3 v1 = getPolyhedronData().vertices[face[1]];
+            glm::vec3 v2 = getPolyhedronData().vertices[face[2]];
             glm::vec3 normal = glm::normalize(glm::cross(v1 - v0, v2 - v0));
             float denom = glm::dot(normal, dL);
             if (fabs(denom) < 1e-6f) continue;
@@ -1549,7 +1625,7 @@ bool Object::raycastFace(const glm::vec3& rayOriginWorld, const glm::vec3& rayDi
             std::vector<glm::vec2> poly2d; poly2d.reserve(face.size());
             float minU = 1e9f, maxU = -1e9f, minV = 1e9f, maxV = -1e9f;
             for (int idx : face) {
-                glm::vec3 v = polyhedronData.vertices[idx];
+                glm::vec3 v = getPolyhedronData().vertices[idx];
                 float u = glm::dot(v - v0, tangent);
                 float vv = glm::dot(v - v0, bitangent);
                 poly2d.emplace_back(u, vv);
@@ -1604,62 +1680,97 @@ bool Object::raycastFace(const glm::vec3& rayOriginWorld, const glm::vec3& rayDi
     return false;
 }
 
-void Object::updateCollisionZone(const glm::mat4& transform) const {
-    if (geometryType == GeometryType::Polyhedron && !polyhedronData.vertices.empty()) {
-        // For polyhedrons, compute bounding box from all vertices
-        glm::vec3 minCorner = glm::vec3(std::numeric_limits<float>::max());
-        glm::vec3 maxCorner = glm::vec3(-std::numeric_limits<float>::max());
-        
-        for (const auto& vertex : polyhedronData.vertices) {
-            glm::vec4 world = transform * glm::vec4(vertex, 1.0f);
-            glm::vec3 worldVertex = glm::vec3(world);
-            minCorner = glm::min(minCorner, worldVertex);
-            maxCorner = glm::max(maxCorner, worldVertex);
+// -----------------------------------------------------------------------------
+// Collision zone and cached bounds
+// -----------------------------------------------------------------------------
+void Object::storeTransform(const glm::mat4& t) {
+    ObjectHot& record = hotRecord();
+    if (record.transform == t) return;
+    record.transform = t;
+    invalidateBounds();
+}
+
+void Object::invalidateBounds() {
+    if (++_transformVersion == 0) _transformVersion = 1; // 0 means "never computed"
+    hotRecord().flags |= ObjectHot::BoundsStale;
+}
+
+void Object::shapeChanged() {
+    const PolyhedronData& poly = getPolyhedronData();
+    if (geometryType == GeometryType::Polyhedron && !poly.vertices.empty()) {
+        _localBoundsMin = _localBoundsMax = poly.vertices[0];
+        for (const auto& v : poly.vertices) {
+            _localBoundsMin = glm::min(_localBoundsMin, v);
+            _localBoundsMax = glm::max(_localBoundsMax, v);
         }
-        
-        // Create bounding box corners
-        collisionZone.corners[0] = glm::vec3(minCorner.x, minCorner.y, minCorner.z);
-        collisionZone.corners[1] = glm::vec3(maxCorner.x, minCorner.y, minCorner.z);
-        collisionZone.corners[2] = glm::vec3(maxCorner.x, maxCorner.y, minCorner.z);
-        collisionZone.corners[3] = glm::vec3(minCorner.x, maxCorner.y, minCorner.z);
-        collisionZone.corners[4] = glm::vec3(minCorner.x, minCorner.y, maxCorner.z);
-        collisionZone.corners[5] = glm::vec3(maxCorner.x, minCorner.y, maxCorner.z);
-        collisionZone.corners[6] = glm::vec3(maxCorner.x, maxCorner.y, maxCorner.z);
-        collisionZone.corners[7] = glm::vec3(minCorner.x, maxCorner.y, maxCorner.z);
-    } else {
-        // Local-space corners of a unit cube centered at origin (legacy behavior)
-        glm::vec3 localCorners[8] = {
-            {-0.5f, -0.5f, -0.5f},
-            { 0.5f, -0.5f, -0.5f},
-            { 0.5f,  0.5f, -0.5f},
-            {-0.5f,  0.5f, -0.5f},
-            {-0.5f, -0.5f,  0.5f},
-            { 0.5f, -0.5f,  0.5f},
-            { 0.5f,  0.5f,  0.5f},
-            {-0.5f,  0.5f,  0.5f}
-        };
-        for (int i = 0; i < 8; ++i) {
-            glm::vec4 world = transform * glm::vec4(localCorners[i], 1.0f);
-            collisionZone.corners[i] = glm::vec3(world);
+        glm::vec3 center = (_localBoundsMin + _localBoundsMax) * 0.5f;
+        float radius2 = 0.0f;
+        for (const auto& v : poly.vertices) {
+            glm::vec3 d = v - center;
+            radius2 = std::max(radius2, glm::dot(d, d));
         }
+        _localRadius = std::sqrt(radius2);
+    } else {
+        // Unit cube centered at origin (legacy behavior)
+        _localBoundsMin = glm::vec3(-0.5f);
+        _localBoundsMax = glm::vec3(0.5f);
+        _localRadius = 0.8660254f;
+    }
+    invalidateBounds();
+}
+
+// Eight transformed corners of the local box whatever the shape, so
+// polyhedra no longer cost a transform per vertex. For a rotated polyhedron
+// the world AABB is that of its local box rather than of its vertices.
+void Object::computeCollisionZone(const glm::mat4& transform) const {
+    const glm::vec3& lo = _localBoundsMin;
+    const glm::vec3& hi = _localBoundsMax;
+    const glm::vec3 localCorners[8] = {
+        {lo.x, lo.y, lo.z},
+        {hi.x, lo.y, lo.z},
+        {hi.x, hi.y, lo.z},
+        {lo.x, hi.y, lo.z},
+        {lo.x, lo.y, hi.z},
+        {hi.x, lo.y, hi.z},
+        {hi.x, hi.y, hi.z},
+        {lo.x, hi.y, hi.z}
+    };
+    ObjectHot& record = hotRecord();
+    for (int i = 0; i < 8; ++i) {
+        collisionZone.corners[i] = glm::vec3(transform * glm::vec4(localCorners[i], 1.0f));
     }
+    record.boundsMin = record.boundsMax = collisionZone.corners[0];
+    for (int i = 1; i < 8; ++i) {
+        record.boundsMin = glm::min(record.boundsMin, collisionZone.corners[i]);
+        record.boundsMax = glm::max(record.boundsMax, collisionZone.corners[i]);
+    }
+
+    // Sphere scales with the largest axis scale of the matrix
+    float scale2 = std::max({glm::dot(glm::vec3(transform[0]), glm::vec3(transform[0])),
+                             glm::dot(glm::vec3(transform[1]), glm::vec3(transform[1])),
+                             glm::dot(glm::vec3(transform[2]), glm::vec3(transform[2]))});
+    record.sphereCenter = glm::vec3(transform * glm::vec4((lo + hi) * 0.5f, 1.0f));
+    record.sphereRadius = _localRadius * std::sqrt(scale2);
 }
 
-bool Object::isPointInside(const glm::vec3& point) const {
-    // Compute AABB from corners
-    glm::vec3 minCorner = collisionZone.corners[0];
-    glm::vec3 maxCorner = collisionZone.corners[0];
-    for (int i = 1; i < 8; ++i) {
-        minCorner = glm::min(minCorner, collisionZone.corners[i]);
-        maxCorner = glm::max(maxCorner, collisionZone.corners[i]);
+const ObjectHot& Object::bounds() const {
+    if (_boundsVersion != _transformVersion) {
+        computeCollisionZone(collisionTransform());
+        _boundsVersion = _transformVersion;
+        hotRecord().flags &= ~ObjectHot::BoundsStale;
     }
-    return (point.x >= minCorner.x && point.x <= maxCorner.x &&
-            point.y >= minCorner.y && point.y <= maxCorner.y &&
-            point.z >= minCorner.z && point.z <= maxCorner.z);
+    return hotRecord();
+}
+
+bool Object::isPointInside(const glm::vec3& point) const {
+    const ObjectHot& b = bounds();
+    return (point.x >= b.boundsMin.x && point.x <= b.boundsMax.x &&
+            point.y >= b.boundsMin.y && point.y <= b.boundsMax.y &&
+            point.z >= b.boundsMin.z && point.z <= b.boundsMax.z);
 }
 
 void Object::drawPolyhedron() const {
-    if (polyhedronData.vertices.empty() || polyhedronData.faces.empty()) {
+    if (getPolyhedronData().vertices.empty() || getPolyhedronData().faces.empty()) {
         return; // No polyhedron data to draw
     }
     
@@ -1667,19 +1778,19 @@ void Object::drawPolyhedron() const {
     glColor3f(1.0f, 1.0f, 1.0f);
     
     // Draw each face of the polyhedron
-    for (size_t faceIndex = 0; faceIndex < polyhedronData.faces.size(); ++faceIndex) {
-        const auto& face = polyhedronData.faces[faceIndex];
+    for (size_t faceIndex = 0; faceIndex < getPolyhedronData().faces.size(); ++faceIndex) {
+        const auto& face = getPolyhedronData().faces[faceIndex];
         if (face.size() < 3) continue; // Skip invalid faces
         
         // Bind texture for this face if available
         if (faceIndex < faceTextures.size()) {
             const FaceTexture& tex = faceTextures[faceIndex];
-            glBindTexture(GL_TEXTURE_2D, tex.id);
+            glBindTexture(GL_TEXTURE_2D, tex.textureForDraw(faceTextureDetail));
         }
         
         // Compute per-face tangent space and UVs consistent with raycast mapping, and use Newell normal
-        glm::vec3 v0 = polyhedronData.vertices[face[0]];
-        glm::vec3 normal = computeNewellNormal(polyhedronData.vertices, face);
+        glm::vec3 v0 = getPolyhedronData().vertices[face[0]];
+        glm::vec3 normal = computeNewellNormal(getPolyhedronData().vertices, face);
         glm::vec3 tangent = glm::normalize(glm::cross(fabs(normal.y) < 0.99f ? glm::vec3(0,1,0) : glm::vec3(1,0,0), normal));
         glm::vec3 bitangent = glm::normalize(glm::cross(normal, tangent));
 
@@ -1687,7 +1798,7 @@ void Object::drawPolyhedron() const {
         std::vector<glm::vec2> projected;
         projected.reserve(face.size());
         for (int idx : face) {
-            const glm::vec3& v = polyhedronData.vertices[idx];
+            const glm::vec3& v = getPolyhedronData().vertices[idx];
             float u = glm::dot(v - v0, tangent);
             float vv = glm::dot(v - v0, bitangent);
             projected.emplace_back(u, vv);
@@ -1697,7 +1808,7 @@ void Object::drawPolyhedron() const {
 
         // Triangulate face with a fan around centroid to avoid GL_POLYGON issues
         glm::vec3 centroid(0.0f);
-        for (int idx : face) centroid += polyhedronData.vertices[idx];
+        for (int idx : face) centroid += getPolyhedronData().vertices[idx];
         centroid /= static_cast<float>(face.size());
         float du = std::max(1e-6f, maxU - minU);
         float dv = std::max(1e-6f, maxV - minV);
@@ -1711,10 +1822,10 @@ void Object::drawPolyhedron() const {
             size_t i1 = (i + 1) % face.size();
             int vi0 = face[i0];
             int vi1 = face[i1];
-            if (vi0 < 0 || vi0 >= static_cast<int>(polyhedronData.vertices.size())) continue;
-            if (vi1 < 0 || vi1 >= static_cast<int>(polyhedronData.vertices.size())) continue;
-            const glm::vec3& p0 = polyhedronData.vertices[vi0];
-            const glm::vec3& p1 = polyhedronData.vertices[vi1];
+            if (vi0 < 0 || vi0 >= static_cast<int>(getPolyhedronData().vertices.size())) continue;
+            if (vi1 < 0 || vi1 >= static_cast<int>(getPolyhedronData().vertices.size())) continue;
+            const glm::vec3& p0 = getPolyhedronData().vertices[vi0];
+            const glm::vec3& p1 = getPolyhedronData().vertices[vi1];
 
             glm::vec2 proj0 = projected[i0];
             glm::vec2 proj1 = projected[i1];
@@ -1733,47 +1844,93 @@ void Object::drawPolyhedron() const {
 
 // Polyhedron-specific methods
 void Object::setPolyhedronData(const PolyhedronData& data) {
-    polyhedronData = data;
+    cold().polyhedron = data;
     if (geometryType == GeometryType::Polyhedron) {
         initFaceTextures();
+        shapeChanged();
     }
 }
 
 void Object::createTetrahedron() {
     geometryType = GeometryType::Polyhedron;
-    polyhedronData = PolyhedronData::createRegularPolyhedron(4);
+    cold().polyhedron = PolyhedronData::createRegularPolyhedron(4);
     initFaceTextures();
+    shapeChanged();
 }
 
 void Object::createOctahedron() {
     geometryType = GeometryType::Polyhedron;
-    polyhedronData = PolyhedronData::createRegularPolyhedron(8);
+    cold().polyhedron = PolyhedronData::createRegularPolyhedron(8);
     initFaceTextures();
+    shapeChanged();
 }
 
 void Object::createDodecahedron() {
     geometryType = GeometryType::Polyhedron;
-    polyhedronData = PolyhedronData::createRegularPolyhedron(12);
+    cold().polyhedron = PolyhedronData::createRegularPolyhedron(12);
     initFaceTextures();
+    shapeChanged();
 }
 
 void Object::createIcosahedron() {
     geometryType = GeometryType::Polyhedron;
-    polyhedronData = PolyhedronData::createRegularPolyhedron(20);
+    cold().polyhedron = PolyhedronData::createRegularPolyhedron(20);
     initFaceTextures();
+    shapeChanged();
 }
 
 void Object::createCustomPolyhedron(const std::vector<glm::vec3>& vertices, 
                                    const std::vector<std::vector<int>>& faces) {
     geometryType = GeometryType::Polyhedron;
-    polyhedronData = PolyhedronData::createCustomPolyhedron(vertices, faces);
+    cold().polyhedron = PolyhedronData::createCustomPolyhedron(vertices, faces);
     initFaceTextures();
+    shapeChanged();
 }
 
 Object::Object() {
     initFaceTextures();
 }
 
+// -----------------------------------------------------------------------------
+// Hot/cold storage
+// -----------------------------------------------------------------------------
+namespace {
+BlockPool<Object::ColdData>& coldPool() {
+    // Never destroyed, like the detached hot store
+    static auto* pool = new BlockPool<Object::ColdData>();
+    return *pool;
+}
+}
+
+void Object::ColdDeleter::operator()(ColdData* data) const {
+    coldPool().destroy(data);
+}
+
+Object::ColdData& Object::cold() {
+    if (!_cold) _cold.reset(coldPool().create());
+    return *_cold;
+}
+
+const Object::PolyhedronData& Object::getPolyhedronData() const {
+    static const PolyhedronData empty;
+    return _cold ? _cold->polyhedron : empty;
+}
+
+void Object::moveHotTo(ObjectHotStore& store) {
+    if (_hot.store == &store) return;
+    ObjectHot record = hotRecord();
+    hotRecord().body = ObjectHot::NoBody; // the body moves with the record
+    _hot.release();
+    _hot.store = &store;
+    _hot.index = store.add(record, this);
+}
+
+void Object::setHotFlags(uint32_t flags, bool enabled) {
+    ObjectHot& record = hotRecord();
+    if (enabled) record.flags |= flags;
+    else record.flags &= ~flags;
+}
+
 // Hover detection method implementations
 bool Object::isMouseHovering(const glm::vec2& mousePos, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix, int windowWidth, int windowHeight) const {
     // Convert screen coordinates to world coordinates
@@ -1801,53 +1958,116 @@ bool Object::isMouseHovering(const glm::vec3& worldMousePos) const {
     return isPointInside(worldMousePos);
 }
 
+Object* Object::fromEntityId(EntityId id) {
+    // Registered owners are only read through the registry, never modified
+    const Singular* owner = EntityRegistry::instance().resolve(id);
+    return const_cast<Object*>(dynamic_cast<const Object*>(owner));
+}
+
 void Object::updateHoverState(bool isHovering) {
     bool wasHovered = _wasHoveredLastFrame;
     _wasHoveredLastFrame = _isHovered;
     _isHovered = isHovering;
     
-    // Trigger events based on hover state changes
+    // Trigger events based on hover state changes; delivered before rendering
+    constexpr auto phase = Core::EventBus::FramePhase::PreRender;
     if (isHovering && !wasHovered) {
         // Mouse entered the object
         ObjectHoverEnterEvent event(*this, _hoverPoint, glm::vec2(0, 0)); // Screen pos would be passed in
-        Core::EventBus::instance().publish(event);
+        Core::EventBus::instance().publishDeferred(phase, event);
     } else if (!isHovering && wasHovered) {
         // Mouse exited the object
         ObjectHoverExitEvent event(*this, _hoverPoint, glm::vec2(0, 0)); // Screen pos would be passed in
-        Core::EventBus::instance().publish(event);
+        Core::EventBus::instance().publishDeferred(phase, event);
     } else if (isHovering) {
         // Mouse is hovering over the object
         ObjectHoverEvent event(*this, _hoverPoint, glm::vec2(0, 0)); // Screen pos would be passed in
-        Core::EventBus::instance().publish(event);
+        Core::EventBus::instance().publishDeferred(phase, event);
     }
 }
 
 // --------------------------------------------------------------
 // Attributes/Tags implementation
 // --------------------------------------------------------------
+namespace {
+const AttributeStore& emptyAttributes() {
+    static const AttributeStore empty;
+    return empty;
+}
+
+const TagSet& emptyTags() {
+    static const TagSet empty;
+    return empty;
+}
+}
+
+const AttributeStore& Object::attributes() const {
+    return _cold ? _cold->attributes : emptyAttributes();
+}
+
+const TagSet& Object::tags() const {
+    return _cold ? _cold->tags : emptyTags();
+}
+
+void Object::setAttribute(AttributeKey key, AttributeValue value) {
+    static const AttributeKey baselineKey = AttributeStore::key("baseline");
+    cold().attributes.set(key, std::move(value));
+    // Per-frame code tests the baseline role through the hot flags
+    if (key == baselineKey) {
+        const std::string* baseline = attributes().get<std::string>(baselineKey);
+        setHotFlags(ObjectHot::BaselineCube, baseline && *baseline == "cube");
+        setHotFlags(ObjectHot::BaselineGround, baseline && *baseline == "ground");
+    }
+}
+
+const AttributeValue* Object::findAttribute(AttributeKey key) const {
+    return attributes().find(key);
+}
+
+float Object::getAttributeFloat(AttributeKey key, float fallback) const {
+    return attributes().getFloat(key, fallback);
+}
+
+bool Object::hasTag(TagId tag) const {
+    return tags().has(tag);
+}
+
 void Object::setAttribute(const std::string& key, const std::string& value) {
-    attributes[key] = value;
+    setAttribute(AttributeStore::key(key), AttributeValue(value));
 }
 
+// Lookups by name use findKey so that probing unknown names (UI filters,
+// law targets) does not grow the interner
 bool Object::hasAttribute(const std::string& key) const {
-    return attributes.find(key) != attributes.end();
+    return attributes().contains(AttributeStore::findKey(key));
+}
+
+std::string Object::getAttribute(const std::string& key) const {
+    return attributes().getString(AttributeStore::findKey(key));
 }
 
-const std::string& Object::getAttribute(const std::string& key) const {
-    static const std::string empty;
-    auto it = attributes.find(key);
-    return it == attributes.end() ? empty : it->second;
+std::unordered_map<std::string, std::string> Object::getAttributes() const {
+    std::unordered_map<std::string, std::string> out;
+    attributes().forEach([&](AttributeKey key, const AttributeValue& value) {
+        out.emplace(AttributeStore::keyName(key), AttributeStore::toString(value));
+    });
+    return out;
 }
 
 void Object::addTag(const std::string& tag) {
-    if (!hasTag(tag)) tags.push_back(tag);
+    cold().tags.add(TagSet::id(tag));
 }
 
 void Object::removeTag(const std::string& tag) {
-    tags.erase(std::remove(tags.begin(), tags.end(), tag), tags.end());
+    if (_cold) _cold->tags.remove(TagSet::findId(tag));
+}
+
+std::vector<std::string> Object::getTags() const {
+    std::vector<std::string> out;
+    tags().forEach([&](TagId id) { out.push_back(TagSet::name(id)); });
+    return out;
 }
 
 bool Object::hasTag(const std::string& tag) const {
-    for (const auto& t : tags) if (t == tag) return true;
-    return false;
+    return tags().has(TagSet::findId(tag));
 }
\ No newline at end of file
@@ -9,17 +9,18 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include "Singular.hpp"
 #include "Core/EventBus.hpp"
+#include "Rendering/SparseTexture.hpp"
+#include "Rendering/VectorTexture.hpp"
+#include "ObjectHot.hpp"
+#include "ObjectAttributes.hpp"
+#include <memory>
 #include <unordered_map>
 #include <string>
+#include <ctime>
 
 // Forward declaration to break circular dependency
 class BodyPart;
 
-// Forward declaration for Object hover events
-struct ObjectHoverEvent;
-struct ObjectHoverEnterEvent;
-struct ObjectHoverExitEvent;
-
 class Object : public Singular {
 
 public:
@@ -125,6 +126,21 @@ public:
         void scaleToRadius(float radius);
     };
 
+    // Data most objects never use and no per-frame pass reads. Allocated
+    // from a pool the first time it is written; until then readers see
+    // empty defaults.
+    struct ColdData {
+        PolyhedronData polyhedron;
+        AttributeStore attributes;
+        TagSet tags;
+
+        // Formations that this Object is a part of
+        std::vector<Formations> highOFormations;
+
+        // Formations Formations that are within this object
+        std::vector<Formations> lowOFormations;
+    };
+
     std::string screenMode();
 
     // Get the dimensions of the object.
@@ -199,19 +215,72 @@ private:
     // Position in 3D space. The anchor point. Replace with glm::vec3 if using GLM for better math operations.
     float x, y, z;
 
-    // Formations that this Object is a part of
-    std::vector<Formations> highOFormations;
-
-    // Formations Formations that are within this object
-    std::vector<Formations> lowOFormations;
-
     BodyPart* part = nullptr;
 
     // The primitive shape this Object represents. Default is Cube for compatibility.
     GeometryType geometryType = GeometryType::Cube;
-    
-    // Polyhedron data for arbitrary polyhedrons
-    PolyhedronData polyhedronData;
+
+    // Polyhedron data, attributes, tags and formations (see ColdData)
+    struct ColdDeleter { void operator()(ColdData* data) const; };
+    std::unique_ptr<ColdData, ColdDeleter> _cold;
+    ColdData& cold();
+
+    // Local-space box of the collision shape (the unit cube, or the box
+    // around the polyhedron's vertices) and the radius of the sphere about
+    // its centre that holds the whole shape. Recomputed only on shape changes.
+    glm::vec3 _localBoundsMin{-0.5f};
+    glm::vec3 _localBoundsMax{0.5f};
+    float _localRadius = 0.8660254f;
+
+    // Bumped whenever the transform or the shape changes. The collision zone
+    // and the world bounds in the hot record are current while
+    // _boundsVersion matches it (0: never computed).
+    uint32_t _transformVersion = 1;
+    mutable uint32_t _boundsVersion = 0;
+    void computeCollisionZone(const glm::mat4& transform) const;
+
+    // This object's record in its hot store; a moved-from Object has none
+    // until it is next touched
+    struct HotRef {
+        ObjectHotStore* store = nullptr;
+        uint32_t index = 0;
+
+        HotRef() = default;
+        HotRef(HotRef&& other) noexcept : store(other.store), index(other.index) { other.store = nullptr; }
+        HotRef& operator=(HotRef&& other) noexcept {
+            if (this != &other) {
+                release();
+                store = other.store;
+                index = other.index;
+                other.store = nullptr;
+            }
+            return *this;
+        }
+        ~HotRef() { release(); }
+        void release() {
+            if (store) store->remove(index);
+            store = nullptr;
+        }
+    };
+    mutable HotRef _hot;
+    ObjectHot& hotRecord() const {
+        if (!_hot.store) {
+            _hot.store = &ObjectHotStore::detached();
+            ObjectHot fresh;
+            fresh.flags = ObjectHot::BoundsStale;
+            _hot.index = _hot.store->add(fresh, this);
+        }
+        return (*_hot.store)[_hot.index];
+    }
+
+    // Virtual resolution of sparse face textures; 0 means dense textures
+    int sparseFaceTextureSize = 0;
+
+    // Maximum raster resolution of vector face textures; 0 means raster textures
+    int vectorFaceTextureResolution = 0;
+
+    // Approximate on-screen size of the object in pixels, set by the renderer each frame
+    int faceTextureDetail = 0;
 
 public:
     // LEGACY flat colours kept for save/load compatibility (first 6 faces)
@@ -239,7 +308,13 @@ public:
      * **/
 
 protected:
-    glm::mat4 transform = glm::mat4(1.0f);
+    // Write the transform; the collision zone follows on the next bounds() read
+    void storeTransform(const glm::mat4& t);
+    // The matrix the local collision box is transformed by. Overridden by
+    // objects whose collision box is not their render transform.
+    virtual glm::mat4 collisionTransform() const { return getTransform(); }
+    // Recompute the local bounds after the geometry type or polyhedron changed
+    void shapeChanged();
 
 public:
 
@@ -277,7 +352,19 @@ public:
         std::vector<std::vector<StrokePoint>> strokeHistory;  // Per-layer stroke history
         std::vector<std::vector<StrokePoint>> undoStack;      // Undo stack per layer
 
+        // Sparse mode: when set, texels live in `sparse` (tiles allocated only where
+        // paint exists) and `pixels`/`layers` stay empty. Layers are not supported.
+        std::unique_ptr<SparseTexture> sparse;
+        bool isSparse() const { return sparse != nullptr; }
+
+        // Vector mode: the dab list in `vector` is the document and rasters are built
+        // per view resolution on demand. `pixels`/`layers` stay empty and `id` is unused.
+        std::unique_ptr<VectorTexture> vector;
+        bool isVector() const { return vector != nullptr; }
+
         void create(GLuint initColorRGBA = 0xFFFFFFFF) {
+            sparse.reset();
+            vector.reset();
             pixels.resize(size * size * 4);
             for (int i = 0; i < size * size; ++i) {
                 reinterpret_cast<uint32_t*>(pixels.data())[i] = initColorRGBA;
@@ -297,6 +384,57 @@ public:
             uploadToGPU();
         }
 
+        void createSparse(int virtualSize, uint32_t baseRGBA, int tileSize = SparseTexture::DefaultTileSize) {
+            vector.reset();
+            sparse = std::make_unique<SparseTexture>(virtualSize, baseRGBA, tileSize);
+            size = sparse->getSize();
+
+            // Release the dense buffers; undo lives in the sparse texture as saved tiles
+            std::vector<uint8_t>().swap(pixels);
+            layers.clear();
+            layerOpacities.clear();
+            blendModes.clear();
+            strokeHistory.clear();
+            undoStack.clear();
+            activeLayer = 0;
+            useLayers = false;
+
+            if (id == 0) glGenTextures(1, &id);
+            uploadToGPU();
+        }
+
+        void createVector(uint32_t baseRGBA, int maxResolution) {
+            sparse.reset();
+            vector = std::make_unique<VectorTexture>(baseRGBA, maxResolution);
+            size = vector->getMaxResolution();
+
+            std::vector<uint8_t>().swap(pixels);
+            layers.clear();
+            layerOpacities.clear();
+            blendModes.clear();
+            strokeHistory.assign(1, std::vector<StrokePoint>());
+            undoStack.assign(1, std::vector<StrokePoint>());
+            activeLayer = 0;
+            useLayers = false;
+        }
+
+        // Texture to bind when drawing a face about `detail` pixels across on screen
+        GLuint textureForDraw(int detail) const {
+            if (vector) return vector->textureFor(detail);
+            return id;
+        }
+
+        // Texel addressing shared by the dense and sparse paths. `buffer` is the
+        // dense target (pixels or the active layer) and is ignored in sparse mode.
+        uint8_t* texelForWrite(std::vector<uint8_t>& buffer, int x, int y) {
+            if (sparse) return sparse->texelForWrite(x, y);
+            return &buffer[(static_cast<size_t>(y) * size + x) * 4];
+        }
+        const uint8_t* texelAt(const std::vector<uint8_t>& buffer, int x, int y) const {
+            if (sparse) return sparse->texel(x, y);
+            return &buffer[(static_cast<size_t>(y) * size + x) * 4];
+        }
+
         void addLayer() {
             std::vector<uint8_t> newLayer(size * size * 4, 0);
             layers.push_back(newLayer);
@@ -335,6 +473,12 @@ public:
         }
 
         void uploadToGPU() const {
+            if (vector) return; // rasterized lazily in textureForDraw()
+            if (sparse) {
+                // Streams only the tiles painted since the last upload
+                sparse->uploadToGPU(id);
+                return;
+            }
             glBindTexture(GL_TEXTURE_2D, id);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -355,7 +499,7 @@ public:
         }
 
         void updateWholeGPU() const { 
-            if (useLayers) {
+            if (useLayers && !sparse) {
                 compositeLayers();
             }
             uploadToGPU(); 
@@ -424,6 +568,14 @@ public:
         }
 
         void saveStrokeState() {
+            if (vector) {
+                vector->beginStroke();
+                return;
+            }
+            if (sparse) {
+                sparse->beginStroke();
+                return;
+            }
             if (activeLayer >= 0 && activeLayer < static_cast<int>(strokeHistory.size())) {
                 // Save current layer state to undo stack
                 undoStack[activeLayer] = strokeHistory[activeLayer];
@@ -431,8 +583,16 @@ public:
         }
 
         void undo() {
+            if (vector) {
+                vector->undoStroke();
+                return;
+            }
+            if (sparse) {
+                if (sparse->undoStroke()) uploadToGPU();
+                return;
+            }
             if (activeLayer >= 0 && activeLayer < static_cast<int>(strokeHistory.size()) && 
-                !undoStack[activeLayer].empty()) {
+                activeLayer < static_cast<int>(layers.size()) && !undoStack[activeLayer].empty()) {
                 strokeHistory[activeLayer] = undoStack[activeLayer];
                 // Reapply strokes to layer
                 std::fill(layers[activeLayer].begin(), layers[activeLayer].end(), 0);
@@ -448,6 +608,22 @@ public:
     // Initialise or reinitialise textures after geometry type set/changed
     void initFaceTextures();
 
+    // Switch every face to a sparse virtual texture of the given resolution.
+    // Existing paint is carried over; unpainted areas keep the face's base colour.
+    // Faces created later (geometry changes) stay sparse. Pass 0 to return to dense 64×64.
+    void setSparseFaceTextures(int virtualSize = 2048);
+    int getSparseFaceTextureSize() const { return sparseFaceTextureSize; }
+
+    // Switch every face to a vector texture: strokes are stored as dabs and rasterized
+    // lazily at the resolution the view needs, up to `maxResolution`. Raster paint
+    // already on a face is not converted; the face keeps its base colour. Pass 0 to
+    // return to dense 64×64 textures.
+    void setVectorFaceTextures(int maxResolution = 1024);
+    int getVectorFaceTextureResolution() const { return vectorFaceTextureResolution; }
+
+    // On-screen size hint used to pick the raster resolution of vector faces
+    void setFaceTextureDetail(int screenPixels) { faceTextureDetail = screenPixels; }
+
     // Convenience: fill entire face with a colour (compatibility with old fill tool)
     void fillFaceColor(int faceIndex, float r, float g, float b);
 
@@ -490,8 +666,14 @@ public:
     // Older API remains but now delegates to fillFaceColor for backward compatibility
     void setFaceColor(int faceIndex, float r, float g, float b) { fillFaceColor(faceIndex, r, g, b); }
 
-    void updateCollisionZone(const glm::mat4& transform) const;
     bool isPointInside(const glm::vec3& point) const;
+    // World AABB and bounding sphere (in the hot record), recomputed from
+    // the local box only if the transform or shape changed since last time
+    const ObjectHot& bounds() const;
+    uint32_t transformVersion() const { return _transformVersion; }
+    // For changes the version cannot see, e.g. to whatever a subclass's
+    // collisionTransform() reads besides the transform
+    void invalidateBounds();
 
     void drawCube() const;
     void drawPolyhedron() const;
@@ -510,8 +692,19 @@ public:
     Object(const Object&) = delete;
     Object& operator=(const Object&) = delete;
 
-    virtual void setTransform(const glm::mat4& t) { transform = t; }
-    virtual glm::mat4 getTransform() const { return transform; }
+    // Marks the collision zone and world bounds stale; they are recomputed
+    // on the next read
+    virtual void setTransform(const glm::mat4& t) { storeTransform(t); }
+    virtual glm::mat4 getTransform() const { return hotRecord().transform; }
+
+    // Transform, world bounds, flags and physics body slot, as read by the
+    // per-frame passes
+    const ObjectHot& hot() const { return hotRecord(); }
+    // Move the hot record into `store` (a World's, when the object joins it)
+    void moveHotTo(ObjectHotStore& store);
+    void setHotFlags(uint32_t flags, bool enabled);
+    uint32_t getPhysicsBody() const { return hotRecord().body; }
+    void setPhysicsBody(uint32_t body) { hotRecord().body = body; }
 
     // Generalized ray-face intersection for painting across all geometry types.
     // Returns true if hit, along with distance t in world units, the face index, and UV in [0,1].
@@ -529,12 +722,13 @@ public:
     void setGeometryType(GeometryType t) {
         geometryType = t;
         initFaceTextures();
+        shapeChanged();
     }
     GeometryType getGeometryType() const { return geometryType; }
     
     // Polyhedron-specific methods
     void setPolyhedronData(const PolyhedronData& data);
-    const PolyhedronData& getPolyhedronData() const { return polyhedronData; }
+    const PolyhedronData& getPolyhedronData() const;
     
     // Create common polyhedrons
     void createTetrahedron();
@@ -552,24 +746,73 @@ public:
     // --------------------------------------------------------------
     // Attributes and Tags for selection/filtering (for physics laws, etc.)
     // --------------------------------------------------------------
+    // Typed access by interned key (see AttributeStore::key)
+    void setAttribute(AttributeKey key, AttributeValue value);
+    const AttributeValue* findAttribute(AttributeKey key) const;
+    float getAttributeFloat(AttributeKey key, float fallback) const;
+    bool hasTag(TagId tag) const;
+    const AttributeStore& attributes() const;
+    const TagSet& tags() const;
+
+    // String access; typed values are formatted as text
     void setAttribute(const std::string& key, const std::string& value);
     bool hasAttribute(const std::string& key) const;
-    const std::string& getAttribute(const std::string& key) const; // empty string if missing
-    const std::unordered_map<std::string, std::string>& getAttributes() const { return attributes; }
+    std::string getAttribute(const std::string& key) const; // empty string if missing
+    std::unordered_map<std::string, std::string> getAttributes() const;
     void addTag(const std::string& tag);
     void removeTag(const std::string& tag);
     bool hasTag(const std::string& tag) const;
-    const std::vector<std::string>& getTags() const { return tags; }
+    std::vector<std::string> getTags() const; // in interning order
+
+    // The live Object registered under `id`, or null once it is destroyed
+    static Object* fromEntityId(EntityId id);
 
 private:
     // Hover state tracking
     mutable bool _isHovered = false;
     mutable glm::vec3 _hoverPoint{0.0f, 0.0f, 0.0f};
     mutable bool _wasHoveredLastFrame = false;
+};
+
+// Hover events, delivered at FramePhase::PreRender. They name the object by
+// EntityId because it may be destroyed before the phase is flushed;
+// object() is null then.
+struct ObjectHoverEvent {
+    EntityId objectId;
+    glm::vec3 hoverPoint;
+    glm::vec2 screenPosition;
+    std::time_t timestamp;
+
+    ObjectHoverEvent(const Object& obj, const glm::vec3& point, const glm::vec2& screen)
+        : objectId(obj.entityId()), hoverPoint(point), screenPosition(screen), timestamp(std::time(nullptr)) {}
+
+    Object* object() const { return Object::fromEntityId(objectId); }
+    // One hover per object per frame
+    uint64_t coalesceKey() const { return objectId.value(); }
+};
+
+struct ObjectHoverEnterEvent {
+    EntityId objectId;
+    glm::vec3 hoverPoint;
+    glm::vec2 screenPosition;
+    std::time_t timestamp;
+
+    ObjectHoverEnterEvent(const Object& obj, const glm::vec3& point, const glm::vec2& screen)
+        : objectId(obj.entityId()), hoverPoint(point), screenPosition(screen), timestamp(std::time(nullptr)) {}
+
+    Object* object() const { return Object::fromEntityId(objectId); }
+};
+
+struct ObjectHoverExitEvent {
+    EntityId objectId;
+    glm::vec3 lastHoverPoint;
+    glm::vec2 lastScreenPosition;
+    std::time_t timestamp;
+
+    ObjectHoverExitEvent(const Object& obj, const glm::vec3& point, const glm::vec2& screen)
+        : objectId(obj.entityId()), lastHoverPoint(point), lastScreenPosition(screen), timestamp(std::time(nullptr)) {}
 
-    // Attributes and tags storage
-    std::unordered_map<std::string, std::string> attributes;
-    std::vector<std::string> tags;
+    Object* object() const { return Object::fromEntityId(objectId); }
 };
 
 struct StateSnapshot {
@@ -0,0 +1,152 @@
+#include "ObjectAttributes.hpp"
+#include "Util/StringInterner.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+// Never destroyed: objects with static storage may look names up during
+// static destruction
+StringInterner& attributeNames() {
+    static auto* names = new StringInterner();
+    return *names;
+}
+
+StringInterner& tagNames() {
+    static auto* names = new StringInterner();
+    return *names;
+}
+}
+
+// -----------------------------------------------------------------------------
+// AttributeStore
+// -----------------------------------------------------------------------------
+AttributeKey AttributeStore::key(std::string_view name) {
+    return attributeNames().intern(name);
+}
+
+AttributeKey AttributeStore::findKey(std::string_view name) {
+    uint32_t id = attributeNames().find(name);
+    return id == StringInterner::NotFound ? NoKey : id;
+}
+
+std::string AttributeStore::keyName(AttributeKey key) {
+    return attributeNames().lookup(key);
+}
+
+AttributeStore::Entry* AttributeStore::findEntry(AttributeKey key) {
+    for (size_t i = 0; i < _inlineCount; ++i) {
+        if (_inline[i].key == key) return &_inline[i];
+    }
+    for (auto& e : _overflow) {
+        if (e.key == key) return &e;
+    }
+    return nullptr;
+}
+
+const AttributeValue* AttributeStore::find(AttributeKey key) const {
+    if (key == NoKey) return nullptr;
+    const Entry* e = const_cast<AttributeStore*>(this)->findEntry(key);
+    return e ? &e->value : nullptr;
+}
+
+void AttributeStore::set(AttributeKey key, AttributeValue value) {
+    if (key == NoKey) return;
+    if (Entry* e = findEntry(key)) {
+        e->value = std::move(value);
+    } else if (_inlineCount < InlineCount) {
+        _inline[_inlineCount].key = key;
+        _inline[_inlineCount].value = std::move(value);
+        ++_inlineCount;
+    } else {
+        _overflow.push_back(Entry{key, std::move(value)});
+    }
+}
+
+// Swap-with-last removal; attribute order is not meaningful
+bool AttributeStore::erase(AttributeKey key) {
+    Entry* e = findEntry(key);
+    if (!e) return false;
+    Entry& last = at(size() - 1);
+    if (e != &last) *e = std::move(last);
+    if (!_overflow.empty()) {
+        _overflow.pop_back();
+    } else {
+        --_inlineCount;
+        _inline[_inlineCount] = Entry();
+    }
+    return true;
+}
+
+float AttributeStore::getFloat(AttributeKey key, float fallback) const {
+    const AttributeValue* value = find(key);
+    if (!value) return fallback;
+    if (const float* f = std::get_if<float>(value)) return *f;
+    if (const int32_t* i = std::get_if<int32_t>(value)) return static_cast<float>(*i);
+    if (const bool* b = std::get_if<bool>(value)) return *b ? 1.0f : 0.0f;
+    if (const std::string* s = std::get_if<std::string>(value)) {
+        // Accepts a numeric prefix, as std::stof did for the old string attributes
+        char* end = nullptr;
+        float parsed = std::strtof(s->c_str(), &end);
+        return end != s->c_str() ? parsed : fallback;
+    }
+    return fallback;
+}
+
+std::string AttributeStore::getString(AttributeKey key) const {
+    const AttributeValue* value = find(key);
+    return value ? toString(*value) : std::string();
+}
+
+std::string AttributeStore::toString(const AttributeValue& value) {
+    if (const std::string* s = std::get_if<std::string>(&value)) return *s;
+    if (const float* f = std::get_if<float>(&value)) return std::to_string(*f);
+    if (const int32_t* i = std::get_if<int32_t>(&value)) return std::to_string(*i);
+    if (const bool* b = std::get_if<bool>(&value)) return *b ? "true" : "false";
+    const glm::vec3& v = std::get<glm::vec3>(value);
+    char buffer[96];
+    snprintf(buffer, sizeof(buffer), "%g %g %g", v.x, v.y, v.z);
+    return buffer;
+}
+
+// -----------------------------------------------------------------------------
+// TagSet
+// -----------------------------------------------------------------------------
+TagId TagSet::id(std::string_view name) {
+    return tagNames().intern(name);
+}
+
+TagId TagSet::findId(std::string_view name) {
+    uint32_t id = tagNames().find(name);
+    return id == StringInterner::NotFound ? NoTag : id;
+}
+
+std::string TagSet::name(TagId id) {
+    return tagNames().lookup(id);
+}
+
+void TagSet::add(TagId id) {
+    if (id == NoTag) return;
+    if (id < 64) {
+        _inline |= uint64_t(1) << id;
+        return;
+    }
+    size_t word = (id - 64) / 64;
+    if (word >= _overflow.size()) _overflow.resize(word + 1, 0);
+    _overflow[word] |= uint64_t(1) << ((id - 64) % 64);
+}
+
+void TagSet::remove(TagId id) {
+    if (id == NoTag) return;
+    if (id < 64) {
+        _inline &= ~(uint64_t(1) << id);
+        return;
+    }
+    size_t word = (id - 64) / 64;
+    if (word < _overflow.size()) _overflow[word] &= ~(uint64_t(1) << ((id - 64) % 64));
+}
+
+bool TagSet::empty() const {
+    return _inline == 0 && std::all_of(_overflow.begin(), _overflow.end(), [](uint64_t w) { return w == 0; });
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+// Interned attribute name; the same name always maps to the same key
+using AttributeKey = uint32_t;
+using AttributeValue = std::variant<std::string, float, int32_t, bool, glm::vec3>;
+
+// Key/value attributes of one object. Keys are interned process-wide, so a
+// lookup compares integers; the first few entries live inline and only
+// objects with many attributes spill into a heap vector. Values keep their
+// type, so numeric attributes like "mass" are not re-parsed on every read.
+class AttributeStore {
+public:
+    static constexpr AttributeKey NoKey = 0xFFFFFFFFu;
+
+    // Interns the name. Hot paths should call this once and keep the key.
+    static AttributeKey key(std::string_view name);
+    // NoKey if no object has ever used the name; never interns
+    static AttributeKey findKey(std::string_view name);
+    static std::string keyName(AttributeKey key);
+
+    void set(AttributeKey key, AttributeValue value);
+    bool erase(AttributeKey key);
+    const AttributeValue* find(AttributeKey key) const;
+    bool contains(AttributeKey key) const { return find(key) != nullptr; }
+
+    // Null if missing or stored with another type
+    template <typename T>
+    const T* get(AttributeKey key) const {
+        const AttributeValue* value = find(key);
+        return value ? std::get_if<T>(value) : nullptr;
+    }
+
+    // Numbers and bools convert; strings are parsed. `fallback` if missing,
+    // a vector, or not a number.
+    float getFloat(AttributeKey key, float fallback) const;
+    // Formatted as text; empty if missing
+    std::string getString(AttributeKey key) const;
+    static std::string toString(const AttributeValue& value);
+
+    size_t size() const { return _inlineCount + _overflow.size(); }
+    bool empty() const { return size() == 0; }
+
+    // fn(AttributeKey, const AttributeValue&), in no particular order
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        for (size_t i = 0; i < _inlineCount; ++i) fn(_inline[i].key, _inline[i].value);
+        for (const auto& e : _overflow) fn(e.key, e.value);
+    }
+
+private:
+    struct Entry {
+        AttributeKey key = NoKey;
+        AttributeValue value;
+    };
+    static constexpr size_t InlineCount = 4;
+
+    Entry* findEntry(AttributeKey key);
+    Entry& at(size_t i) { return i < _inlineCount ? _inline[i] : _overflow[i - _inlineCount]; }
+
+    std::array<Entry, InlineCount> _inline;
+    uint8_t _inlineCount = 0;
+    std::vector<Entry> _overflow;
+};
+
+// Interned tag name
+using TagId = uint32_t;
+
+// Set of tags as a bitset over interned tag IDs: membership is one shift
+// and mask. The first 64 tags ever interned fit in the inline word.
+class TagSet {
+public:
+    static constexpr TagId NoTag = 0xFFFFFFFFu;
+
+    static TagId id(std::string_view name);
+    // NoTag if the name was never interned; never interns
+    static TagId findId(std::string_view name);
+    static std::string name(TagId id);
+
+    void add(TagId id);
+    void remove(TagId id);
+    bool has(TagId id) const {
+        if (id < 64) return (_inline >> id) & 1u;
+        size_t word = (id - 64) / 64;
+        return word < _overflow.size() && ((_overflow[word] >> ((id - 64) % 64)) & 1u);
+    }
+    bool empty() const;
+
+    // fn(TagId) in ascending ID order
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        for (TagId i = 0; i < 64; ++i) if ((_inline >> i) & 1u) fn(i);
+        for (size_t w = 0; w < _overflow.size(); ++w) {
+            for (TagId i = 0; i < 64; ++i) {
+                if ((_overflow[w] >> i) & 1u) fn(static_cast<TagId>(64 + w * 64 + i));
+            }
+        }
+    }
+
+private:
+    uint64_t _inline = 0;
+    std::vector<uint64_t> _overflow;   // tags 64 and up
+};
@@ -0,0 +1,40 @@
+#include "ObjectHot.hpp"
+
+ObjectHotStore& ObjectHotStore::detached() {
+    // Never destroyed: objects with static storage may release their records
+    // after function-local statics have already been torn down
+    static ObjectHotStore* store = new ObjectHotStore();
+    return *store;
+}
+
+static ObjectHotStore::BodyReleaseHook s_bodyReleaseHook = nullptr;
+
+void ObjectHotStore::setBodyReleaseHook(BodyReleaseHook hook) {
+    s_bodyReleaseHook = hook;
+}
+
+uint32_t ObjectHotStore::add(const ObjectHot& hot, const Object* owner) {
+    uint32_t index;
+    if (!_free.empty()) {
+        index = _free.back();
+        _free.pop_back();
+        _records[index] = hot;
+        _owners[index] = owner;
+    } else {
+        index = static_cast<uint32_t>(_records.size());
+        _records.push_back(hot);
+        _owners.push_back(owner);
+    }
+    _records[index].flags |= ObjectHot::Live;
+    return index;
+}
+
+void ObjectHotStore::remove(uint32_t index) {
+    if (index >= _records.size() || !(_records[index].flags & ObjectHot::Live)) return;
+    if (_records[index].body != ObjectHot::NoBody && s_bodyReleaseHook) {
+        s_bodyReleaseHook(_records[index].body, _owners[index]);
+    }
+    _records[index] = ObjectHot();
+    _owners[index] = nullptr;
+    _free.push_back(index);
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+class Object;
+
+// The part of an Object that every per-frame pass (physics, collision,
+// picking, culling, render) reads. Kept out of Object itself so a world's
+// records sit next to each other in one array instead of being scattered
+// across large, individually allocated Objects.
+struct ObjectHot {
+    enum Flags : uint32_t {
+        Live           = 1u << 0,   // cell is in use
+        BaselineCube   = 1u << 1,   // the spinning demo cube
+        BaselineGround = 1u << 2,   // the ground placeholder
+        BoundsStale    = 1u << 3,   // bounds predate the last transform or shape change;
+                                    // call the owner's Object::bounds() before reading them
+    };
+    static constexpr uint32_t NoBody = 0xFFFFFFFFu;
+
+    glm::mat4 transform{1.0f};
+    glm::vec3 boundsMin{0.0f};     // world AABB of the collision zone
+    uint32_t flags = 0;
+    glm::vec3 boundsMax{0.0f};
+    uint32_t body = NoBody;        // Physics rigid body slot
+    glm::vec3 sphereCenter{0.0f};  // world bounding sphere of the collision shape
+    float sphereRadius = 0.0f;
+};
+
+// Dense array of ObjectHot records. Each World owns one for its objects;
+// objects outside any world (body parts, previews, Ourverse's own list) use
+// the shared detached() store. Freed cells are recycled rather than
+// compacted, so an Object's index stays valid for as long as it lives in
+// the store; passes skip cells without the Live flag.
+//
+// Main thread only.
+class ObjectHotStore {
+public:
+    static ObjectHotStore& detached();
+
+    // Called when a record that still holds a physics body is removed, so
+    // the physics registry can recycle the slot. Physics installs it.
+    using BodyReleaseHook = void (*)(uint32_t body, const Object* owner);
+    static void setBodyReleaseHook(BodyReleaseHook hook);
+
+    uint32_t add(const ObjectHot& hot, const Object* owner = nullptr);
+    void remove(uint32_t index);
+
+    ObjectHot& operator[](uint32_t index) { return _records[index]; }
+    const ObjectHot& operator[](uint32_t index) const { return _records[index]; }
+
+    // All cells, live or not, and the object each live cell belongs to
+    // (null for records added without an owner)
+    const std::vector<ObjectHot>& records() const { return _records; }
+    const Object* ownerAt(uint32_t index) const { return _owners[index]; }
+    size_t liveCount() const { return _records.size() - _free.size(); }
+
+private:
+    std::vector<ObjectHot> _records;
+    std::vector<const Object*> _owners;
+    std::vector<uint32_t> _free;
+};
@@ -0,0 +1,28 @@
+#include "Singular.hpp"
+
+Singular::Singular(Singular&& other) noexcept : _entityId(other._entityId) {
+    other._entityId = EntityId();
+    if (_entityId.isValid()) EntityRegistry::instance().rebind(_entityId, this);
+}
+
+Singular& Singular::operator=(Singular&& other) noexcept {
+    if (this == &other) return *this;
+    if (_entityId.isValid()) EntityRegistry::instance().release(_entityId);
+    _entityId = other._entityId;
+    other._entityId = EntityId();
+    if (_entityId.isValid()) EntityRegistry::instance().rebind(_entityId, this);
+    return *this;
+}
+
+Singular::~Singular() {
+    if (_entityId.isValid()) EntityRegistry::instance().release(_entityId);
+}
+
+EntityId Singular::entityId() const {
+    if (!_entityId.isValid()) _entityId = EntityRegistry::instance().acquire(this, getIdentifier());
+    return _entityId;
+}
+
+void Singular::syncEntityName() const {
+    if (_entityId.isValid()) EntityRegistry::instance().rename(_entityId, getIdentifier());
+}
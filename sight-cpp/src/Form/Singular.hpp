@@ -1,5 +1,6 @@
 #pragma once
 #include <string>
+#include "EntityRegistry.hpp"
 
 // ------------------------------------------------------------------
 // A Singular represents any entity or concept with meaning greater than the sum of its parts.
@@ -7,9 +8,32 @@
 // Any class that wishes to participate in Relation should inherit
 // from this interface and provide a stable textual identifier
 // via getIdentifier().
+//
+// Every Singular can also be addressed by a compact numeric EntityId,
+// handed out by the EntityRegistry the first time entityId() is called.
+// Hot-path containers should key on entityId().value() rather than on
+// identifier strings.
 // ------------------------------------------------------------------
 class Singular {
 public:
-    virtual ~Singular() = default;
+    Singular() = default;
+    // A copy is a different entity and gets its own ID on demand
+    Singular(const Singular&) {}
+    Singular& operator=(const Singular&) { return *this; }
+    // A moved-to Singular is the same entity and keeps the ID
+    Singular(Singular&& other) noexcept;
+    Singular& operator=(Singular&& other) noexcept;
+    virtual ~Singular();
+
     virtual std::string getIdentifier() const = 0;
-}; 
\ No newline at end of file
+
+    // Registers under the current identifier on first use. Must not be called
+    // from a base-class constructor (getIdentifier() is virtual).
+    EntityId entityId() const;
+    bool hasEntityId() const { return _entityId.isValid(); }
+    // Re-publish getIdentifier() to the registry after it changes
+    void syncEntityName() const;
+
+private:
+    mutable EntityId _entityId;
+};
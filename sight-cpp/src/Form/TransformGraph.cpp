@@ -0,0 +1,195 @@
+#include "TransformGraph.hpp"
+#include <algorithm>
+#include <cstdio>
+
+TransformGraph& TransformGraph::instance() {
+    // Never destroyed: objects with static storage may destroy their nodes
+    // after function-local statics have already been torn down
+    static TransformGraph* graph = new TransformGraph();
+    return *graph;
+}
+
+TransformGraph::Node* TransformGraph::find(TransformNode node) {
+    if (node.index >= _nodes.size()) return nullptr;
+    Node& n = _nodes[node.index];
+    return n.alive && n.generation == node.generation ? &n : nullptr;
+}
+
+const TransformGraph::Node* TransformGraph::find(TransformNode node) const {
+    return const_cast<TransformGraph*>(this)->find(node);
+}
+
+bool TransformGraph::contains(TransformNode node) const {
+    return find(node) != nullptr;
+}
+
+// -----------------------------------------------------------------------------
+// Structure
+// -----------------------------------------------------------------------------
+TransformNode TransformGraph::create(const glm::mat4& local, TransformNode parent) {
+    uint32_t index;
+    if (!_freeSlots.empty() && !_updating) {
+        index = _freeSlots.back();
+        _freeSlots.pop_back();
+    } else {
+        index = static_cast<uint32_t>(_nodes.size());
+        _nodes.emplace_back();
+    }
+    Node& n = _nodes[index];
+    if (++n.generation == 0) n.generation = 1; // skip the invalid generation on wrap
+    n.alive = true;
+    n.local = local;
+    n.world = local;
+    n.dirty = true;
+    n.moved = false;
+    n.parent = find(parent) ? parent.index : NoParent;
+    n.callback = nullptr;
+    ++_liveCount;
+
+    // A new leaf can go straight to the end of the order; its parent is
+    // already somewhere before it
+    if (!_orderDirty) _order.push_back(index);
+    return TransformNode{index, n.generation};
+}
+
+// Finding the children is a scan of the graph; destruction is rare
+void TransformGraph::destroy(TransformNode node) {
+    Node* n = find(node);
+    if (!n) return;
+    for (auto& other : _nodes) {
+        if (other.alive && other.parent == node.index) {
+            other.parent = NoParent;
+            other.dirty = true;
+        }
+    }
+    n->alive = false;
+    n->callback = nullptr;
+    _freeSlots.push_back(node.index);
+    --_liveCount;
+    _orderDirty = true;
+}
+
+bool TransformGraph::setParent(TransformNode node, TransformNode parent) {
+    Node* n = find(node);
+    if (!n) return false;
+    uint32_t parentIndex = NoParent;
+    if (parent.isValid()) {
+        if (!find(parent)) return false;
+        for (uint32_t i = parent.index; i != NoParent; i = _nodes[i].parent) {
+            if (i == node.index) {
+                printf("[TransformGraph] Refusing to parent node %u under its own descendant %u\n", node.index, parent.index);
+                return false;
+            }
+        }
+        parentIndex = parent.index;
+    }
+    if (n->parent == parentIndex) return true;
+    n->parent = parentIndex;
+    n->dirty = true;
+    _orderDirty = true;
+    return true;
+}
+
+TransformNode TransformGraph::parentOf(TransformNode node) const {
+    const Node* n = find(node);
+    if (!n || n->parent == NoParent) return TransformNode();
+    return TransformNode{n->parent, _nodes[n->parent].generation};
+}
+
+// -----------------------------------------------------------------------------
+// Matrices
+// -----------------------------------------------------------------------------
+void TransformGraph::setLocal(TransformNode node, const glm::mat4& local) {
+    Node* n = find(node);
+    if (!n || n->local == local) return;
+    n->local = local;
+    n->dirty = true;
+}
+
+const glm::mat4& TransformGraph::local(TransformNode node) const {
+    static const glm::mat4 identity(1.0f);
+    const Node* n = find(node);
+    return n ? n->local : identity;
+}
+
+const glm::mat4& TransformGraph::world(TransformNode node) const {
+    static const glm::mat4 identity(1.0f);
+    const Node* n = find(node);
+    return n ? n->world : identity;
+}
+
+glm::mat4 TransformGraph::resolve(TransformNode node) const {
+    const Node* n = find(node);
+    if (!n) return glm::mat4(1.0f);
+    glm::mat4 world = n->local;
+    for (uint32_t i = n->parent; i != NoParent; i = _nodes[i].parent) world = _nodes[i].local * world;
+    return world;
+}
+
+void TransformGraph::setCallback(TransformNode node, WorldCallback callback) {
+    if (Node* n = find(node)) n->callback = std::move(callback);
+}
+
+// -----------------------------------------------------------------------------
+// Batch update
+// -----------------------------------------------------------------------------
+// Sort live slots by depth (counting sort), which puts every parent before
+// its children. O(n); only needed after reparenting or destruction.
+void TransformGraph::rebuildOrder() {
+    std::vector<int32_t> depth(_nodes.size(), -1);
+    std::vector<uint32_t> chain;
+    int32_t maxDepth = -1;
+    for (uint32_t i = 0; i < _nodes.size(); ++i) {
+        if (!_nodes[i].alive || depth[i] >= 0) continue;
+        // Walk up to the first node with a known depth, then fill in downwards
+        uint32_t at = i;
+        while (at != NoParent && depth[at] < 0) {
+            chain.push_back(at);
+            at = _nodes[at].parent;
+        }
+        int32_t d = at == NoParent ? -1 : depth[at];
+        while (!chain.empty()) {
+            depth[chain.back()] = ++d;
+            chain.pop_back();
+        }
+        maxDepth = std::max(maxDepth, d);
+    }
+
+    std::vector<uint32_t> start(static_cast<size_t>(maxDepth) + 2, 0);
+    for (uint32_t i = 0; i < _nodes.size(); ++i) {
+        if (_nodes[i].alive) ++start[depth[i] + 1];
+    }
+    for (size_t d = 1; d < start.size(); ++d) start[d] += start[d - 1];
+    _order.assign(_liveCount, 0);
+    for (uint32_t i = 0; i < _nodes.size(); ++i) {
+        if (_nodes[i].alive) _order[start[depth[i]]++] = i;
+    }
+    _orderDirty = false;
+}
+
+size_t TransformGraph::update() {
+    if (_orderDirty) rebuildOrder();
+    size_t recomputed = 0;
+    // By index over the order as it stands now: a callback that creates a
+    // node grows _order and _nodes, so no reference may be held across one
+    const size_t count = _order.size();
+    _updating = true;
+    for (size_t i = 0; i < count; ++i) {
+        const uint32_t index = _order[i];
+        Node& n = _nodes[index];
+        if (!n.alive) continue; // destroyed by an earlier callback this pass
+        const Node* parent = n.parent != NoParent ? &_nodes[n.parent] : nullptr;
+        n.moved = n.dirty || (parent && parent->moved);
+        if (!n.moved) continue;
+        n.world = parent ? parent->world * n.local : n.local;
+        n.dirty = false;
+        ++recomputed;
+        if (n.callback) {
+            const glm::mat4 world = n.world;
+            const WorldCallback callback = n.callback;
+            callback(world);
+        }
+    }
+    _updating = false;
+    return recomputed;
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <vector>
+#include <functional>
+#include <cstdint>
+#include <utility>
+#include <glm/glm.hpp>
+#include "Util/SlotMap.hpp"
+
+// Handle of a node in the TransformGraph; stops resolving once destroyed
+using TransformNode = SlotHandle;
+
+// Scene graph of local/world transforms with parent links.
+//
+// Owners write local matrices; a node whose local matrix changes is marked
+// dirty and nothing else happens until update(), which walks the live nodes
+// once in parent-before-child order and recomputes world = parentWorld * local
+// only for dirty nodes and the subtrees below them. Readers (rendering,
+// collision zones, picking) use the cached world matrices, so each world
+// transform is computed at most once per update() however often its owner
+// moves in between.
+//
+// A node may carry a callback that receives its new world matrix whenever
+// update() recomputes it; objects use that to refresh their own copy and
+// their collision zone.
+//
+// Main thread only.
+class TransformGraph {
+public:
+    using WorldCallback = std::function<void(const glm::mat4& world)>;
+
+    static TransformGraph& instance();
+
+    TransformNode create(const glm::mat4& local = glm::mat4(1.0f), TransformNode parent = TransformNode());
+    // Children of a destroyed node become roots, keeping their local matrix
+    void destroy(TransformNode node);
+    bool contains(TransformNode node) const;
+
+    // Returns false (and changes nothing) if `parent` is dead or would make a cycle.
+    // Pass an invalid handle to detach.
+    bool setParent(TransformNode node, TransformNode parent);
+    TransformNode parentOf(TransformNode node) const;
+
+    // Marks the node dirty only if the matrix actually differs
+    void setLocal(TransformNode node, const glm::mat4& local);
+    const glm::mat4& local(TransformNode node) const;
+    // As of the last update()
+    const glm::mat4& world(TransformNode node) const;
+    // Current world matrix from the local matrices up the parent chain,
+    // without waiting for (or touching the cache of) the next update().
+    // For the odd mid-frame reader; costs one multiply per ancestor.
+    glm::mat4 resolve(TransformNode node) const;
+
+    void setCallback(TransformNode node, WorldCallback callback);
+
+    // One batch pass over the whole graph; returns how many world matrices
+    // were recomputed. Callbacks may create or destroy nodes: nodes created
+    // during the pass wait for the next one, destroyed ones are skipped.
+    size_t update();
+
+    size_t size() const { return _liveCount; }
+
+private:
+    TransformGraph() = default;
+
+    static constexpr uint32_t NoParent = 0xFFFFFFFFu;
+
+    struct Node {
+        glm::mat4 local{1.0f};
+        glm::mat4 world{1.0f};
+        uint32_t parent = NoParent;    // slot index
+        uint32_t generation = 0;
+        bool alive = false;
+        bool dirty = true;
+        bool moved = false;            // recomputed in the current pass
+        WorldCallback callback;
+    };
+
+    Node* find(TransformNode node);
+    const Node* find(TransformNode node) const;
+    void rebuildOrder();
+
+    std::vector<Node> _nodes;          // by slot index
+    std::vector<uint32_t> _freeSlots;
+    std::vector<uint32_t> _order;      // live slots, every parent before its children
+    bool _orderDirty = false;
+    bool _updating = false;            // free slots are not reused mid-pass
+    size_t _liveCount = 0;
+};
+
+// Owns one TransformGraph node for the lifetime of an object. A copy gets
+// its own node with the same local matrix and parent; children and the
+// callback stay with the original.
+class TransformHandle {
+public:
+    explicit TransformHandle(const glm::mat4& local = glm::mat4(1.0f))
+        : _node(TransformGraph::instance().create(local)) {}
+    ~TransformHandle() { TransformGraph::instance().destroy(_node); }
+
+    TransformHandle(const TransformHandle& other) : _node(clone(other._node)) {}
+    TransformHandle& operator=(const TransformHandle& other) {
+        if (this != &other) {
+            auto& graph = TransformGraph::instance();
+            graph.setLocal(_node, graph.local(other._node));
+            graph.setParent(_node, graph.parentOf(other._node));
+        }
+        return *this;
+    }
+    TransformHandle(TransformHandle&& other) noexcept : _node(other._node) { other._node = TransformNode(); }
+    TransformHandle& operator=(TransformHandle&& other) noexcept {
+        std::swap(_node, other._node);
+        return *this;
+    }
+
+    TransformNode node() const { return _node; }
+
+private:
+    static TransformNode clone(TransformNode node) {
+        auto& graph = TransformGraph::instance();
+        return graph.create(graph.local(node), graph.parentOf(node));
+    }
+
+    TransformNode _node;
+};
@@ -95,6 +95,8 @@ std::string Tool::getTypeName() const
     // Effects Tools
     case Type::Blur:
         return "Blur";
+    case Type::GaussianBlur:
+        return "Gaussian Blur";
     case Type::Sharpen:
         return "Sharpen";
     case Type::Noise:
@@ -203,11 +205,11 @@ void Tool::use(GLFWwindow *window, ZoneManager &mgr, Zone &zone, Type type, Core
         if (mouseLeftNow && !game.getMouseLeftPressedLast())
         {
             float radius = 16.0f;
-            auto &strokes = zone.strokes;
-            for (auto it = strokes.begin(); it != strokes.end();)
+            const auto &strokes = zone.strokes;
+            for (size_t s = 0; s < strokes.size();)
             {
                 bool erase = false;
-                const auto &pts = it->points;
+                const auto &pts = strokes[s].points;
                 if (pts.size() >= 4)
                 {
                     for (size_t i = 0; i + 3 < pts.size(); i += 2)
@@ -238,10 +240,11 @@ void Tool::use(GLFWwindow *window, ZoneManager &mgr, Zone &zone, Type type, Core
                     }
                 }
 
+                // Through the zone so only the affected part of the stroke cache is rebuilt
                 if (erase)
-                    it = strokes.erase(it);
+                    zone.removeStroke(s);
                 else
-                    ++it;
+                    ++s;
             }
         }
     }
@@ -363,6 +366,10 @@ void Tool::use(GLFWwindow *window, ZoneManager &mgr, Zone &zone, Type type, Core
                 if (zone.getDesignSystem() && zone.getDesignSystem()->getSelectionSystem())
                 {
                     zone.getDesignSystem()->getSelectionSystem()->createSelection(selectionType, selectionPoints);
+                    if (selectionType == SelectionSystem::SelectionType::Rectangle)
+                    {
+                        zone.getDesignSystem()->selectElementsInRect(selectionPoints.front(), selectionPoints.back());
+                    }
                 }
             }
             selecting = false;
@@ -371,6 +378,7 @@ void Tool::use(GLFWwindow *window, ZoneManager &mgr, Zone &zone, Type type, Core
 
     // Effects tools
     else if (type == Tool::Type::Blur ||
+             type == Tool::Type::GaussianBlur ||
              type == Tool::Type::Sharpen ||
              type == Tool::Type::Noise ||
              type == Tool::Type::Emboss ||
@@ -389,6 +397,9 @@ void Tool::use(GLFWwindow *window, ZoneManager &mgr, Zone &zone, Type type, Core
             case Tool::Type::Blur:
                 effectType = EffectsSystem::EffectType::Blur;
                 break;
+            case Tool::Type::GaussianBlur:
+                effectType = EffectsSystem::EffectType::GaussianBlur;
+                break;
             case Tool::Type::Sharpen:
                 effectType = EffectsSystem::EffectType::Sharpen;
                 break;
@@ -730,7 +741,6 @@ void Tool::ShapeGenerator3D(GLFWwindow *window, Core::Game *game, ZoneManager &m
                                          game->getBrushScale().z * game->getBrushSize());
         t = glm::scale(t, totalScale);
         obj->setTransform(t);
-        obj->updateCollisionZone(t);
         for (int f = 0; f < 6; ++f)
             obj->setFaceColor(f, game->getCurrentColor(0), game->getCurrentColor(1), game->getCurrentColor(2));
         mgr.active().world().addObject(std::move(obj));
@@ -908,7 +918,6 @@ void Tool::Pottery3D(GLFWwindow *window, Core::Game *game, ZoneManager &mgr, flo
             glm::mat4 newT = glm::translate(glm::mat4(1.0f), translation);
             newT = glm::scale(newT, glm::vec3(scaleX, scaleY, scaleZ));
             hitObj->setTransform(newT);
-            hitObj->updateCollisionZone(newT);
         }
     }
 }
@@ -1061,6 +1070,14 @@ void Tool::FacePaint(GLFWwindow *window, Core::Game *game, ZoneManager &mgr, flo
                 game->setLastBrushTime(currentTime);
             }
 
+            // A new press, or moving onto another face, starts a new undoable stroke
+            if (game->getLastBrushUV().x < 0.0f ||
+                game->getLastBrushObject() != hitObj ||
+                game->getLastBrushFace() != hitFace)
+            {
+                hitObj->saveStrokeState(hitFace);
+            }
+
             // Apply brush based on type
             switch (game->getCurrentBrushType())
             {
@@ -1232,6 +1249,7 @@ std::string Tool::getIcon() const
 
     // Effects Tools
     case Type::Blur:
+    case Type::GaussianBlur:
         return "🌫️";
     case Type::Sharpen:
         return "🔪";
@@ -1342,6 +1360,7 @@ Tool::Category Tool::getCategory() const
         return Category::Transform;
 
     case Type::Blur:
+    case Type::GaussianBlur:
     case Type::Sharpen:
     case Type::Noise:
     case Type::Emboss:
@@ -91,7 +91,10 @@ public:
         Mirror,
         Grid,
         Ruler,
-        Measure
+        Measure,
+
+        // Added after the fact; kept last so saved tool indices stay valid
+        GaussianBlur
     };
 
     Tool(Type type) : type(type) {}
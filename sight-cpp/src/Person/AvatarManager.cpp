@@ -422,7 +422,7 @@ void AvatarManager::loadAvatarState(const std::string& avatarName, const std::st
                         if (part && partsArray[i].contains("dimensions")) {
                             auto dims = partsArray[i]["dimensions"];
                             if (dims.size() >= 3) {
-                                part->getGeometry().setDimensions(glm::vec3(dims[0], dims[1], dims[2]));
+                                part->setDimensions(glm::vec3(dims[0], dims[1], dims[2]));
                             }
                         }
                         if (part && partsArray[i].contains("color")) {
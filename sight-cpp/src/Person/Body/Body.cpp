@@ -256,6 +256,10 @@ void Body::removeBodyPart(const std::string& name) {
         [&name](const BodyPart* part) {
             return part && part->getName() == name;
         });
+    // Removed parts leave the formation and stop following the body
+    for (auto removed = it; removed != parts.end(); ++removed) {
+        formation.removeMember(static_cast<Object*>(*removed));
+    }
     parts.erase(it, parts.end());
 }
 
@@ -310,75 +314,75 @@ Body Body::createCustomAvatar(const std::string& artStyle, BodyType type, Propor
 
     // ----------------------- Torso ----------------------
     auto* torso = new Torso();
-    torso->setTransform(glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.3f, 0.0f)));
+    torso->setLocalTransform(glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.3f, 0.0f)));
     avatar.addPart(torso);
 
     // ----------------------- Chest & Stomach -----------
     auto* chest = new Chest();
-    chest->setTransform(glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.45f, 0.0f)));
+    chest->setLocalTransform(glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.45f, 0.0f)));
     avatar.addPart(chest);
 
     auto* stomach = new Stomach();
-    stomach->setTransform(glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.125f, 0.0f)));
+    stomach->setLocalTransform(glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.125f, 0.0f)));
     avatar.addPart(stomach);
 
     // ----------------------- Neck ----------------------
     auto* neck = new Neck();
-    neck->setTransform(glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.7f, 0.0f)));
+    neck->setLocalTransform(glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.7f, 0.0f)));
     avatar.addPart(neck);
 
     // ----------------------- Shoulders -----------------
     auto* leftShoulder = new Shoulder(Shoulder::Side::Left);
-    leftShoulder->setTransform(glm::translate(glm::mat4(1.0f), glm::vec3(-0.35f, 0.6f, 0.0f)));
+    leftShoulder->setLocalTransform(glm::translate(glm::mat4(1.0f), glm::vec3(-0.35f, 0.6f, 0.0f)));
     avatar.addPart(leftShoulder);
 
     auto* rightShoulder = new Shoulder(Shoulder::Side::Right);
-    rightShoulder->setTransform(glm::translate(glm::mat4(1.0f), glm::vec3(0.35f, 0.6f, 0.0f)));
+    rightShoulder->setLocalTransform(glm::translate(glm::mat4(1.0f), glm::vec3(0.35f, 0.6f, 0.0f)));
     avatar.addPart(rightShoulder);
 
     // ----------------------- Arms -----------------------
     auto* leftArm = new Arm(Arm::Side::Left);
-    leftArm->setTransform(glm::translate(glm::mat4(1.0f), glm::vec3(-0.35f, 0.25f, 0.0f)));
+    leftArm->setLocalTransform(glm::translate(glm::mat4(1.0f), glm::vec3(-0.35f, 0.25f, 0.0f)));
     avatar.addPart(leftArm);
 
     auto* rightArm = new Arm(Arm::Side::Right);
-    rightArm->setTransform(glm::translate(glm::mat4(1.0f), glm::vec3(0.35f, 0.25f, 0.0f)));
+    rightArm->setLocalTransform(glm::translate(glm::mat4(1.0f), glm::vec3(0.35f, 0.25f, 0.0f)));
     avatar.addPart(rightArm);
 
     // -------------------- Forearms ---------------------
     auto* leftForeArm = new ForeArm(ForeArm::Side::Left);
-    leftForeArm->setTransform(glm::translate(glm::mat4(1.0f), glm::vec3(-0.35f, -0.05f, 0.0f)));
+    leftForeArm->setLocalTransform(glm::translate(glm::mat4(1.0f), glm::vec3(-0.35f, -0.05f, 0.0f)));
     avatar.addPart(leftForeArm);
 
     auto* rightForeArm = new ForeArm(ForeArm::Side::Right);
-    rightForeArm->setTransform(glm::translate(glm::mat4(1.0f), glm::vec3(0.35f, -0.05f, 0.0f)));
+    rightForeArm->setLocalTransform(glm::translate(glm::mat4(1.0f), glm::vec3(0.35f, -0.05f, 0.0f)));
     avatar.addPart(rightForeArm);
 
     // ----------------------- Legs -----------------------
     auto* leftLeg = new Leg(Leg::Side::Left);
-    leftLeg->setTransform(glm::translate(glm::mat4(1.0f), glm::vec3(-0.15f, -0.5f, 0.0f)));
+    leftLeg->setLocalTransform(glm::translate(glm::mat4(1.0f), glm::vec3(-0.15f, -0.5f, 0.0f)));
     avatar.addPart(leftLeg);
 
     auto* rightLeg = new Leg(Leg::Side::Right);
-    rightLeg->setTransform(glm::translate(glm::mat4(1.0f), glm::vec3(0.15f, -0.5f, 0.0f)));
+    rightLeg->setLocalTransform(glm::translate(glm::mat4(1.0f), glm::vec3(0.15f, -0.5f, 0.0f)));
     avatar.addPart(rightLeg);
 
     // -------------------- Forelegs ---------------------
     auto* leftForeLeg = new ForeLeg(ForeLeg::Side::Left);
-    leftForeLeg->setTransform(glm::translate(glm::mat4(1.0f), glm::vec3(-0.15f, -0.9f, 0.0f)));
+    leftForeLeg->setLocalTransform(glm::translate(glm::mat4(1.0f), glm::vec3(-0.15f, -0.9f, 0.0f)));
     avatar.addPart(leftForeLeg);
 
     auto* rightForeLeg = new ForeLeg(ForeLeg::Side::Right);
-    rightForeLeg->setTransform(glm::translate(glm::mat4(1.0f), glm::vec3(0.15f, -0.9f, 0.0f)));
+    rightForeLeg->setLocalTransform(glm::translate(glm::mat4(1.0f), glm::vec3(0.15f, -0.9f, 0.0f)));
     avatar.addPart(rightForeLeg);
 
     // ----------------------- Feet ----------------------
     auto* leftFoot = new Foot(Foot::Side::Left);
-    leftFoot->setTransform(glm::translate(glm::mat4(1.0f), glm::vec3(-0.15f, -1.15f, 0.1f)));
+    leftFoot->setLocalTransform(glm::translate(glm::mat4(1.0f), glm::vec3(-0.15f, -1.15f, 0.1f)));
     avatar.addPart(leftFoot);
 
     auto* rightFoot = new Foot(Foot::Side::Right);
-    rightFoot->setTransform(glm::translate(glm::mat4(1.0f), glm::vec3(0.15f, -1.15f, 0.1f)));
+    rightFoot->setLocalTransform(glm::translate(glm::mat4(1.0f), glm::vec3(0.15f, -1.15f, 0.1f)));
     avatar.addPart(rightFoot);
 
     // Apply customizations
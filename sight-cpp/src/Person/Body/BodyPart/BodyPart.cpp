@@ -10,6 +10,7 @@ BodyPart::BodyPart(const std::string& name, Type type, const Form& form)
     isSymbolic = false;
     _localTransform = glm::mat4(1.0f);
     setTransform(_localTransform);
+    TransformGraph::instance().setCallback(transformNode(), [this](const glm::mat4& world) { BodyPart::setTransform(world); });
     
     // Set default health based on part type
     switch (type) {
@@ -47,14 +48,23 @@ BodyPart::BodyPart(const std::string& name, Type type, const Form& form)
 
 BodyPart::BodyPart(const std::string& name, Type type, const Form& form, const glm::mat4& initialTransform)
     : BodyPart(name, type, form) {
-    _localTransform = initialTransform;
+    setLocalTransform(initialTransform);
     setTransform(initialTransform);
 }
 
+BodyPart::~BodyPart() {
+    TransformGraph::instance().setCallback(transformNode(), nullptr);
+}
+
+void BodyPart::setLocalTransform(const glm::mat4& t) {
+    _localTransform = t;
+    Formations::setLocalTransform(t);
+}
+
 void BodyPart::draw() const {
-    // Apply this part's transform then draw its geometry
+    // Apply this part's cached world transform then draw its geometry
     glPushMatrix();
-    glMultMatrixf(&transform[0][0]);
+    glMultMatrixf(&hot().transform[0][0]);
     glColor3f(color[0],color[1],color[2]);
     geometry.draw();
     glPopMatrix();
@@ -70,17 +80,14 @@ void BodyPart::update(float deltaTime) {
     // (Could add effect processing here)
 }
 
-void BodyPart::setTransform(const glm::mat4& t) {
-    // Store base transform
-    Object::setTransform(t);
-    static const glm::mat4 I(1.0f);
-    if (_localTransform == I) {
-        _localTransform = t;
-    }
+void BodyPart::setDimensions(const glm::vec3& dims) {
+    geometry.setDimensions(dims);
+    invalidateBounds();
+}
 
-    // Build a matrix that includes the geometry scale (since updateCollisionZone assumes unit cube)
-    glm::mat4 scaled = t * glm::scale(glm::mat4(1.0f), geometry.getDimensions());
-    updateCollisionZone(scaled);
+// The collision box follows the visual scale (the local box is a unit cube)
+glm::mat4 BodyPart::collisionTransform() const {
+    return getTransform() * glm::scale(glm::mat4(1.0f), geometry.getDimensions());
 }
 
 void BodyPart::setHealth(float h) {
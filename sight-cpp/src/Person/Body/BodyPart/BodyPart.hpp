@@ -5,6 +5,7 @@
 #include "Form/Object/Object.hpp"
 #include "Form/Object/Formation/Formations.hpp"
 #include "Form/Form.hpp"
+#include "Form/TransformGraph.hpp"
 #include <glm/glm.hpp>
 
 class BodyPart : public Object, public Formations {
@@ -32,6 +33,10 @@ class BodyPart : public Object, public Formations {
 
     BodyPart(const std::string& name = "", Type type = Type::Undefined, const Form& form = Form());
     BodyPart(const std::string& name, Type type, const Form& form, const glm::mat4& initialTransform);
+    ~BodyPart() override;
+    // The transform node's callback points at this part
+    BodyPart(BodyPart&&) = delete;
+    BodyPart& operator=(BodyPart&&) = delete;
 
     void draw() const;
     void update(float deltaTime);
@@ -43,17 +48,23 @@ class BodyPart : public Object, public Formations {
     // A literal body part is an actual limb or organ. Have a constant updater that always sets these variables to the opposite of each other.
     bool isLiteral, isSymbolic = true;
 
-    // Override to ensure collision box follows visual scale
-    void setTransform(const glm::mat4& t) override;
-    void setLocalTransform(const glm::mat4& t) { _localTransform = t; setTransform(t); }
+    // setTransform sets the world transform directly. A part attached to a
+    // body gets it recomputed from its local transform whenever the body moves.
+    // Transform relative to the owning body; takes effect on the next
+    // TransformGraph::update(). The node is the part's Formations node, which
+    // the body's formation parents when the part is added.
+    void setLocalTransform(const glm::mat4& t);
+    using Formations::transformNode;
 
     // Color accessor
     void setColor(float r,float g,float b){color[0]=r;color[1]=g;color[2]=b;}
     const float* getColor() const {return color;}
 
-    // Geometry accessor for editor
+    // Geometry accessor for editor. Resize through setDimensions so the
+    // collision box follows.
     Form&       getGeometry()       { return geometry; }
     const Form& getGeometry() const { return geometry; }
+    void setDimensions(const glm::vec3& dims);
 
     const glm::mat4& localTransform() const {return _localTransform;}
 
@@ -107,4 +118,6 @@ class BodyPart : public Object, public Formations {
     
     // Update color based on health
     void updateColor();
+
+    glm::mat4 collisionTransform() const override;
 };
\ No newline at end of file
@@ -4,7 +4,7 @@
 #include <cmath>
 #include <GLFW/glfw3.h>
 #include <OpenGL/glu.h>
-#include "Form/Object/Formation/Menu/stb_easy_font.h"
+#include "Rendering/TextRenderer.hpp"
 #include "ZonesOfEarth/ZoneManager.hpp"
 #include "ZonesOfEarth/Zone/Zone.hpp"
 #include <glm/gtc/matrix_transform.hpp>
@@ -152,7 +152,7 @@ void Person::draw() const {
 }
 
 // ---------------------------------------------------------------------------------
-//  Render a simple nametag above the player's head using stb_easy_font
+//  Queue a nametag above the player's head; Game flushes all nametags in one pass
 // ---------------------------------------------------------------------------------
 void Person::drawNametag() const {
     // Offset above the head where the nametag should appear (world space)
@@ -173,51 +173,15 @@ void Person::drawNametag() const {
     // Skip if projected behind camera
     if (winZ < 0.0 || winZ > 1.0) return;
 
-    // Convert Y to top-left origin expected by stb_easy_font
+    // Convert Y to the top-left origin of the 2D overlay pass
     winY = viewport[3] - winY;
 
-    // Prepare string buffer
-    char buf[6000];
-    std::string line = soulName;
-    int quads = stb_easy_font_print(static_cast<float>(winX), static_cast<float>(winY),
-                                    const_cast<char*>(line.c_str()), nullptr,
-                                    buf, sizeof(buf));
-
-    // Render in 2D overlay
-    glPushAttrib(GL_ENABLE_BIT | GL_COLOR_BUFFER_BIT);
-    glDisable(GL_DEPTH_TEST);
-
-    glMatrixMode(GL_PROJECTION);
-    glPushMatrix();
-    glLoadIdentity();
-    glOrtho(0, viewport[2], viewport[3], 0, -1, 1);
-
-    glMatrixMode(GL_MODELVIEW);
-    glPushMatrix();
-    glLoadIdentity();
-
-    glColor3f(1.0f, 1.0f, 1.0f);
-    glEnableClientState(GL_VERTEX_ARRAY);
-    glVertexPointer(2, GL_FLOAT, 16, buf);
-    glDrawArrays(GL_QUADS, 0, quads * 4);
-    glDisableClientState(GL_VERTEX_ARRAY);
-
-    // Restore matrices and state
-    glPopMatrix();
-    glMatrixMode(GL_PROJECTION);
-    glPopMatrix();
-    glMatrixMode(GL_MODELVIEW);
-    glPopAttrib();
+    TextRenderer::instance().queue(soulName, static_cast<float>(winX), static_cast<float>(winY), glm::vec3(1.0f));
 }
 
 // -----------------------------------------------------------------------------
 void Person::updatePose() {
-    glm::mat4 base = glm::translate(glm::mat4(1.0f), position);
-    for (auto* part : body.parts) {
-        if (!part) continue;
-        glm::mat4 worldT = base * part->localTransform();
-        part->setTransform(worldT);
-    }
+    body.formation.setLocalTransform(glm::translate(glm::mat4(1.0f), position));
 }
 
 void Person::update(float deltaTime) {
@@ -106,8 +106,12 @@ public:
     void togglePhysics() { physicsEnabled = !physicsEnabled; }
     bool isPhysicsEnabled() const { return physicsEnabled; }
 
-    // Update all body part world transforms based on current position
+    // Move the pose root (the body's formation node, which every body part
+    // hangs from) to `position`. Only marks transforms dirty; world matrices
+    // are recomputed by the next TransformGraph::update(), so calling this
+    // repeatedly in a frame is cheap.
     void updatePose();
+    TransformNode poseRoot() const { return body.formation.transformNode(); }
 
     // Avatar State Management
     void updateState(float deltaTime);
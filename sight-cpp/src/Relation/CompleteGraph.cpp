@@ -0,0 +1,114 @@
+#include "CompleteGraph.hpp"
+
+void CompleteGraph::addMember(const std::string& entity) {
+    ++_members[entity];
+}
+
+void CompleteGraph::removeMember(const std::string& entity) {
+    auto it = _members.find(entity);
+    if (it == _members.end()) return;
+    if (--it->second > 0) return;
+    _members.erase(it);
+    pruneOverridesOf(entity);
+}
+
+void CompleteGraph::assignMembers(const std::vector<std::string>& entities) {
+    std::unordered_map<std::string, uint32_t> next;
+    next.reserve(entities.size());
+    for (const auto& entity : entities) ++next[entity];
+    for (const auto& member : _members) {
+        if (!next.count(member.first)) pruneOverridesOf(member.first);
+    }
+    _members.swap(next);
+}
+
+void CompleteGraph::clear() {
+    _members.clear();
+    _overrides.clear();
+}
+
+void CompleteGraph::pruneOverridesOf(const std::string& entity) {
+    if (_overrides.degreeOf(entity) == 0) return;
+    std::vector<std::string> others;
+    for (const Relation& r : _overrides.getRelationsOf(entity)) {
+        others.push_back(r.entityA == entity ? r.entityB : r.entityA);
+    }
+    for (const auto& other : others) _overrides.removeBetween(entity, other, _type);
+}
+
+// -----------------------------------------------------------------------------
+// Queries
+// -----------------------------------------------------------------------------
+bool CompleteGraph::areRelated(const std::string& a, const std::string& b) const {
+    return a != b && isMember(a) && isMember(b);
+}
+
+size_t CompleteGraph::degreeOf(const std::string& entity) const {
+    return isMember(entity) ? _members.size() - 1 : 0;
+}
+
+float CompleteGraph::weightBetween(const std::string& a, const std::string& b) const {
+    if (!areRelated(a, b)) return 0.0f;
+    const Relation* edge = _overrides.find(_type, a, b);
+    return edge ? edge->weight : _defaultWeight;
+}
+
+Relation CompleteGraph::relationBetween(const std::string& a, const std::string& b) const {
+    if (const Relation* edge = _overrides.find(_type, a, b)) return *edge;
+    return Relation(_type, a, b, false, areRelated(a, b) ? _defaultWeight : 0.0f);
+}
+
+// -----------------------------------------------------------------------------
+// Overrides
+// -----------------------------------------------------------------------------
+bool CompleteGraph::setEdgeWeight(const std::string& a, const std::string& b, float weight) {
+    if (!areRelated(a, b)) return false;
+    if (!_overrides.setWeight(_type, a, b, false, weight)) {
+        _overrides.add(Relation(_type, a, b, false, weight));
+    }
+    return true;
+}
+
+bool CompleteGraph::recordInteraction(const std::string& a, const std::string& b, float deltaWeight) {
+    if (!areRelated(a, b)) return false;
+    if (_overrides.find(_type, a, b)) {
+        _overrides.add(Relation(_type, a, b, false, deltaWeight));
+        return true;
+    }
+    // First interaction: create the override with this one event, then lift
+    // it to the default weight plus the delta
+    _overrides.add(Relation(_type, a, b, false, deltaWeight));
+    _overrides.setWeight(_type, a, b, false, _defaultWeight + deltaWeight);
+    return true;
+}
+
+bool CompleteGraph::clearOverride(const std::string& a, const std::string& b) {
+    return _overrides.removeBetween(a, b, _type);
+}
+
+// -----------------------------------------------------------------------------
+// (De)Serialization
+// -----------------------------------------------------------------------------
+nlohmann::json CompleteGraph::toJson() const {
+    nlohmann::json members = nlohmann::json::array();
+    for (const auto& member : _members) {
+        for (uint32_t i = 0; i < member.second; ++i) members.push_back(member.first);
+    }
+    return nlohmann::json{{"type", _type},
+                          {"defaultWeight", _defaultWeight},
+                          {"members", members},
+                          {"overrides", _overrides.toJson()}};
+}
+
+void CompleteGraph::loadFromJson(const nlohmann::json& j) {
+    clear();
+    if (!j.is_object()) return;
+    _type = j.value("type", _type);
+    _defaultWeight = j.value("defaultWeight", _defaultWeight);
+    if (j.contains("members") && j["members"].is_array()) {
+        for (const auto& item : j["members"]) {
+            if (item.is_string()) addMember(item.get<std::string>());
+        }
+    }
+    if (j.contains("overrides")) _overrides.loadFromJson(j["overrides"]);
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "Relation.hpp"
+#include "RelationManager.hpp"
+#include "json.hpp"
+
+// Implicit "every member is related to every other member" relation class.
+//
+// Adjacency, degree and between-queries are answered from the membership set
+// alone, so a formation of n members costs O(n) instead of n(n-1)/2 stored
+// relations. Only edges that differ from the default – a custom weight or a
+// recorded interaction – are stored explicitly, as undirected relations of
+// the graph's type in an ordinary RelationManager.
+class CompleteGraph {
+public:
+    explicit CompleteGraph(std::string type = "member", float defaultWeight = 1.0f)
+        : _type(std::move(type)), _defaultWeight(defaultWeight) {}
+
+    // Membership ---------------------------------------------------------
+    // Members are counted, so the same name may be added more than once and
+    // stays a member until removed as often.
+    void addMember(const std::string& entity);
+    void removeMember(const std::string& entity);
+    // Replace the membership; overrides on edges that no longer exist are dropped
+    void assignMembers(const std::vector<std::string>& entities);
+    void clear();
+
+    bool isMember(const std::string& entity) const { return _members.count(entity) != 0; }
+    size_t memberCount() const { return _members.size(); }
+    size_t edgeCount() const { return _members.size() * (_members.size() - (_members.empty() ? 0 : 1)) / 2; }
+
+    // Queries --------------------------------------------------------------
+    bool areRelated(const std::string& a, const std::string& b) const;
+    size_t degreeOf(const std::string& entity) const;
+    float weightBetween(const std::string& a, const std::string& b) const;
+
+    // Calls fn(const std::string& neighbour) for every other member
+    template <typename Fn>
+    void forEachNeighbour(const std::string& entity, Fn&& fn) const {
+        if (!isMember(entity)) return;
+        for (const auto& member : _members) {
+            if (member.first != entity) fn(member.first);
+        }
+    }
+
+    // The edge as a Relation value (the override if there is one)
+    Relation relationBetween(const std::string& a, const std::string& b) const;
+
+    // Per-edge overrides -------------------------------------------------
+    // Both return false if the two entities are not related
+    bool setEdgeWeight(const std::string& a, const std::string& b, float weight);
+    // Accumulates `deltaWeight` on the edge and records it on its timeline
+    bool recordInteraction(const std::string& a, const std::string& b, float deltaWeight = 1.0f);
+    bool clearOverride(const std::string& a, const std::string& b);
+
+    const RelationManager& overrides() const { return _overrides; }
+    const std::string& type() const { return _type; }
+    float defaultWeight() const { return _defaultWeight; }
+
+    // (De)Serialization --------------------------------------------------
+    nlohmann::json toJson() const;
+    void loadFromJson(const nlohmann::json& j);
+
+private:
+    void pruneOverridesOf(const std::string& entity);
+
+    std::string _type;
+    float _defaultWeight;
+    std::unordered_map<std::string, uint32_t> _members;   // name -> times added
+    RelationManager _overrides;
+};
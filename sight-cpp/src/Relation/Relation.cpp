@@ -37,15 +37,11 @@ bool Relation::isBetween(const std::string& a, const std::string& b) const {
 }
 
 json Relation::toJson() const {
-    json evArr = json::array();
-    for(const auto& ev : events) evArr.push_back(ev.toJson());
-
     return json{{"type", type},
                 {"entityA", entityA},
                 {"entityB", entityB},
                 {"directed", directed},
-                {"weight", weight},
-                {"events", evArr}};
+                {"weight", weight}};
 }
 
 Relation Relation::fromJson(const json& j) {
@@ -55,12 +51,6 @@ Relation Relation::fromJson(const json& j) {
     r.entityB = j.at("entityB").get<std::string>();
     r.directed = j.value("directed", false);
     r.weight = j.value("weight", 1.0f);
-
-    if(j.contains("events") && j["events"].is_array()){
-        for(const auto& item : j["events"]) {
-            r.events.push_back(RelationEvent::fromJson(item));
-        }
-    }
     return r;
 }
 
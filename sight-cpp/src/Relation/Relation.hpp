@@ -5,7 +5,7 @@
 #include <vector>
 #include <ctime>
 
-// Forward declare for JSON definitions later
+// One interaction that influenced a relation (see RelationTimeline)
 struct RelationEvent {
     std::time_t timestamp{0};
     std::string description;
@@ -87,8 +87,6 @@ public:
     bool directed = false;
     float weight = 1.0f;
 
-    // Timeline of interaction events that influenced this relation
-    std::vector<RelationEvent> events;
-
-    void addEvent(const RelationEvent& e) { events.push_back(e); }
+    // The timeline of interaction events lives in the owning RelationManager
+    // (see RelationTimeline), keeping this type small and cheap to copy.
 };
@@ -0,0 +1,318 @@
+#include "RelationGraph.hpp"
+#include "RelationManager.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <queue>
+#include "Util/WorkerPool.hpp"
+
+namespace {
+
+// Run fn(begin, end) over [0, count) on the shared worker pool. Work
+// smaller than `grain` stays on the calling thread.
+template <typename Fn>
+void parallelFor(size_t count, size_t grain, Fn&& fn) {
+    WorkerPool::instance().parallelFor(count, grain, fn);
+}
+
+constexpr size_t ParallelGrain = 4096;
+
+std::vector<RelationEdge> captureEdges(const RelationManager& manager) {
+    const auto& keys = manager.getKeys();
+    const auto& relations = manager.getAll();
+    std::vector<RelationEdge> edges(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        edges[i] = RelationEdge{keys[i].a, keys[i].b, relations[i].weight, keys[i].directed, static_cast<uint32_t>(i)};
+    }
+    return edges;
+}
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+// Construction
+// -----------------------------------------------------------------------------
+std::shared_ptr<const RelationGraph> RelationGraph::build(const RelationManager& manager) {
+    return build(captureEdges(manager), manager.getSymbolNames(), manager.version());
+}
+
+std::shared_ptr<const RelationGraph> RelationGraph::build(std::vector<RelationEdge> edges,
+                                                          const std::vector<std::string>& symbolNames,
+                                                          uint64_t sourceVersion) {
+    std::shared_ptr<RelationGraph> graph(new RelationGraph());
+    graph->_sourceVersion = sourceVersion;
+
+    // Only entities that take part in a relation become nodes
+    std::vector<NodeId> nodeOf(symbolNames.size(), NoNode);
+    auto nodeFor = [&](uint32_t symbol) {
+        if (nodeOf[symbol] == NoNode) {
+            nodeOf[symbol] = static_cast<NodeId>(graph->_names.size());
+            graph->_names.push_back(symbolNames[symbol]);
+        }
+        return nodeOf[symbol];
+    };
+    for (auto& e : edges) {
+        e.a = nodeFor(e.a);
+        e.b = nodeFor(e.b);
+    }
+    const size_t n = graph->_names.size();
+    graph->_nodeIds.reserve(n);
+    for (NodeId i = 0; i < n; ++i) graph->_nodeIds.emplace(graph->_names[i], i);
+
+    // Counting sort of edges by source node
+    graph->_offsets.assign(n + 1, 0);
+    for (const auto& e : edges) {
+        ++graph->_offsets[e.a + 1];
+        if (!e.directed && e.a != e.b) ++graph->_offsets[e.b + 1];
+    }
+    for (size_t i = 0; i < n; ++i) graph->_offsets[i + 1] += graph->_offsets[i];
+    const size_t m = graph->_offsets[n];
+    graph->_targets.resize(m);
+    graph->_weights.resize(m);
+    graph->_slots.resize(m);
+    std::vector<uint32_t> cursor(graph->_offsets.begin(), graph->_offsets.end() - 1);
+    auto place = [&](NodeId from, NodeId to, const RelationEdge& e) {
+        uint32_t at = cursor[from]++;
+        graph->_targets[at] = to;
+        graph->_weights[at] = e.weight;
+        graph->_slots[at] = e.slot;
+    };
+    for (const auto& e : edges) {
+        place(e.a, e.b, e);
+        if (!e.directed && e.a != e.b) place(e.b, e.a, e);
+    }
+
+    // Transpose for incoming edges, plus per-node outgoing weight
+    graph->_inOffsets.assign(n + 1, 0);
+    for (NodeId t : graph->_targets) ++graph->_inOffsets[t + 1];
+    for (size_t i = 0; i < n; ++i) graph->_inOffsets[i + 1] += graph->_inOffsets[i];
+    graph->_inSources.resize(m);
+    graph->_inWeights.resize(m);
+    graph->_outWeight.assign(n, 0.0);
+    cursor.assign(graph->_inOffsets.begin(), graph->_inOffsets.end() - 1);
+    for (NodeId u = 0; u < n; ++u) {
+        for (uint32_t i = graph->_offsets[u]; i < graph->_offsets[u + 1]; ++i) {
+            float w = std::max(0.0f, graph->_weights[i]);
+            uint32_t at = cursor[graph->_targets[i]]++;
+            graph->_inSources[at] = u;
+            graph->_inWeights[at] = w;
+            graph->_outWeight[u] += w;
+        }
+    }
+    return graph;
+}
+
+RelationGraph::NodeId RelationGraph::findNode(const std::string& entity) const {
+    auto it = _nodeIds.find(entity);
+    return it != _nodeIds.end() ? it->second : NoNode;
+}
+
+// -----------------------------------------------------------------------------
+// Traversal
+// -----------------------------------------------------------------------------
+// Level-synchronous BFS: each frontier is expanded in parallel, claiming
+// nodes with a CAS on their distance so every node is visited once.
+std::vector<int32_t> RelationGraph::bfs(NodeId source, uint32_t maxDepth) const {
+    const size_t n = nodeCount();
+    std::vector<int32_t> result(n, -1);
+    if (source >= n) return result;
+
+    std::unique_ptr<std::atomic<int32_t>[]> dist(new std::atomic<int32_t>[n]);
+    for (size_t i = 0; i < n; ++i) dist[i].store(-1, std::memory_order_relaxed);
+    dist[source].store(0, std::memory_order_relaxed);
+
+    std::vector<NodeId> frontier{source};
+    std::mutex mergeMutex;
+    for (uint32_t level = 0; !frontier.empty() && level < maxDepth; ++level) {
+        std::vector<NodeId> next;
+        const int32_t nextLevel = static_cast<int32_t>(level + 1);
+        parallelFor(frontier.size(), ParallelGrain / 16, [&](size_t begin, size_t end) {
+            std::vector<NodeId> local;
+            for (size_t f = begin; f < end; ++f) {
+                NodeId u = frontier[f];
+                for (const NodeId* v = neighboursBegin(u); v != neighboursEnd(u); ++v) {
+                    int32_t unvisited = -1;
+                    if (dist[*v].compare_exchange_strong(unvisited, nextLevel, std::memory_order_relaxed)) {
+                        local.push_back(*v);
+                    }
+                }
+            }
+            std::lock_guard<std::mutex> lock(mergeMutex);
+            next.insert(next.end(), local.begin(), local.end());
+        });
+        frontier.swap(next);
+    }
+
+    for (size_t i = 0; i < n; ++i) result[i] = dist[i].load(std::memory_order_relaxed);
+    return result;
+}
+
+std::vector<RelationGraph::NodeId> RelationGraph::kHop(NodeId source, uint32_t k) const {
+    std::vector<NodeId> nodes;
+    std::vector<int32_t> dist = bfs(source, k);
+    for (NodeId i = 0; i < dist.size(); ++i) {
+        if (dist[i] > 0) nodes.push_back(i);
+    }
+    return nodes;
+}
+
+// Lock-free union-find: roots are only ever linked to a smaller root, so the
+// final root of every component is its smallest node.
+std::vector<RelationGraph::NodeId> RelationGraph::connectedComponents(size_t* count) const {
+    const size_t n = nodeCount();
+    std::unique_ptr<std::atomic<NodeId>[]> parent(new std::atomic<NodeId>[n]);
+    for (NodeId i = 0; i < n; ++i) parent[i].store(i, std::memory_order_relaxed);
+
+    auto find = [&](NodeId x) {
+        NodeId p = parent[x].load(std::memory_order_acquire);
+        while (p != x) {
+            x = p;
+            p = parent[x].load(std::memory_order_acquire);
+        }
+        return x;
+    };
+
+    parallelFor(n, ParallelGrain, [&](size_t begin, size_t end) {
+        for (size_t u = begin; u < end; ++u) {
+            for (const NodeId* v = neighboursBegin(static_cast<NodeId>(u)); v != neighboursEnd(static_cast<NodeId>(u)); ++v) {
+                while (true) {
+                    NodeId ru = find(static_cast<NodeId>(u));
+                    NodeId rv = find(*v);
+                    if (ru == rv) break;
+                    if (ru < rv) std::swap(ru, rv);
+                    NodeId expected = ru;
+                    if (parent[ru].compare_exchange_strong(expected, rv, std::memory_order_acq_rel)) break;
+                }
+            }
+        }
+    });
+
+    std::vector<NodeId> labels(n);
+    std::atomic<size_t> components{0};
+    parallelFor(n, ParallelGrain, [&](size_t begin, size_t end) {
+        size_t local = 0;
+        for (size_t i = begin; i < end; ++i) {
+            labels[i] = find(static_cast<NodeId>(i));
+            if (labels[i] == i) ++local;
+        }
+        components.fetch_add(local, std::memory_order_relaxed);
+    });
+    if (count) *count = components.load();
+    return labels;
+}
+
+// -----------------------------------------------------------------------------
+// Ranking / paths
+// -----------------------------------------------------------------------------
+std::vector<double> RelationGraph::pageRank(double damping, uint32_t maxIterations, double tolerance) const {
+    const size_t n = nodeCount();
+    if (n == 0) return {};
+    std::vector<double> rank(n, 1.0 / n);
+    std::vector<double> next(n, 0.0);
+
+    for (uint32_t iter = 0; iter < maxIterations; ++iter) {
+        double dangling = 0.0;
+        for (size_t u = 0; u < n; ++u) {
+            if (_outWeight[u] <= 0.0) dangling += rank[u];
+        }
+        const double base = (1.0 - damping) / n + damping * dangling / n;
+
+        std::mutex deltaMutex;
+        double delta = 0.0;
+        // Pull from incoming edges so each thread writes only its own nodes
+        parallelFor(n, ParallelGrain, [&](size_t begin, size_t end) {
+            double localDelta = 0.0;
+            for (size_t v = begin; v < end; ++v) {
+                double sum = 0.0;
+                for (uint32_t i = _inOffsets[v]; i < _inOffsets[v + 1]; ++i) {
+                    NodeId u = _inSources[i];
+                    if (_outWeight[u] > 0.0) sum += rank[u] * _inWeights[i] / _outWeight[u];
+                }
+                next[v] = base + damping * sum;
+                localDelta += std::abs(next[v] - rank[v]);
+            }
+            std::lock_guard<std::mutex> lock(deltaMutex);
+            delta += localDelta;
+        });
+        rank.swap(next);
+        if (delta < tolerance) break;
+    }
+    return rank;
+}
+
+std::vector<float> RelationGraph::dijkstra(NodeId source, std::vector<NodeId>* previous) const {
+    const size_t n = nodeCount();
+    std::vector<float> dist(n, std::numeric_limits<float>::infinity());
+    if (previous) previous->assign(n, NoNode);
+    if (source >= n) return dist;
+
+    using Item = std::pair<float, NodeId>;
+    std::priority_queue<Item, std::vector<Item>, std::greater<Item>> open;
+    dist[source] = 0.0f;
+    open.push({0.0f, source});
+    while (!open.empty()) {
+        auto [d, u] = open.top();
+        open.pop();
+        if (d > dist[u]) continue;
+        const float* w = weightsBegin(u);
+        for (const NodeId* v = neighboursBegin(u); v != neighboursEnd(u); ++v, ++w) {
+            if (*w <= 0.0f) continue;
+            float nd = d + 1.0f / *w;
+            if (nd < dist[*v]) {
+                dist[*v] = nd;
+                if (previous) (*previous)[*v] = u;
+                open.push({nd, *v});
+            }
+        }
+    }
+    return dist;
+}
+
+std::vector<RelationGraph::NodeId> RelationGraph::shortestPath(NodeId source, NodeId target) const {
+    std::vector<NodeId> previous;
+    std::vector<float> dist = dijkstra(source, &previous);
+    std::vector<NodeId> path;
+    if (target >= dist.size() || std::isinf(dist[target])) return path;
+    for (NodeId at = target; at != NoNode; at = previous[at]) path.push_back(at);
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+// -----------------------------------------------------------------------------
+// Cache
+// -----------------------------------------------------------------------------
+void RelationGraphCache::collectFinished() {
+    if (_hasPending && _pending.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        _current = _pending.get();
+        _hasPending = false;
+    }
+}
+
+std::shared_ptr<const RelationGraph> RelationGraphCache::get(const RelationManager& manager) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    collectFinished();
+    const uint64_t version = manager.version();
+    if (_current && _current->sourceVersion() == version) return _current;
+    // One rebuild at a time; a build for an older version still finishes and
+    // the next call starts another
+    if (!_hasPending) {
+        _pending = std::async(std::launch::async,
+                              [edges = captureEdges(manager), names = manager.getSymbolNames(), version]() mutable {
+                                  return RelationGraph::build(std::move(edges), names, version);
+                              });
+        _hasPending = true;
+    }
+    return _current;
+}
+
+std::shared_ptr<const RelationGraph> RelationGraphCache::getBlocking(const RelationManager& manager) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_hasPending) {
+        _current = _pending.get();
+        _hasPending = false;
+    }
+    if (!_current || _current->sourceVersion() != manager.version()) {
+        _current = RelationGraph::build(manager);
+    }
+    return _current;
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <memory>
+#include <future>
+#include <mutex>
+#include <cstdint>
+#include <limits>
+
+class RelationManager;
+
+// Endpoints and weight of one relation, as copied out of a RelationManager
+struct RelationEdge {
+    uint32_t a = 0;            // symbol IDs in the source manager
+    uint32_t b = 0;
+    float weight = 1.0f;
+    bool directed = false;
+    uint32_t slot = 0;         // index of the relation in RelationManager::getAll()
+};
+
+// Immutable compressed-sparse-row snapshot of a relation network.
+//
+// Nodes are the entities that appear in at least one relation, numbered
+// densely. Undirected relations become an edge in each direction; directed
+// ones only A -> B. Relations of every type are merged, so parallel edges
+// between two nodes are possible. A snapshot never changes after it is built,
+// so any number of threads may query it while the simulation keeps mutating
+// the manager it came from.
+//
+// Analytics that touch the whole graph split work across threads.
+class RelationGraph {
+public:
+    using NodeId = uint32_t;
+    static constexpr NodeId NoNode = std::numeric_limits<NodeId>::max();
+
+    // Synchronous build; O(V + E)
+    static std::shared_ptr<const RelationGraph> build(const RelationManager& manager);
+    // Build from edges captured earlier (see RelationGraphCache)
+    static std::shared_ptr<const RelationGraph> build(std::vector<RelationEdge> edges,
+                                                      const std::vector<std::string>& symbolNames,
+                                                      uint64_t sourceVersion);
+
+    size_t nodeCount() const { return _names.size(); }
+    size_t edgeCount() const { return _targets.size(); }
+    // RelationManager::version() the snapshot was taken at
+    uint64_t sourceVersion() const { return _sourceVersion; }
+
+    NodeId findNode(const std::string& entity) const;
+    const std::string& nodeName(NodeId node) const { return _names[node]; }
+
+    // Outgoing edges of a node: targets, weights and relation slots run in parallel
+    size_t outDegree(NodeId node) const { return _offsets[node + 1] - _offsets[node]; }
+    const NodeId* neighboursBegin(NodeId node) const { return _targets.data() + _offsets[node]; }
+    const NodeId* neighboursEnd(NodeId node) const { return _targets.data() + _offsets[node + 1]; }
+    const float* weightsBegin(NodeId node) const { return _weights.data() + _offsets[node]; }
+    const uint32_t* slotsBegin(NodeId node) const { return _slots.data() + _offsets[node]; }
+
+    // Analytics ----------------------------------------------------------
+    // Hop count from `source` to every node (-1 if unreachable or beyond maxDepth)
+    std::vector<int32_t> bfs(NodeId source, uint32_t maxDepth = std::numeric_limits<uint32_t>::max()) const;
+    // Nodes within k hops of `source`, excluding the source itself
+    std::vector<NodeId> kHop(NodeId source, uint32_t k) const;
+
+    // Weakly connected components: label per node (the smallest NodeId in the
+    // component); the number of components is written to `count` if given
+    std::vector<NodeId> connectedComponents(size_t* count = nullptr) const;
+
+    // Weighted PageRank. Each node splits its rank over its out-edges in
+    // proportion to their weight; dangling nodes spread theirs evenly.
+    std::vector<double> pageRank(double damping = 0.85, uint32_t maxIterations = 50, double tolerance = 1e-6) const;
+
+    // Single-source shortest paths. An edge costs 1 / weight, so strong
+    // relations are short; edges with weight <= 0 are not traversed.
+    // `previous` (optional) receives the predecessor of each node on its path.
+    std::vector<float> dijkstra(NodeId source, std::vector<NodeId>* previous = nullptr) const;
+    // Node sequence from source to target; empty if unreachable
+    std::vector<NodeId> shortestPath(NodeId source, NodeId target) const;
+
+private:
+    RelationGraph() = default;
+
+    std::vector<std::string> _names;        // node -> entity name
+    std::unordered_map<std::string, NodeId> _nodeIds;
+    std::vector<uint32_t> _offsets;         // node -> first out-edge (size nodeCount + 1)
+    std::vector<NodeId> _targets;
+    std::vector<float> _weights;
+    std::vector<uint32_t> _slots;
+    // Transposed (incoming) adjacency, used by PageRank's pull step
+    std::vector<uint32_t> _inOffsets;
+    std::vector<NodeId> _inSources;
+    std::vector<float> _inWeights;
+    std::vector<double> _outWeight;         // total out-edge weight per node
+    uint64_t _sourceVersion = 0;
+};
+
+// Keeps a snapshot of one RelationManager current without blocking the
+// simulation. The caller copies the edge list (a flat O(E) copy) on its own
+// thread; CSR construction then runs in the background while the previous
+// snapshot keeps serving queries.
+class RelationGraphCache {
+public:
+    // Latest finished snapshot (possibly stale, or null before the first
+    // build). Starts a background rebuild if the manager has changed since.
+    std::shared_ptr<const RelationGraph> get(const RelationManager& manager);
+    // Snapshot matching the manager's current version, building it if needed
+    std::shared_ptr<const RelationGraph> getBlocking(const RelationManager& manager);
+
+private:
+    void collectFinished();
+
+    std::mutex _mutex;
+    std::shared_ptr<const RelationGraph> _current;
+    std::future<std::shared_ptr<const RelationGraph>> _pending;
+    bool _hasPending = false;
+};
@@ -0,0 +1,463 @@
+#include "RelationGraphFile.hpp"
+#include "RelationManager.hpp"
+#include <algorithm>
+#include <numeric>
+#include <fstream>
+#include <cstddef>
+#include <cstring>
+#include <cstdio>
+#include <unordered_map>
+#if defined(_WIN32)
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr char Magic[8] = {'E', 'A', 'R', 'T', 'H', 'R', 'E', 'L'};
+constexpr uint32_t FormatVersion = 2;
+constexpr uint32_t NoString = 0xFFFFFFFFu;
+constexpr uint64_t FnvBasis = 0xCBF29CE484222325ull;
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+constexpr bool HostIsLittleEndian = false;
+#else
+constexpr bool HostIsLittleEndian = true;
+#endif
+
+// Host <-> little-endian; the same swap both ways
+template <typename T>
+T littleEndian(T value) {
+    if (HostIsLittleEndian) return value;
+    unsigned char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    std::reverse(bytes, bytes + sizeof(T));
+    std::memcpy(&value, bytes, sizeof(T));
+    return value;
+}
+
+uint64_t fnv1a(const uint8_t* data, size_t size, uint64_t hash = FnvBasis) {
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= data[i];
+        hash *= 0x100000001B3ull;
+    }
+    return hash;
+}
+
+// Append raw bytes at the next 8-byte boundary; returns their offset
+uint64_t appendSection(std::vector<uint8_t>& out, const void* data, size_t bytes) {
+    out.resize((out.size() + 7) & ~size_t(7), 0);
+    uint64_t offset = out.size();
+    if (bytes) {
+        out.resize(out.size() + bytes);
+        std::memcpy(out.data() + offset, data, bytes);
+    }
+    return offset;
+}
+
+template <typename T>
+uint64_t appendColumn(std::vector<uint8_t>& out, const std::vector<T>& column) {
+    if (HostIsLittleEndian || sizeof(T) == 1) return appendSection(out, column.data(), column.size() * sizeof(T));
+    std::vector<T> swapped(column.size());
+    std::transform(column.begin(), column.end(), swapped.begin(), littleEndian<T>);
+    return appendSection(out, swapped.data(), swapped.size() * sizeof(T));
+}
+
+} // namespace
+
+// Applies littleEndian to every numeric field (magic is bytes already)
+template <typename Header>
+static void swapHeader(Header& h) {
+    h.formatVersion = littleEndian(h.formatVersion);
+    h.reserved = littleEndian(h.reserved);
+    uint64_t* fields[] = {
+        &h.stringCount, &h.relationCount, &h.stringOffsets, &h.stringData, &h.typeColumn, &h.aColumn,
+        &h.bColumn, &h.weightColumn, &h.directedColumn, &h.csrOffsets, &h.recentOffsets, &h.bucketOffsets,
+        &h.timelineSpan, &h.timelineTotal, &h.recentTime, &h.recentDesc, &h.recentDelta, &h.bucketEvents,
+        &h.bucketFirst, &h.bucketLast, &h.bucketWeight, &h.fileSize, &h.checksum,
+    };
+    for (uint64_t* field : fields) *field = littleEndian(*field);
+}
+
+template <typename T>
+T RelationGraphFile::at(uint64_t offset, uint64_t index) const {
+    T value;
+    std::memcpy(&value, _data + offset + index * sizeof(T), sizeof(T));
+    return littleEndian(value);
+}
+
+RelationGraphFile::~RelationGraphFile() {
+    close();
+}
+
+// -----------------------------------------------------------------------------
+// Writing
+// -----------------------------------------------------------------------------
+bool RelationGraphFile::write(const RelationManager& manager, const std::string& path) {
+    const auto& relations = manager.relations;
+    const auto& keys = manager._keys;
+    const RelationTimeline& timeline = manager._timeline;
+    const size_t count = relations.size();
+
+    // One sorted string table for symbols and event descriptions
+    std::vector<std::string> strings = manager._symbolNames;
+    strings.insert(strings.end(), timeline._descriptions.begin(), timeline._descriptions.end());
+    std::sort(strings.begin(), strings.end());
+    strings.erase(std::unique(strings.begin(), strings.end()), strings.end());
+    std::unordered_map<std::string, uint32_t> stringIds;
+    stringIds.reserve(strings.size());
+    for (uint32_t i = 0; i < strings.size(); ++i) stringIds.emplace(strings[i], i);
+
+    std::vector<uint32_t> symbolToString(manager._symbolNames.size());
+    for (size_t i = 0; i < symbolToString.size(); ++i) symbolToString[i] = stringIds[manager._symbolNames[i]];
+    std::vector<uint32_t> descToString(timeline._descriptions.size());
+    for (size_t i = 0; i < descToString.size(); ++i) descToString[i] = stringIds[timeline._descriptions[i]];
+
+    // File order: by the A endpoint's string ID, so the CSR can index it.
+    // (Keys store undirected endpoints in ID order; the relation keeps the
+    // caller's order, which is what gets written.)
+    std::vector<uint32_t> aOf(count), bOf(count);
+    for (size_t i = 0; i < count; ++i) {
+        const bool swapped = !keys[i].directed && relations[i].entityA != manager._symbolNames[keys[i].a];
+        aOf[i] = symbolToString[swapped ? keys[i].b : keys[i].a];
+        bOf[i] = symbolToString[swapped ? keys[i].a : keys[i].b];
+    }
+    std::vector<uint32_t> order(count);
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t x, uint32_t y) { return aOf[x] < aOf[y]; });
+
+    std::vector<uint64_t> stringOffsets(strings.size() + 1, 0);
+    std::string stringData;
+    for (size_t i = 0; i < strings.size(); ++i) {
+        stringData += strings[i];
+        stringOffsets[i + 1] = stringData.size();
+    }
+
+    std::vector<uint32_t> typeCol(count), aCol(count), bCol(count);
+    std::vector<float> weightCol(count);
+    std::vector<uint8_t> directedCol(count);
+    std::vector<uint32_t> csr(strings.size() + 1, 0);
+    // Timelines are variable-length blocks indexed like the CSR: only the
+    // events and buckets a relation actually holds are written
+    std::vector<uint32_t> recentOffsets(count + 1, 0), bucketOffsets(count + 1, 0);
+    std::vector<int64_t> span(count);
+    std::vector<uint64_t> total(count);
+    std::vector<int64_t> recentTime, bucketFirst, bucketLast;
+    std::vector<uint32_t> recentDesc, bucketEvents;
+    std::vector<float> recentDelta, bucketWeight;
+
+    for (size_t i = 0; i < count; ++i) {
+        const uint32_t slot = order[i];
+        const Relation& r = relations[slot];
+        typeCol[i] = symbolToString[keys[slot].type];
+        aCol[i] = aOf[slot];
+        bCol[i] = bOf[slot];
+        weightCol[i] = r.weight;
+        directedCol[i] = r.directed ? 1 : 0;
+        ++csr[aCol[i] + 1];
+
+        span[i] = static_cast<int64_t>(timeline._bucketSpan[slot]);
+        total[i] = timeline._totalCount[slot];
+        // Recent ring unrolled oldest first
+        const uint32_t used = timeline._recentCount[slot];
+        for (uint32_t k = 0; k < used; ++k) {
+            size_t from = timeline.recentCell(slot, k);
+            recentTime.push_back(static_cast<int64_t>(timeline._recentTime[from]));
+            recentDesc.push_back(descToString[timeline._recentDesc[from]]);
+            recentDelta.push_back(timeline._recentDelta[from]);
+        }
+        recentOffsets[i + 1] = recentOffsets[i] + used;
+        const uint32_t buckets = timeline._bucketCount[slot];
+        for (uint32_t k = 0; k < buckets; ++k) {
+            size_t from = timeline.bucketCell(slot, k);
+            bucketEvents.push_back(timeline._bucketEvents[from]);
+            bucketFirst.push_back(static_cast<int64_t>(timeline._bucketFirst[from]));
+            bucketLast.push_back(static_cast<int64_t>(timeline._bucketLast[from]));
+            bucketWeight.push_back(timeline._bucketWeight[from]);
+        }
+        bucketOffsets[i + 1] = bucketOffsets[i] + buckets;
+    }
+    for (size_t s = 0; s < strings.size(); ++s) csr[s + 1] += csr[s];
+
+    std::vector<uint8_t> out(sizeof(Header), 0);
+    Header h{};
+    std::memcpy(h.magic, Magic, sizeof(Magic));
+    h.formatVersion = FormatVersion;
+    h.stringCount = strings.size();
+    h.relationCount = count;
+    h.stringOffsets = appendColumn(out, stringOffsets);
+    h.stringData = appendSection(out, stringData.data(), stringData.size());
+    h.typeColumn = appendColumn(out, typeCol);
+    h.aColumn = appendColumn(out, aCol);
+    h.bColumn = appendColumn(out, bCol);
+    h.weightColumn = appendColumn(out, weightCol);
+    h.directedColumn = appendColumn(out, directedCol);
+    h.csrOffsets = appendColumn(out, csr);
+    h.recentOffsets = appendColumn(out, recentOffsets);
+    h.bucketOffsets = appendColumn(out, bucketOffsets);
+    h.timelineSpan = appendColumn(out, span);
+    h.timelineTotal = appendColumn(out, total);
+    h.recentTime = appendColumn(out, recentTime);
+    h.recentDesc = appendColumn(out, recentDesc);
+    h.recentDelta = appendColumn(out, recentDelta);
+    h.bucketEvents = appendColumn(out, bucketEvents);
+    h.bucketFirst = appendColumn(out, bucketFirst);
+    h.bucketLast = appendColumn(out, bucketLast);
+    h.bucketWeight = appendColumn(out, bucketWeight);
+    out.resize((out.size() + 7) & ~size_t(7), 0);
+    h.fileSize = out.size();
+    // Checksum the little-endian header with a zero checksum field, then
+    // patch the field in
+    swapHeader(h);
+    std::memcpy(out.data(), &h, sizeof(Header));
+    const uint64_t checksum = littleEndian(fnv1a(out.data(), out.size()));
+    std::memcpy(out.data() + offsetof(Header, checksum), &checksum, sizeof(checksum));
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        printf("RelationGraphFile: cannot write %s\n", path.c_str());
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(out.data()), static_cast<std::streamsize>(out.size()));
+    return static_cast<bool>(file);
+}
+
+// -----------------------------------------------------------------------------
+// Opening
+// -----------------------------------------------------------------------------
+bool RelationGraphFile::open(const std::string& path, bool verifyChecksum) {
+    close();
+#if defined(_WIN32)
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        printf("RelationGraphFile: cannot open %s\n", path.c_str());
+        return false;
+    }
+    _buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    _data = _buffer.data();
+    _size = _buffer.size();
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        printf("RelationGraphFile: cannot open %s\n", path.c_str());
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(Header))) {
+        ::close(fd);
+        printf("RelationGraphFile: %s is too small\n", path.c_str());
+        return false;
+    }
+    void* mapped = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        printf("RelationGraphFile: cannot map %s\n", path.c_str());
+        return false;
+    }
+    _data = static_cast<const uint8_t*>(mapped);
+    _size = static_cast<size_t>(st.st_size);
+    _mapped = true;
+#endif
+
+    auto fail = [&](const char* why) {
+        printf("RelationGraphFile: %s: %s\n", path.c_str(), why);
+        close();
+        return false;
+    };
+    if (_size < sizeof(Header)) return fail("too small");
+    std::memcpy(&_header, _data, sizeof(Header));
+    swapHeader(_header);
+    const Header& h = _header;
+    if (std::memcmp(h.magic, Magic, sizeof(Magic)) != 0) return fail("not a relation graph file");
+    if (h.formatVersion != FormatVersion) return fail("unsupported format version");
+    if (h.fileSize != _size) return fail("truncated");
+
+    if (verifyChecksum) {
+        Header zeroed;
+        std::memcpy(&zeroed, _data, sizeof(Header));
+        zeroed.checksum = 0;
+        uint64_t hash = fnv1a(reinterpret_cast<const uint8_t*>(&zeroed), sizeof(Header));
+        if (fnv1a(_data + sizeof(Header), _size - sizeof(Header), hash) != h.checksum) return fail("checksum mismatch");
+    }
+    // Structure is checked even without the checksum: the lazy accessors
+    // index with these offsets unchecked
+    std::string why;
+    if (!validate(why)) return fail(why.c_str());
+    return true;
+}
+
+bool RelationGraphFile::validate(std::string& why) const {
+    const Header& h = _header;
+    auto reject = [&](const char* reason) {
+        why = reason;
+        return false;
+    };
+    // Each string needs an 8-byte offset and each relation at least 4 bytes
+    // per column, so larger counts cannot be genuine; this also keeps the
+    // size arithmetic below from overflowing
+    const uint64_t S = h.stringCount, R = h.relationCount;
+    if (S >= _size / 8 || R >= _size / 4) return reject("counts exceed file size");
+
+    auto inside = [&](uint64_t offset, uint64_t bytes) {
+        return offset >= sizeof(Header) && offset % 8 == 0 && offset <= _size && bytes <= _size - offset;
+    };
+    const std::pair<uint64_t, uint64_t> fixed[] = {
+        {h.stringOffsets, (S + 1) * 8}, {h.typeColumn, R * 4}, {h.aColumn, R * 4}, {h.bColumn, R * 4},
+        {h.weightColumn, R * 4}, {h.directedColumn, R}, {h.csrOffsets, (S + 1) * 4},
+        {h.recentOffsets, (R + 1) * 4}, {h.bucketOffsets, (R + 1) * 4},
+        {h.timelineSpan, R * 8}, {h.timelineTotal, R * 8},
+    };
+    for (const auto& s : fixed) {
+        if (!inside(s.first, s.second)) return reject("section out of bounds");
+    }
+
+    // Offset tables start at zero and never decrease, so every
+    // `next - current` is a valid length
+    auto monotonic = [&](auto zero, uint64_t offset, uint64_t entries) {
+        using T = decltype(zero);
+        if (at<T>(offset, 0) != 0) return false;
+        for (uint64_t i = 1; i < entries; ++i) {
+            if (at<T>(offset, i) < at<T>(offset, i - 1)) return false;
+        }
+        return true;
+    };
+    if (!monotonic(uint64_t(0), h.stringOffsets, S + 1)) return reject("string offsets out of order");
+    if (!monotonic(uint32_t(0), h.csrOffsets, S + 1)) return reject("edge index out of order");
+    if (!monotonic(uint32_t(0), h.recentOffsets, R + 1)) return reject("event offsets out of order");
+    if (!monotonic(uint32_t(0), h.bucketOffsets, R + 1)) return reject("bucket offsets out of order");
+    if (h.stringData > _size || at<uint64_t>(h.stringOffsets, S) > _size - h.stringData)
+        return reject("string table out of bounds");
+    if (at<uint32_t>(h.csrOffsets, S) != R) return reject("edge index does not match relation count");
+
+    const uint64_t E = at<uint32_t>(h.recentOffsets, R);
+    const uint64_t Bk = at<uint32_t>(h.bucketOffsets, R);
+    const std::pair<uint64_t, uint64_t> blocks[] = {
+        {h.recentTime, E * 8}, {h.recentDesc, E * 4}, {h.recentDelta, E * 4},
+        {h.bucketEvents, Bk * 4}, {h.bucketFirst, Bk * 8}, {h.bucketLast, Bk * 8}, {h.bucketWeight, Bk * 4},
+    };
+    for (const auto& s : blocks) {
+        if (!inside(s.first, s.second)) return reject("timeline block out of bounds");
+    }
+
+    // String IDs in range, and each relation inside its A endpoint's CSR run
+    uint32_t a = 0;
+    for (uint64_t i = 0; i < R; ++i) {
+        if (at<uint32_t>(h.typeColumn, i) >= S || at<uint32_t>(h.aColumn, i) >= S || at<uint32_t>(h.bColumn, i) >= S)
+            return reject("string ID out of range");
+        while (at<uint32_t>(h.csrOffsets, a + 1) <= i) ++a;
+        if (at<uint32_t>(h.aColumn, i) != a) return reject("relation outside its edge index run");
+    }
+    for (uint64_t e = 0; e < E; ++e) {
+        if (at<uint32_t>(h.recentDesc, e) >= S) return reject("event description out of range");
+    }
+    return true;
+}
+
+void RelationGraphFile::close() {
+#if !defined(_WIN32)
+    if (_data && _mapped) munmap(const_cast<uint8_t*>(_data), _size);
+#endif
+    _data = nullptr;
+    _header = Header{};
+    _size = 0;
+    _mapped = false;
+    _buffer.clear();
+}
+
+// -----------------------------------------------------------------------------
+// Lazy access
+// -----------------------------------------------------------------------------
+size_t RelationGraphFile::stringCount() const {
+    return _data ? header().stringCount : 0;
+}
+
+size_t RelationGraphFile::relationCount() const {
+    return _data ? header().relationCount : 0;
+}
+
+std::string_view RelationGraphFile::stringAt(uint32_t id) const {
+    if (id >= stringCount()) return std::string_view();
+    const uint64_t begin = at<uint64_t>(header().stringOffsets, id);
+    const uint64_t end = at<uint64_t>(header().stringOffsets, id + 1);
+    return std::string_view(reinterpret_cast<const char*>(_data + header().stringData + begin), end - begin);
+}
+
+uint32_t RelationGraphFile::findString(std::string_view text) const {
+    uint32_t lo = 0, hi = static_cast<uint32_t>(stringCount());
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (stringAt(mid) < text) lo = mid + 1; else hi = mid;
+    }
+    return lo < stringCount() && stringAt(lo) == text ? lo : NoString;
+}
+
+Relation RelationGraphFile::relationAt(size_t index) const {
+    const Header& h = header();
+    return Relation(std::string(stringAt(at<uint32_t>(h.typeColumn, index))),
+                    std::string(stringAt(at<uint32_t>(h.aColumn, index))),
+                    std::string(stringAt(at<uint32_t>(h.bColumn, index))),
+                    at<uint8_t>(h.directedColumn, index) != 0,
+                    at<float>(h.weightColumn, index));
+}
+
+std::pair<uint32_t, uint32_t> RelationGraphFile::relationsFrom(std::string_view entity) const {
+    uint32_t id = findString(entity);
+    if (id == NoString) return {0, 0};
+    return {at<uint32_t>(header().csrOffsets, id), at<uint32_t>(header().csrOffsets, id + 1)};
+}
+
+// -----------------------------------------------------------------------------
+// Materialization
+// -----------------------------------------------------------------------------
+bool RelationGraphFile::materialize(RelationManager& manager) const {
+    if (!_data) return false;
+    constexpr uint32_t K = RelationTimeline::RecentCapacity;
+    const Header& h = header();
+
+    manager.clear();
+    RelationTimeline& timeline = manager._timeline;
+    std::vector<uint32_t> descIds(h.stringCount, NoString);
+
+    for (size_t i = 0; i < h.relationCount; ++i) {
+        Relation r = relationAt(i);
+        RelationKey key = manager.keyFor(r);
+        if (manager._index.count(key)) continue; // corrupt duplicate; keep the first
+        const uint32_t slot = manager.insertIndexed(std::move(r), key);
+
+        timeline._bucketSpan[slot] = std::max<std::time_t>(1, static_cast<std::time_t>(at<int64_t>(h.timelineSpan, i)));
+        const uint32_t bucketEnd = at<uint32_t>(h.bucketOffsets, i + 1);
+        for (uint32_t k = at<uint32_t>(h.bucketOffsets, i); k < bucketEnd; ++k) {
+            timeline.appendBucket(slot, TimelineBucket{at<uint32_t>(h.bucketEvents, k),
+                                                       static_cast<std::time_t>(at<int64_t>(h.bucketFirst, k)),
+                                                       static_cast<std::time_t>(at<int64_t>(h.bucketLast, k)),
+                                                       at<float>(h.bucketWeight, k)});
+        }
+
+        // Events are stored oldest first; any beyond this build's ring
+        // capacity fold into buckets exactly as record() would have
+        const uint32_t first = at<uint32_t>(h.recentOffsets, i), last = at<uint32_t>(h.recentOffsets, i + 1);
+        const uint32_t kept = std::min(last - first, K);
+        for (uint32_t e = first; e < last; ++e) {
+            const auto t = static_cast<std::time_t>(at<int64_t>(h.recentTime, e));
+            const float delta = at<float>(h.recentDelta, e);
+            if (e < last - kept) {
+                timeline.foldIntoBuckets(slot, t, delta);
+                continue;
+            }
+            const uint32_t desc = at<uint32_t>(h.recentDesc, e);   // validated by open()
+            if (descIds[desc] == NoString) descIds[desc] = timeline.internDescription(std::string(stringAt(desc)));
+            timeline.pushRecent(slot, t, descIds[desc], delta);
+        }
+        timeline._totalCount[slot] = at<uint64_t>(h.timelineTotal, i);
+    }
+    return true;
+}
+
+bool RelationGraphFile::load(RelationManager& manager, const std::string& path) {
+    RelationGraphFile file;
+    return file.open(path) && file.materialize(manager);
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+#include "Relation.hpp"
+
+class RelationManager;
+
+// Compact binary file for a RelationManager and its event timelines.
+//
+// Layout (little-endian, every section 8-byte aligned):
+//   Header      magic, format version, counts, section offsets, checksum
+//   Strings     sorted table of every entity, type and event description:
+//               uint64 offsets[count + 1] followed by the bytes
+//   Relations   columns type/a/b (string IDs), weight, directed, sorted by a
+//   CSR         uint32 offsets[stringCount + 1] into the relation columns,
+//               so the relations whose A endpoint is string s are
+//               [csr[s], csr[s + 1])
+//   Timelines   per-relation bucket span and event total, then the recent
+//               events (oldest first) and buckets each relation actually
+//               holds, packed and indexed by uint32 offsets[relationCount + 1]
+//
+// The checksum is FNV-1a 64 over the whole file, taken with the checksum
+// field zeroed.
+//
+// Opening maps the file read-only and validates its structure (section
+// bounds, monotonic offsets, string IDs in range) whether or not the checksum
+// is verified; nothing else is parsed until asked for. Individual relations
+// can be read straight from the mapping, or the whole file materialized back
+// into a RelationManager.
+class RelationGraphFile {
+public:
+    RelationGraphFile() = default;
+    ~RelationGraphFile();
+    RelationGraphFile(const RelationGraphFile&) = delete;
+    RelationGraphFile& operator=(const RelationGraphFile&) = delete;
+
+    // Returns false (and logs why) if the file could not be written
+    static bool write(const RelationManager& manager, const std::string& path);
+
+    // Map and validate a file. `verifyChecksum` reads every page once; skip it
+    // for a faster open when the file is trusted.
+    bool open(const std::string& path, bool verifyChecksum = true);
+    void close();
+    bool isOpen() const { return _data != nullptr; }
+
+    // Lazy access --------------------------------------------------------
+    size_t stringCount() const;
+    size_t relationCount() const;
+    std::string_view stringAt(uint32_t id) const;
+    // Binary search of the sorted string table; UINT32_MAX if absent
+    uint32_t findString(std::string_view text) const;
+
+    Relation relationAt(size_t index) const;
+    // Index range of the relations stored with `entity` as their A endpoint
+    std::pair<uint32_t, uint32_t> relationsFrom(std::string_view entity) const;
+
+    // Replace the manager's contents (relations and timelines) with the file's
+    bool materialize(RelationManager& manager) const;
+
+    // One-shot helper: open, verify and materialize
+    static bool load(RelationManager& manager, const std::string& path);
+
+private:
+    struct Header {
+        char magic[8];
+        uint32_t formatVersion;
+        uint32_t reserved;
+        uint64_t stringCount;
+        uint64_t relationCount;
+        uint64_t stringOffsets;
+        uint64_t stringData;
+        uint64_t typeColumn;
+        uint64_t aColumn;
+        uint64_t bColumn;
+        uint64_t weightColumn;
+        uint64_t directedColumn;
+        uint64_t csrOffsets;
+        uint64_t recentOffsets;
+        uint64_t bucketOffsets;
+        uint64_t timelineSpan;
+        uint64_t timelineTotal;
+        uint64_t recentTime;
+        uint64_t recentDesc;
+        uint64_t recentDelta;
+        uint64_t bucketEvents;
+        uint64_t bucketFirst;
+        uint64_t bucketLast;
+        uint64_t bucketWeight;
+        uint64_t fileSize;
+        uint64_t checksum;
+    };
+    const Header& header() const { return _header; }
+    // Element `index` of the little-endian column at `offset`
+    template <typename T>
+    T at(uint64_t offset, uint64_t index) const;
+    bool validate(std::string& why) const;
+
+    Header _header{};                     // host-order copy of the file's header
+    const uint8_t* _data = nullptr;
+    size_t _size = 0;
+    bool _mapped = false;                 // false when read into _buffer instead
+    std::vector<uint8_t> _buffer;
+};
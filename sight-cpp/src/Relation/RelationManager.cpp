@@ -1,5 +1,6 @@
 #include "RelationManager.hpp"
 #include <algorithm>
+#include <functional>
 
 // Event structure for when a new Relation is created
 struct RelationCreatedEvent {
@@ -10,99 +11,221 @@ struct RelationCreatedEvent {
         : relation(r), timestamp(std::time(nullptr)) {}
 };
 
-void RelationManager::add(const Relation& r) {
-    // Check if an equivalent relation already exists (same type & endpoints)
-    auto it = std::find_if(relations.begin(), relations.end(), [&](const Relation& other) {
-        bool sameType = other.type == r.type;
-        bool sameDir  = other.directed == r.directed;
+// -----------------------------------------------------------------------------
+// Views
+// -----------------------------------------------------------------------------
+bool RelationManager::RelationView::accepts(uint32_t index) const {
+    if (!_filtered) return true;
+    const RelationKey& k = (*_keys)[index];
+    if (k.directed) return k.a == _a && k.b == _b;
+    return k.a == std::min(_a, _b) && k.b == std::max(_a, _b);
+}
 
-        if (!sameType || !sameDir) return false;
+size_t RelationManager::RelationView::size() const {
+    if (!_filtered) return static_cast<size_t>(_end - _begin);
+    return static_cast<size_t>(std::distance(begin(), end()));
+}
 
-        if (r.directed) {
-            // Directed: order matters
-            return other.entityA == r.entityA && other.entityB == r.entityB;
-        }
-        // Undirected: order independent
-        bool matchForward  = other.entityA == r.entityA && other.entityB == r.entityB;
-        bool matchBackward = other.entityA == r.entityB && other.entityB == r.entityA;
-        return matchForward || matchBackward;
-    });
-
-    if (it != relations.end()) {
-        // Existing relation – append an event capturing this interaction
-        RelationEvent ev;
-        ev.timestamp    = std::time(nullptr);
-        ev.description  = r.type;
-        ev.deltaWeight  = r.weight;
-        it->addEvent(ev);
+// -----------------------------------------------------------------------------
+// Interning / indexing
+// -----------------------------------------------------------------------------
+uint32_t RelationManager::internSymbol(const std::string& name) {
+    auto it = _symbolIds.find(name);
+    if (it != _symbolIds.end()) return it->second;
+    uint32_t id = static_cast<uint32_t>(_adjacency.size());
+    _symbolIds.emplace(name, id);
+    _symbolNames.push_back(name);
+    _adjacency.emplace_back();
+    return id;
+}
+
+uint32_t RelationManager::findSymbol(const std::string& name) const {
+    auto it = _symbolIds.find(name);
+    return it != _symbolIds.end() ? it->second : NoSymbol;
+}
+
+RelationKey RelationManager::keyFor(const Relation& r) {
+    RelationKey key{internSymbol(r.type), internSymbol(r.entityA), internSymbol(r.entityB), r.directed};
+    if (!key.directed && key.b < key.a) std::swap(key.a, key.b);
+    return key;
+}
+
+bool RelationManager::lookupKey(const std::string& type, const std::string& a, const std::string& b, bool directed, RelationKey& key) const {
+    key = RelationKey{findSymbol(type), findSymbol(a), findSymbol(b), directed};
+    if (key.type == NoSymbol || key.a == NoSymbol || key.b == NoSymbol) return false;
+    if (!directed && key.b < key.a) std::swap(key.a, key.b);
+    return true;
+}
+
+uint32_t RelationManager::insertIndexed(Relation&& r, const RelationKey& key) {
+    uint32_t index = static_cast<uint32_t>(relations.size());
+    ++_version;
+    relations.push_back(std::move(r));
+    _keys.push_back(key);
+    _index.emplace(key, index);
+    _timeline.appendSlot();
+    _adjacency[key.a].push_back(index);
+    if (key.b != key.a) _adjacency[key.b].push_back(index);
+    return index;
+}
+
+// Swap-and-pop: the last relation moves into `index` and its index entries follow
+void RelationManager::eraseAt(uint32_t index) {
+    auto unlink = [this](uint32_t entity, uint32_t slot) {
+        auto& adj = _adjacency[entity];
+        auto it = std::find(adj.begin(), adj.end(), slot);
+        if (it != adj.end()) { *it = adj.back(); adj.pop_back(); }
+    };
+    auto relink = [this](uint32_t entity, uint32_t from, uint32_t to) {
+        auto& adj = _adjacency[entity];
+        auto it = std::find(adj.begin(), adj.end(), from);
+        if (it != adj.end()) *it = to;
+    };
+
+    const RelationKey key = _keys[index];
+    ++_version;
+    _index.erase(key);
+    unlink(key.a, index);
+    if (key.b != key.a) unlink(key.b, index);
+
+    uint32_t last = static_cast<uint32_t>(relations.size() - 1);
+    if (index != last) {
+        const RelationKey moved = _keys[last];
+        relations[index] = std::move(relations[last]);
+        _keys[index] = moved;
+        _index[moved] = index;
+        relink(moved.a, last, index);
+        if (moved.b != moved.a) relink(moved.b, last, index);
+    }
+    relations.pop_back();
+    _keys.pop_back();
+    _timeline.eraseSlot(index);
+}
+
+// -----------------------------------------------------------------------------
+// Mutation
+// -----------------------------------------------------------------------------
+void RelationManager::add(const Relation& r) {
+    RelationKey key = keyFor(r);
+    auto it = _index.find(key);
+    if (it != _index.end()) {
+        // Existing relation – record an event capturing this interaction
+        _timeline.record(it->second, std::time(nullptr), r.type, r.weight);
 
         // Optional: update aggregate weight (could use running average, etc.)
-        it->weight += r.weight;
-    } else {
-        // New relation – copy and create initial event
-        Relation newRel = r;
-        RelationEvent ev{std::time(nullptr), r.type, r.weight};
-        newRel.events.push_back(ev);
-        relations.push_back(std::move(newRel));
-        
-        // Trigger event for new relation creation
-        RelationCreatedEvent event(newRel);
-        Core::EventBus::instance().publish(event);
+        relations[it->second].weight += r.weight;
+        ++_version;
+        return;
     }
+
+    // New relation – copy and create initial event
+    uint32_t index = insertIndexed(Relation(r), key);
+    _timeline.record(index, std::time(nullptr), r.type, r.weight);
+
+    // Trigger event for new relation creation
+    RelationCreatedEvent event(relations[index]);
+    Core::EventBus::instance().publish(event);
+}
+
+bool RelationManager::setWeight(const std::string& type, const std::string& a, const std::string& b, bool directed, float weight) {
+    RelationKey key;
+    if (!lookupKey(type, a, b, directed, key)) return false;
+    auto it = _index.find(key);
+    if (it == _index.end()) return false;
+    relations[it->second].weight = weight;
+    ++_version;
+    return true;
 }
 
 bool RelationManager::remove(const Relation& r) {
-    auto it = std::find_if(relations.begin(), relations.end(), [&](const Relation& other) {
-        return other.type == r.type &&
-               other.entityA == r.entityA &&
-               other.entityB == r.entityB &&
-               other.directed == r.directed;
-    });
-    if (it != relations.end()) {
-        relations.erase(it);
-        return true;
-    }
-    return false;
+    RelationKey key;
+    if (!lookupKey(r.type, r.entityA, r.entityB, r.directed, key)) return false;
+    auto it = _index.find(key);
+    if (it == _index.end()) return false;
+    eraseAt(it->second);
+    return true;
 }
 
 bool RelationManager::removeBetween(const std::string& a, const std::string& b, const std::string& type) {
-    auto oldSize = relations.size();
-    relations.erase(std::remove_if(relations.begin(), relations.end(), [&](const Relation& r) {
-        bool matchesEntities = r.isBetween(a, b);
-        bool matchesType = type.empty() || r.type == type;
-        return matchesEntities && matchesType;
-    }), relations.end());
-    return relations.size() != oldSize;
-}
-
-std::vector<Relation> RelationManager::getRelationsOf(const std::string& entity) const {
-    std::vector<Relation> result;
-    for (const auto& r : relations) {
-        if (r.involves(entity)) result.push_back(r);
+    std::vector<uint32_t> doomed;
+    for (const Relation& r : getRelationsBetween(a, b)) {
+        if (type.empty() || r.type == type) doomed.push_back(static_cast<uint32_t>(&r - relations.data()));
     }
-    return result;
+    // Highest slot first so swap-and-pop never moves a relation still to be erased
+    std::sort(doomed.begin(), doomed.end(), std::greater<uint32_t>());
+    for (uint32_t index : doomed) eraseAt(index);
+    return !doomed.empty();
 }
 
-std::vector<Relation> RelationManager::getRelationsBetween(const std::string& a, const std::string& b) const {
-    std::vector<Relation> result;
-    for (const auto& r : relations) {
-        if (r.isBetween(a, b)) result.push_back(r);
-    }
-    return result;
+void RelationManager::clear() {
+    relations.clear();
+    _keys.clear();
+    _symbolIds.clear();
+    _symbolNames.clear();
+    ++_version;
+    _adjacency.clear();
+    _index.clear();
+    _timeline.clear();
+}
+
+// -----------------------------------------------------------------------------
+// Queries
+// -----------------------------------------------------------------------------
+RelationManager::RelationView RelationManager::getRelationsOf(const std::string& entity) const {
+    uint32_t id = findSymbol(entity);
+    if (id == NoSymbol) return RelationView();
+    const auto& adj = _adjacency[id];
+    return RelationView(this, adj.data(), adj.data() + adj.size());
+}
+
+RelationManager::RelationView RelationManager::getRelationsBetween(const std::string& a, const std::string& b) const {
+    uint32_t idA = findSymbol(a);
+    uint32_t idB = findSymbol(b);
+    if (idA == NoSymbol || idB == NoSymbol) return RelationView();
+    // Walk whichever endpoint has fewer relations
+    const auto& adj = _adjacency[idA].size() <= _adjacency[idB].size() ? _adjacency[idA] : _adjacency[idB];
+    RelationView view(this, adj.data(), adj.data() + adj.size());
+    view._filtered = true;
+    view._a = idA;
+    view._b = idB;
+    return view;
+}
+
+const Relation* RelationManager::find(const std::string& type, const std::string& a, const std::string& b, bool directed) const {
+    RelationKey key;
+    if (!lookupKey(type, a, b, directed, key)) return nullptr;
+    auto it = _index.find(key);
+    return it != _index.end() ? &relations[it->second] : nullptr;
+}
+
+size_t RelationManager::degreeOf(const std::string& entity) const {
+    uint32_t id = findSymbol(entity);
+    return id == NoSymbol ? 0 : _adjacency[id].size();
 }
 
 nlohmann::json RelationManager::toJson() const {
     nlohmann::json arr = nlohmann::json::array();
-    for (const auto& r : relations) {
-        arr.push_back(r.toJson());
+    for (size_t i = 0; i < relations.size(); ++i) {
+        nlohmann::json item = relations[i].toJson();
+        _timeline.toJson(static_cast<uint32_t>(i), item);
+        arr.push_back(std::move(item));
     }
     return arr;
 }
 
 void RelationManager::loadFromJson(const nlohmann::json& j) {
-    relations.clear();
+    clear();
     if (!j.is_array()) return;
     for (const auto& item : j) {
-        relations.push_back(Relation::fromJson(item));
+        Relation r = Relation::fromJson(item);
+        RelationKey key = keyFor(r);
+        auto it = _index.find(key);
+        if (it == _index.end()) {
+            _timeline.loadJson(insertIndexed(std::move(r), key), item);
+            continue;
+        }
+        // Older saves could hold duplicates; fold them into one relation
+        relations[it->second].weight += r.weight;
+        _timeline.loadJson(it->second, item);
     }
-} 
\ No newline at end of file
+}
@@ -2,21 +2,109 @@
 
 #include <vector>
 #include <string>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+#include <iterator>
 #include "Relation.hpp"
+#include "RelationTimeline.hpp"
 #include "json.hpp"
 #include "Core/EventBus.hpp"
 
 // Forward declaration for the event
 struct RelationCreatedEvent;
 
+// Interned identity of a relation. Undirected relations store their endpoints
+// in ascending ID order so both orientations share one key.
+struct RelationKey {
+    uint32_t type = 0;
+    uint32_t a = 0;
+    uint32_t b = 0;
+    bool directed = false;
+
+    bool operator==(const RelationKey& other) const {
+        return type == other.type && a == other.a && b == other.b && directed == other.directed;
+    }
+};
+
+struct RelationKeyHash {
+    size_t operator()(const RelationKey& k) const {
+        uint64_t h = (static_cast<uint64_t>(k.a) << 32 | k.b) * 0x9E3779B97F4A7C15ull;
+        return static_cast<size_t>(h ^ (static_cast<uint64_t>(k.type) << 1 | (k.directed ? 1u : 0u)) * 0xC2B2AE3D27D4EB4Full);
+    }
+};
+
 // Centralized container/utility class for working with collections of Relation
 // objects. This abstraction makes it easy to add/remove/query relations,
 // as well as serialize the entire relation graph to JSON for persistence.
+//
+// Entity names and relation types are interned to small integer IDs. Each
+// relation is indexed by (type, a, b, directed) for O(1) de-duplication, and
+// every entity keeps an adjacency list of the relations touching it, so
+// queries cost O(degree) instead of a scan of the whole graph.
 class RelationManager {
 public:
-    // Add a new relation to the set (no duplicate checks for now).
+    // Non-owning range over relations returned by the query helpers. It reads
+    // the manager's storage directly, so it is invalidated by add/remove/load.
+    class RelationView {
+    public:
+        class iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = Relation;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const Relation*;
+            using reference = const Relation&;
+
+            const Relation& operator*() const { return (*_view->_relations)[*_pos]; }
+            const Relation* operator->() const { return &**this; }
+            iterator& operator++() { ++_pos; skip(); return *this; }
+            bool operator==(const iterator& other) const { return _pos == other._pos; }
+            bool operator!=(const iterator& other) const { return _pos != other._pos; }
+
+        private:
+            friend class RelationView;
+            iterator(const RelationView* view, const uint32_t* pos) : _view(view), _pos(pos) { skip(); }
+            void skip() { while (_pos != _view->_end && !_view->accepts(*_pos)) ++_pos; }
+
+            const RelationView* _view;
+            const uint32_t* _pos;
+        };
+
+        RelationView() = default;
+
+        iterator begin() const { return iterator(this, _begin); }
+        iterator end() const { return iterator(this, _end); }
+        bool empty() const { return begin() == end(); }
+        // O(n) when the view is filtered
+        size_t size() const;
+
+    private:
+        friend class RelationManager;
+        RelationView(const RelationManager* owner, const uint32_t* first, const uint32_t* last)
+            : _relations(&owner->relations), _keys(&owner->_keys), _begin(first), _end(last) {}
+
+        bool accepts(uint32_t index) const;
+
+        const std::vector<Relation>* _relations = nullptr;
+        const std::vector<RelationKey>* _keys = nullptr;
+        const uint32_t* _begin = nullptr;
+        const uint32_t* _end = nullptr;
+        // When filtering, only relations between these two entity IDs pass
+        bool _filtered = false;
+        uint32_t _a = 0;
+        uint32_t _b = 0;
+    };
+
+    // Add a new relation to the set. An equivalent relation (same type,
+    // direction and endpoints) gets an event recorded on its timeline and its
+    // weight accumulated instead of a duplicate entry.
     void add(const Relation& r);
 
+    // Overwrite the weight of an existing relation without recording an event;
+    // false if there is no such relation
+    bool setWeight(const std::string& type, const std::string& a, const std::string& b, bool directed, float weight);
+
     // Remove a relation; returns true if a matching relation was found and
     // erased.
     bool remove(const Relation& r);
@@ -27,16 +115,59 @@ public:
     bool removeBetween(const std::string& a, const std::string& b, const std::string& type = "");
 
     // Query helpers ------------------------------------------------------
-    std::vector<Relation> getRelationsOf(const std::string& entity) const;
-    std::vector<Relation> getRelationsBetween(const std::string& a, const std::string& b) const;
+    RelationView getRelationsOf(const std::string& entity) const;
+    RelationView getRelationsBetween(const std::string& a, const std::string& b) const;
+
+    // Exact lookup by type and endpoints; nullptr if absent
+    const Relation* find(const std::string& type, const std::string& a, const std::string& b, bool directed = false) const;
+
+    // Number of relations touching an entity
+    size_t degreeOf(const std::string& entity) const;
+
+    size_t size() const { return relations.size(); }
+    void clear();
+
+    // Interned identity of each relation, parallel to getAll(), and the names
+    // behind the IDs it uses (entities and types share one table)
+    const std::vector<RelationKey>& getKeys() const { return _keys; }
+    const std::vector<std::string>& getSymbolNames() const { return _symbolNames; }
+
+    // Bumped by every change to relations or their weights
+    uint64_t version() const { return _version; }
+
+    // Event timelines, indexed by the slot of a relation in getAll()
+    const RelationTimeline& timeline() const { return _timeline; }
+    uint32_t slotOf(const Relation& r) const { return static_cast<uint32_t>(&r - relations.data()); }
 
     // (De)Serialization --------------------------------------------------
     nlohmann::json toJson() const;
     void loadFromJson(const nlohmann::json& j);
 
-    // Access underlying storage (read-only)
+    // Access underlying storage (read-only). Removal swaps the last relation
+    // into the freed slot, so order is not preserved across remove().
     const std::vector<Relation>& getAll() const { return relations; }
 
 private:
+    friend class RelationGraphFile;
+
+    static constexpr uint32_t NoSymbol = 0xFFFFFFFFu;
+
+    uint32_t internSymbol(const std::string& name);
+    uint32_t findSymbol(const std::string& name) const;
+    RelationKey keyFor(const Relation& r);
+    bool lookupKey(const std::string& type, const std::string& a, const std::string& b, bool directed, RelationKey& key) const;
+
+    // Append a relation to storage and every index; returns its slot
+    uint32_t insertIndexed(Relation&& r, const RelationKey& key);
+    void eraseAt(uint32_t index);
+
     std::vector<Relation> relations;
-}; 
\ No newline at end of file
+    std::vector<RelationKey> _keys;                   // parallel to `relations`
+
+    std::unordered_map<std::string, uint32_t> _symbolIds;
+    std::vector<std::string> _symbolNames;            // symbol ID -> name
+    std::vector<std::vector<uint32_t>> _adjacency;    // symbol ID -> relation slots
+    std::unordered_map<RelationKey, uint32_t, RelationKeyHash> _index;
+    RelationTimeline _timeline;                       // slots parallel to `relations`
+    uint64_t _version = 0;
+};
@@ -0,0 +1,303 @@
+#include "RelationTimeline.hpp"
+#include <algorithm>
+#include <limits>
+
+static_assert(RelationTimeline::RecentCapacity == 16, "the largest ring block holds 16 cells");
+static_assert(RelationTimeline::BucketCapacity <= 16, "the largest bucket block holds 16 cells");
+
+uint32_t RelationTimeline::BlockSpace::allocate(uint8_t sizeClass) {
+    auto& list = free[sizeClass];
+    if (!list.empty()) {
+        uint32_t base = list.back();
+        list.pop_back();
+        return base;
+    }
+    uint32_t base = cells;
+    cells += 2u << sizeClass;
+    return base;
+}
+
+uint32_t RelationTimeline::appendSlot() {
+    uint32_t slot = static_cast<uint32_t>(_recentHead.size());
+    _recentHead.push_back(0);
+    _recentCount.push_back(0);
+    _recentBase.push_back(0);
+    _recentClass.push_back(NoBlock);
+    _bucketCount.push_back(0);
+    _bucketBase.push_back(0);
+    _bucketClass.push_back(NoBlock);
+    _bucketSpan.push_back(BaseBucketSeconds);
+    _totalCount.push_back(0);
+    return slot;
+}
+
+void RelationTimeline::releaseBlocks(uint32_t slot) {
+    if (_recentClass[slot] != NoBlock) _recentSpace.release(_recentBase[slot], _recentClass[slot]);
+    if (_bucketClass[slot] != NoBlock) _bucketSpace.release(_bucketBase[slot], _bucketClass[slot]);
+    _recentClass[slot] = _bucketClass[slot] = NoBlock;
+    _recentHead[slot] = _recentCount[slot] = _bucketCount[slot] = 0;
+}
+
+// Blocks stay where they are; only the last slot's bookkeeping moves
+void RelationTimeline::eraseSlot(uint32_t slot) {
+    releaseBlocks(slot);
+    const uint32_t last = static_cast<uint32_t>(_recentHead.size() - 1);
+    if (slot != last) {
+        _recentHead[slot]  = _recentHead[last];
+        _recentCount[slot] = _recentCount[last];
+        _recentBase[slot]  = _recentBase[last];
+        _recentClass[slot] = _recentClass[last];
+        _bucketCount[slot] = _bucketCount[last];
+        _bucketBase[slot]  = _bucketBase[last];
+        _bucketClass[slot] = _bucketClass[last];
+        _bucketSpan[slot]  = _bucketSpan[last];
+        _totalCount[slot]  = _totalCount[last];
+    }
+    _recentHead.pop_back();
+    _recentCount.pop_back();
+    _recentBase.pop_back();
+    _recentClass.pop_back();
+    _bucketCount.pop_back();
+    _bucketBase.pop_back();
+    _bucketClass.pop_back();
+    _bucketSpan.pop_back();
+    _totalCount.pop_back();
+}
+
+void RelationTimeline::clear() {
+    *this = RelationTimeline();
+}
+
+uint32_t RelationTimeline::internDescription(const std::string& description) {
+    auto it = _descriptionIds.find(description);
+    if (it != _descriptionIds.end()) return it->second;
+    uint32_t id = static_cast<uint32_t>(_descriptions.size());
+    _descriptions.push_back(description);
+    _descriptionIds.emplace(description, id);
+    return id;
+}
+
+// -----------------------------------------------------------------------------
+// Recording
+// -----------------------------------------------------------------------------
+void RelationTimeline::record(uint32_t slot, const RelationEvent& event) {
+    record(slot, event.timestamp, event.description, event.deltaWeight);
+}
+
+void RelationTimeline::record(uint32_t slot, std::time_t timestamp, const std::string& description, float deltaWeight) {
+    pushRecent(slot, timestamp, internDescription(description), deltaWeight);
+    ++_totalCount[slot];
+}
+
+void RelationTimeline::pushRecent(uint32_t slot, std::time_t timestamp, uint32_t descId, float deltaWeight) {
+    if (_recentCount[slot] == blockCells(_recentClass[slot]) && _recentCount[slot] < RecentCapacity) growRecent(slot);
+    const size_t cell = _recentBase[slot] + _recentHead[slot];
+    // A full ring's write cell holds its oldest event; fold that one away first
+    if (_recentCount[slot] == RecentCapacity) {
+        foldIntoBuckets(slot, _recentTime[cell], _recentDelta[cell]);
+    } else {
+        ++_recentCount[slot];
+    }
+    _recentTime[cell]  = timestamp;
+    _recentDesc[cell]  = descId;
+    _recentDelta[cell] = deltaWeight;
+    _recentHead[slot]  = (_recentHead[slot] + 1) % blockCells(_recentClass[slot]);
+}
+
+// Move the ring into a block twice the size, unrolled oldest first
+void RelationTimeline::growRecent(uint32_t slot) {
+    const uint8_t oldClass = _recentClass[slot];
+    const uint8_t newClass = oldClass == NoBlock ? 0 : oldClass + 1;
+    const uint32_t base = _recentSpace.allocate(newClass);
+    _recentTime.resize(_recentSpace.cells, 0);
+    _recentDesc.resize(_recentSpace.cells, 0);
+    _recentDelta.resize(_recentSpace.cells, 0.0f);
+    const uint32_t count = _recentCount[slot];
+    for (uint32_t i = 0; i < count; ++i) {
+        const size_t from = recentCell(slot, i);
+        _recentTime[base + i]  = _recentTime[from];
+        _recentDesc[base + i]  = _recentDesc[from];
+        _recentDelta[base + i] = _recentDelta[from];
+    }
+    if (oldClass != NoBlock) _recentSpace.release(_recentBase[slot], oldClass);
+    _recentBase[slot] = base;
+    _recentClass[slot] = newClass;
+    _recentHead[slot] = count;
+}
+
+void RelationTimeline::growBuckets(uint32_t slot) {
+    const uint8_t oldClass = _bucketClass[slot];
+    const uint8_t newClass = oldClass == NoBlock ? 0 : oldClass + 1;
+    const uint32_t base = _bucketSpace.allocate(newClass);
+    _bucketEvents.resize(_bucketSpace.cells, 0);
+    _bucketFirst.resize(_bucketSpace.cells, 0);
+    _bucketLast.resize(_bucketSpace.cells, 0);
+    _bucketWeight.resize(_bucketSpace.cells, 0.0f);
+    for (uint32_t i = 0; i < _bucketCount[slot]; ++i) {
+        const size_t from = bucketCell(slot, i);
+        _bucketEvents[base + i] = _bucketEvents[from];
+        _bucketFirst[base + i]  = _bucketFirst[from];
+        _bucketLast[base + i]   = _bucketLast[from];
+        _bucketWeight[base + i] = _bucketWeight[from];
+    }
+    if (oldClass != NoBlock) _bucketSpace.release(_bucketBase[slot], oldClass);
+    _bucketBase[slot] = base;
+    _bucketClass[slot] = newClass;
+}
+
+void RelationTimeline::foldIntoBuckets(uint32_t slot, std::time_t timestamp, float deltaWeight) {
+    const uint32_t n = _bucketCount[slot];
+    if (n > 0) {
+        const size_t cell = bucketCell(slot, n - 1);
+        if (timestamp - _bucketFirst[cell] < _bucketSpan[slot]) {
+            ++_bucketEvents[cell];
+            _bucketFirst[cell] = std::min(_bucketFirst[cell], timestamp);
+            _bucketLast[cell]  = std::max(_bucketLast[cell], timestamp);
+            _bucketWeight[cell] += deltaWeight;
+            return;
+        }
+    }
+    appendBucket(slot, TimelineBucket{1, timestamp, timestamp, deltaWeight});
+}
+
+void RelationTimeline::appendBucket(uint32_t slot, const TimelineBucket& bucket) {
+    if (_bucketCount[slot] == BucketCapacity) mergeBuckets(slot);
+    if (_bucketCount[slot] == blockCells(_bucketClass[slot])) growBuckets(slot);
+    const size_t cell = bucketCell(slot, _bucketCount[slot]++);
+    _bucketEvents[cell] = bucket.count;
+    _bucketFirst[cell]  = bucket.first;
+    _bucketLast[cell]   = bucket.last;
+    _bucketWeight[cell] = bucket.weight;
+}
+
+// Halve the bucket count by merging neighbours and double the width of new buckets
+void RelationTimeline::mergeBuckets(uint32_t slot) {
+    const size_t base = _bucketBase[slot];
+    const uint32_t n = _bucketCount[slot];
+    uint32_t out = 0;
+    for (uint32_t i = 0; i < n; i += 2, ++out) {
+        size_t to = base + out, a = base + i;
+        _bucketEvents[to] = _bucketEvents[a];
+        _bucketFirst[to]  = _bucketFirst[a];
+        _bucketLast[to]   = _bucketLast[a];
+        _bucketWeight[to] = _bucketWeight[a];
+        if (i + 1 < n) {
+            size_t b = a + 1;
+            _bucketEvents[to] += _bucketEvents[b];
+            _bucketFirst[to]   = std::min(_bucketFirst[to], _bucketFirst[b]);
+            _bucketLast[to]    = std::max(_bucketLast[to], _bucketLast[b]);
+            _bucketWeight[to] += _bucketWeight[b];
+        }
+    }
+    _bucketCount[slot] = out;
+    _bucketSpan[slot] *= 2;
+}
+
+// -----------------------------------------------------------------------------
+// Queries
+// -----------------------------------------------------------------------------
+std::vector<RelationEvent> RelationTimeline::recentEvents(uint32_t slot) const {
+    std::vector<RelationEvent> events;
+    events.reserve(_recentCount[slot]);
+    forEachRecent(slot, std::numeric_limits<std::time_t>::min(), std::numeric_limits<std::time_t>::max(),
+                  [&](const RelationEvent& e) { events.push_back(e); });
+    return events;
+}
+
+std::vector<TimelineBucket> RelationTimeline::buckets(uint32_t slot) const {
+    std::vector<TimelineBucket> result;
+    const size_t base = _bucketBase[slot];
+    for (uint32_t i = 0; i < _bucketCount[slot]; ++i) {
+        result.push_back(TimelineBucket{_bucketEvents[base + i], _bucketFirst[base + i], _bucketLast[base + i], _bucketWeight[base + i]});
+    }
+    return result;
+}
+
+TimelineSummary RelationTimeline::summarize(uint32_t slot, std::time_t from, std::time_t to) const {
+    TimelineSummary summary;
+    const size_t base = _bucketBase[slot];
+    for (uint32_t i = 0; i < _bucketCount[slot]; ++i) {
+        std::time_t first = _bucketFirst[base + i];
+        std::time_t last  = _bucketLast[base + i];
+        if (last < from || first > to) continue;
+        if (first >= from && last <= to) {
+            summary.count  += _bucketEvents[base + i];
+            summary.weight += _bucketWeight[base + i];
+            continue;
+        }
+        // Inclusive, so a bucket that only touches an edge still counts a second's worth
+        double overlap = static_cast<double>(std::min(last, to) - std::max(first, from)) + 1.0;
+        double fraction = overlap / (static_cast<double>(last - first) + 1.0);
+        summary.count  += static_cast<uint32_t>(_bucketEvents[base + i] * fraction + 0.5);
+        summary.weight += static_cast<float>(_bucketWeight[base + i] * fraction);
+    }
+    forEachRecent(slot, from, to, [&](const RelationEvent& e) {
+        ++summary.count;
+        summary.weight += e.deltaWeight;
+    });
+    return summary;
+}
+
+// -----------------------------------------------------------------------------
+// Persistence
+// -----------------------------------------------------------------------------
+void RelationTimeline::toJson(uint32_t slot, nlohmann::json& out) const {
+    nlohmann::json events = nlohmann::json::array();
+    for (const auto& e : recentEvents(slot)) events.push_back(e.toJson());
+    nlohmann::json bucketArr = nlohmann::json::array();
+    for (const auto& b : buckets(slot)) {
+        bucketArr.push_back({{"count", b.count}, {"first", b.first}, {"last", b.last}, {"weight", b.weight}});
+    }
+    out["events"] = std::move(events);
+    out["buckets"] = std::move(bucketArr);
+}
+
+// A slot that already has a timeline (a duplicate relation in an old save)
+// gets both merged in time order rather than the new one appended after it
+void RelationTimeline::loadJson(uint32_t slot, const nlohmann::json& in) {
+    std::vector<TimelineBucket> loadedBuckets = buckets(slot);
+    std::vector<RelationEvent> events = recentEvents(slot);
+    uint64_t total = _totalCount[slot];
+    const std::time_t span = _bucketSpan[slot];
+
+    if (in.contains("buckets") && in["buckets"].is_array()) {
+        for (const auto& item : in["buckets"]) {
+            TimelineBucket b;
+            b.count  = item.value("count", 0u);
+            b.first  = item.value("first", static_cast<std::time_t>(0));
+            b.last   = item.value("last", b.first);
+            b.weight = item.value("weight", 0.0f);
+            loadedBuckets.push_back(b);
+            total += b.count;
+        }
+    }
+    if (in.contains("events") && in["events"].is_array()) {
+        // Saves from before compaction can hold any number of events
+        for (const auto& item : in["events"]) {
+            events.push_back(RelationEvent::fromJson(item));
+            ++total;
+        }
+    }
+    std::stable_sort(loadedBuckets.begin(), loadedBuckets.end(), [](const TimelineBucket& a, const TimelineBucket& b) {
+        return a.first < b.first;
+    });
+    std::stable_sort(events.begin(), events.end(), [](const RelationEvent& a, const RelationEvent& b) {
+        return a.timestamp < b.timestamp;
+    });
+
+    releaseBlocks(slot);
+    _bucketSpan[slot] = span;
+    // Everything but the newest RecentCapacity events folds into buckets,
+    // interleaved with the saved buckets by time
+    const size_t folded = events.size() > RecentCapacity ? events.size() - RecentCapacity : 0;
+    size_t b = 0;
+    for (size_t e = 0; e < folded; ++e) {
+        while (b < loadedBuckets.size() && loadedBuckets[b].first <= events[e].timestamp) appendBucket(slot, loadedBuckets[b++]);
+        foldIntoBuckets(slot, events[e].timestamp, events[e].deltaWeight);
+    }
+    while (b < loadedBuckets.size()) appendBucket(slot, loadedBuckets[b++]);
+    for (size_t e = folded; e < events.size(); ++e) {
+        pushRecent(slot, events[e].timestamp, internDescription(events[e].description), events[e].deltaWeight);
+    }
+    _totalCount[slot] = total;
+}
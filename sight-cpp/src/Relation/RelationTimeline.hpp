@@ -0,0 +1,141 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <cstdint>
+#include <ctime>
+#include "Relation.hpp"
+#include "json.hpp"
+
+// Several older events folded together
+struct TimelineBucket {
+    uint32_t count = 0;
+    std::time_t first = 0;
+    std::time_t last = 0;
+    float weight = 0.0f;   // sum of the folded events' deltaWeight
+};
+
+// Totals over a time range
+struct TimelineSummary {
+    uint32_t count = 0;
+    float weight = 0.0f;
+};
+
+// Bounded event timelines for every relation in a RelationManager, stored in
+// columns indexed by relation slot instead of inside each Relation.
+//
+// The newest RecentCapacity events of a relation are kept verbatim in a ring.
+// Events falling out of the ring are folded into at most BucketCapacity time
+// buckets; when those run out, neighbouring buckets are merged pairwise and
+// the bucket width doubles. Memory per relation is therefore bounded no
+// matter how long the world runs.
+//
+// Ring and bucket cells are blocks of 2, 4, 8 or 16 cells carved out of the
+// shared columns, and a relation moves to the next size up only when its
+// block fills, so one with a single event holds two cells, not the maximum.
+//
+// Slots mirror the owning manager's relation vector, including its
+// swap-and-pop removal (see eraseSlot).
+class RelationTimeline {
+public:
+    static constexpr uint32_t RecentCapacity = 16;
+    static constexpr uint32_t BucketCapacity = 12;
+    static constexpr std::time_t BaseBucketSeconds = 60;
+
+    uint32_t appendSlot();
+    // Moves the last slot into `slot` and drops the last
+    void eraseSlot(uint32_t slot);
+    void clear();
+    size_t slotCount() const { return _recentHead.size(); }
+
+    void record(uint32_t slot, const RelationEvent& event);
+    void record(uint32_t slot, std::time_t timestamp, const std::string& description, float deltaWeight);
+
+    // Number of events ever recorded for the slot
+    uint64_t totalCount(uint32_t slot) const { return _totalCount[slot]; }
+
+    // Recent events in [from, to], oldest first
+    template <typename Fn>
+    void forEachRecent(uint32_t slot, std::time_t from, std::time_t to, Fn&& fn) const {
+        for (uint32_t i = 0; i < _recentCount[slot]; ++i) {
+            size_t cell = recentCell(slot, i);
+            std::time_t t = _recentTime[cell];
+            if (t < from || t > to) continue;
+            fn(RelationEvent{t, _descriptions[_recentDesc[cell]], _recentDelta[cell]});
+        }
+    }
+    std::vector<RelationEvent> recentEvents(uint32_t slot) const;
+
+    // Compacted buckets, oldest first
+    std::vector<TimelineBucket> buckets(uint32_t slot) const;
+
+    // Events and weight in [from, to]. Buckets only partly inside the range
+    // are counted in proportion to the overlap of their [first, last] span,
+    // both taken as inclusive whole seconds.
+    TimelineSummary summarize(uint32_t slot, std::time_t from, std::time_t to) const;
+
+    // Per-relation persistence: {"events": [...recent], "buckets": [...]}
+    void toJson(uint32_t slot, nlohmann::json& out) const;
+    void loadJson(uint32_t slot, const nlohmann::json& in);
+
+private:
+    friend class RelationGraphFile;
+
+    // Free blocks of 2 << sizeClass cells in one set of columns
+    struct BlockSpace {
+        static constexpr uint8_t Classes = 4;   // 2, 4, 8 and 16 cells
+        std::vector<uint32_t> free[Classes];
+        uint32_t cells = 0;                     // column length in use
+
+        uint32_t allocate(uint8_t sizeClass);
+        void release(uint32_t base, uint8_t sizeClass) { free[sizeClass].push_back(base); }
+    };
+    static constexpr uint8_t NoBlock = 0xFF;
+    static uint32_t blockCells(uint8_t sizeClass) { return sizeClass == NoBlock ? 0 : 2u << sizeClass; }
+
+    uint32_t internDescription(const std::string& description);
+    // Newest event into the ring, growing it or folding the oldest away
+    void pushRecent(uint32_t slot, std::time_t timestamp, uint32_t descId, float deltaWeight);
+    void growRecent(uint32_t slot);
+    void growBuckets(uint32_t slot);
+    void releaseBlocks(uint32_t slot);
+    void foldIntoBuckets(uint32_t slot, std::time_t timestamp, float deltaWeight);
+    void appendBucket(uint32_t slot, const TimelineBucket& bucket);
+    void mergeBuckets(uint32_t slot);
+
+    // Column index of the i-th oldest recent event
+    size_t recentCell(uint32_t slot, uint32_t i) const {
+        const uint32_t capacity = blockCells(_recentClass[slot]);
+        return _recentBase[slot] + (_recentHead[slot] + capacity - _recentCount[slot] + i) % capacity;
+    }
+    size_t bucketCell(uint32_t slot, uint32_t i) const { return _bucketBase[slot] + i; }
+
+    // Per slot
+    std::vector<uint32_t> _recentHead;      // next ring cell to write, relative to the block
+    std::vector<uint32_t> _recentCount;
+    std::vector<uint32_t> _recentBase;      // first cell of the ring's block
+    std::vector<uint8_t> _recentClass;      // block size class, NoBlock before the first event
+    std::vector<uint32_t> _bucketCount;
+    std::vector<uint32_t> _bucketBase;
+    std::vector<uint8_t> _bucketClass;
+    std::vector<std::time_t> _bucketSpan;   // current bucket width in seconds
+    std::vector<uint64_t> _totalCount;
+
+    // Ring blocks
+    BlockSpace _recentSpace;
+    std::vector<std::time_t> _recentTime;
+    std::vector<uint32_t> _recentDesc;
+    std::vector<float> _recentDelta;
+
+    // Bucket blocks
+    BlockSpace _bucketSpace;
+    std::vector<uint32_t> _bucketEvents;
+    std::vector<std::time_t> _bucketFirst;
+    std::vector<std::time_t> _bucketLast;
+    std::vector<float> _bucketWeight;
+
+    // Descriptions are nearly always the relation type, so store them once
+    std::vector<std::string> _descriptions;
+    std::unordered_map<std::string, uint32_t> _descriptionIds;
+};
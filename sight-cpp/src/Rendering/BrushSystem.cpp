@@ -41,7 +41,7 @@ int BrushSystem::addLayer() {
     newLayer.blendMode = BlendMode::Normal;
     newLayer.visible = true;
     newLayer.strokeHistory.clear();
-    newLayer.undoStack.clear();
+    newLayer.redoStack.clear();
     
     _layers.push_back(newLayer);
     _activeLayer = static_cast<int>(_layers.size()) - 1;
@@ -84,72 +84,15 @@ void BrushSystem::paintDab(const glm::vec2& position, const glm::vec3& color, fl
         return;
     }
 
-    Layer& layer = _layers[_activeLayer];
-    uint8_t* targetBuffer = layer.pixels.data();
-    
-    // Calculate brush parameters
     float radius = _brushRadius * pressure;
     float opacity = _brushOpacity * pressure;
-    float flow = _brushFlow;
-    
-    // Convert position to pixel coordinates
-    int centerX = static_cast<int>(position.x * _textureSize);
-    int centerY = static_cast<int>(position.y * _textureSize);
-    int radiusPx = static_cast<int>(radius * _textureSize);
-    int radiusSq = radiusPx * radiusPx;
-    
-    // Calculate brush bounds
-    int x0 = std::max(0, centerX - radiusPx);
-    int y0 = std::max(0, centerY - radiusPx);
-    int x1 = std::min(_textureSize - 1, centerX + radiusPx);
-    int y1 = std::min(_textureSize - 1, centerY + radiusPx);
+    stampDab(_layers[_activeLayer], position, color, radius, opacity);
     
-    // Apply brush effect to each pixel
-    for (int y = y0; y <= y1; ++y) {
-        for (int x = x0; x <= x1; ++x) {
-            int dx = x - centerX;
-            int dy = y - centerY;
-            int distSq = dx * dx + dy * dy;
-            
-            if (distSq <= radiusSq) {
-                float distNorm = std::sqrt(static_cast<float>(distSq)) / static_cast<float>(radiusPx);
-                float intensity = std::clamp(1.0f - distNorm, 0.0f, 1.0f);
-                
-                // Apply softness
-                if (_brushSoftness < 0.99f) {
-                    intensity = std::pow(intensity, 1.0f / std::max(0.001f, _brushSoftness));
-                }
-                
-                intensity *= opacity * flow;
-                
-                // Apply brush type specific effects
-                switch (_currentBrushType) {
-                    case BrushType::Normal:
-                        applyBrushEffect(targetBuffer, x, y, color, intensity);
-                        break;
-                    case BrushType::Airbrush:
-                        applyAirbrushEffect(targetBuffer, x, y, color, intensity);
-                        break;
-                    case BrushType::Chalk:
-                        applyChalkEffect(targetBuffer, x, y, color, intensity);
-                        break;
-                    case BrushType::Spray:
-                        applySprayEffect(targetBuffer, x, y, color, intensity);
-                        break;
-                    case BrushType::Smudge:
-                        applySmudgeEffect(targetBuffer, x, y, intensity);
-                        break;
-                    case BrushType::Clone:
-                        if (_cloneActive) {
-                            applyCloneEffect(targetBuffer, x, y, intensity);
-                        }
-                        break;
-                }
-            }
-        }
+    // Record the point on the open stroke; finalizeStroke() packs it into history
+    if (_openStroke.empty()) {
+        _openStrokeRadius = _brushRadius;
+        _openStrokeOpacity = _brushOpacity;
     }
-    
-    // Save stroke point for history
     StrokePoint point;
     point.position = position;
     point.radius = radius;
@@ -157,8 +100,7 @@ void BrushSystem::paintDab(const glm::vec2& position, const glm::vec3& color, fl
     point.color = color;
     point.timestamp = static_cast<float>(glfwGetTime());
     point.pressure = pressure;
-    
-    layer.strokeHistory.push_back({point});
+    _openStroke.push_back(point);
     
     compositeLayers();
 }
@@ -174,82 +116,112 @@ void BrushSystem::paintStroke(const glm::vec2& startPos, const glm::vec2& endPos
     float spacing = _brushSpacing;
     int steps = static_cast<int>(distance / spacing) + 1;
     
-    std::vector<StrokePoint> strokePoints;
-    
+    // Each dab is recorded on the open stroke by paintDab()
     for (int i = 0; i <= steps; ++i) {
         float t = static_cast<float>(i) / static_cast<float>(steps);
         glm::vec2 pos = glm::mix(startPos, endPos, t);
         
         float pressure = calculatePressure(pos, static_cast<float>(glfwGetTime()));
         paintDab(pos, color, pressure);
-        
-        // Collect stroke points for history
-        StrokePoint point;
-        point.position = pos;
-        point.radius = _brushRadius * pressure;
-        point.opacity = _brushOpacity * pressure;
-        point.color = color;
-        point.timestamp = static_cast<float>(glfwGetTime());
-        point.pressure = pressure;
-        strokePoints.push_back(point);
-    }
-    
-    // Save complete stroke to history
-    if (_activeLayer >= 0 && _activeLayer < static_cast<int>(_layers.size())) {
-        _layers[_activeLayer].strokeHistory.push_back(strokePoints);
     }
 }
 
 void BrushSystem::paint2DStroke(const std::vector<glm::vec2>& points, const glm::vec3& color) {
     if (points.size() < 2) return;
     
-    std::vector<StrokePoint> strokePoints;
-    
     for (size_t i = 0; i < points.size(); ++i) {
         float pressure = calculatePressure(points[i], static_cast<float>(glfwGetTime()));
         paintDab(points[i], color, pressure);
-        
-        StrokePoint point;
-        point.position = points[i];
-        point.radius = _brushRadius * pressure;
-        point.opacity = _brushOpacity * pressure;
-        point.color = color;
-        point.timestamp = static_cast<float>(glfwGetTime());
-        point.pressure = pressure;
-        strokePoints.push_back(point);
     }
     
-    // Save stroke to history
-    if (_activeLayer >= 0 && _activeLayer < static_cast<int>(_layers.size())) {
-        _layers[_activeLayer].strokeHistory.push_back(strokePoints);
+    // The whole stroke is known up front, so close it here
+    finalizeStroke();
+}
+
+float BrushSystem::getStrokeTolerance() const {
+    if (_strokeTolerance > 0.0f) return _strokeTolerance;
+    return 0.5f / static_cast<float>(std::max(1, _textureSize));
+}
+
+void BrushSystem::finalizeStroke() {
+    if (_openStroke.empty()) return;
+    if (_activeLayer < 0 || _activeLayer >= static_cast<int>(_layers.size())) {
+        _openStroke.clear();
+        return;
+    }
+
+    std::vector<StrokeCodec::Sample> samples(_openStroke.size());
+    for (size_t i = 0; i < _openStroke.size(); ++i) {
+        samples[i].position = _openStroke[i].position;
+        samples[i].pressure = _openStroke[i].pressure;
+        samples[i].time = _openStroke[i].timestamp;
+    }
+
+    CompactStroke stroke;
+    stroke.path = StrokeCodec::encode(samples, getStrokeTolerance());
+    stroke.color = _openStroke.front().color;
+    stroke.radius = _openStrokeRadius;
+    stroke.opacity = _openStrokeOpacity;
+    _layers[_activeLayer].strokeHistory.push_back(std::move(stroke));
+
+    _openStroke.clear();
+    _openStroke.shrink_to_fit(); // long strokes shouldn't pin their peak allocation
+}
+
+std::vector<BrushSystem::StrokePoint> BrushSystem::decodeStroke(const CompactStroke& stroke) const {
+    std::vector<StrokeCodec::Sample> samples = StrokeCodec::decode(stroke.path);
+    std::vector<StrokePoint> points(samples.size());
+    for (size_t i = 0; i < samples.size(); ++i) {
+        points[i].position = samples[i].position;
+        points[i].radius = stroke.radius * samples[i].pressure;
+        points[i].opacity = stroke.opacity * samples[i].pressure;
+        points[i].color = stroke.color;
+        points[i].timestamp = samples[i].time;
+        points[i].pressure = samples[i].pressure;
     }
+    return points;
 }
 
 void BrushSystem::saveStrokeState() {
     if (_activeLayer >= 0 && _activeLayer < static_cast<int>(_layers.size())) {
-        _layers[_activeLayer].undoStack = _layers[_activeLayer].strokeHistory;
+        _layers[_activeLayer].redoStack.clear();
     }
 }
 
 void BrushSystem::undo() {
     if (_activeLayer >= 0 && _activeLayer < static_cast<int>(_layers.size())) {
+        // A stroke still being painted is the one to take back
+        if (!_openStroke.empty()) {
+            finalizeStroke();
+            saveStrokeState();
+        }
         Layer& layer = _layers[_activeLayer];
-        if (!layer.undoStack.empty()) {
-            layer.strokeHistory = layer.undoStack;
-            // TODO: Implement full stroke recreation from history
+        if (!layer.strokeHistory.empty()) {
+            layer.redoStack.push_back(std::move(layer.strokeHistory.back()));
+            layer.strokeHistory.pop_back();
+            repaintLayer(layer);
             compositeLayers();
         }
     }
 }
 
 void BrushSystem::redo() {
-    // TODO: Implement redo functionality
+    if (_activeLayer >= 0 && _activeLayer < static_cast<int>(_layers.size())) {
+        Layer& layer = _layers[_activeLayer];
+        if (!layer.redoStack.empty()) {
+            layer.strokeHistory.push_back(std::move(layer.redoStack.back()));
+            layer.redoStack.pop_back();
+            replayStroke(layer, layer.strokeHistory.back());
+            compositeLayers();
+        }
+    }
 }
 
 void BrushSystem::clearHistory() {
+    _openStroke.clear();
     for (auto& layer : _layers) {
         layer.strokeHistory.clear();
-        layer.undoStack.clear();
+        layer.redoStack.clear();
     }
 }
 
@@ -345,6 +317,95 @@ void BrushSystem::initializeDefaultPresets() {
 
 // Private methods
 
+void BrushSystem::stampDab(Layer& layer, const glm::vec2& position, const glm::vec3& color, float radius, float opacity) {
+    uint8_t* targetBuffer = layer.pixels.data();
+    float flow = _brushFlow;
+    
+    // Convert position to pixel coordinates
+    int centerX = static_cast<int>(position.x * _textureSize);
+    int centerY = static_cast<int>(position.y * _textureSize);
+    int radiusPx = static_cast<int>(radius * _textureSize);
+    int radiusSq = radiusPx * radiusPx;
+    
+    // Calculate brush bounds
+    int x0 = std::max(0, centerX - radiusPx);
+    int y0 = std::max(0, centerY - radiusPx);
+    int x1 = std::min(_textureSize - 1, centerX + radiusPx);
+    int y1 = std::min(_textureSize - 1, centerY + radiusPx);
+    
+    // Apply brush effect to each pixel
+    for (int y = y0; y <= y1; ++y) {
+        for (int x = x0; x <= x1; ++x) {
+            int dx = x - centerX;
+            int dy = y - centerY;
+            int distSq = dx * dx + dy * dy;
+            
+            if (distSq <= radiusSq) {
+                float distNorm = std::sqrt(static_cast<float>(distSq)) / static_cast<float>(radiusPx);
+                float intensity = std::clamp(1.0f - distNorm, 0.0f, 1.0f);
+                
+                // Apply softness
+                if (_brushSoftness < 0.99f) {
+                    intensity = std::pow(intensity, 1.0f / std::max(0.001f, _brushSoftness));
+                }
+                
+                intensity *= opacity * flow;
+                
+                // Apply brush type specific effects
+                switch (_currentBrushType) {
+                    case BrushType::Normal:
+                        applyBrushEffect(targetBuffer, x, y, color, intensity);
+                        break;
+                    case BrushType::Airbrush:
+                        applyAirbrushEffect(targetBuffer, x, y, color, intensity);
+                        break;
+                    case BrushType::Chalk:
+                        applyChalkEffect(targetBuffer, x, y, color, intensity);
+                        break;
+                    case BrushType::Spray:
+                        applySprayEffect(targetBuffer, x, y, color, intensity);
+                        break;
+                    case BrushType::Smudge:
+                        applySmudgeEffect(targetBuffer, x, y, intensity);
+                        break;
+                    case BrushType::Clone:
+                        if (_cloneActive) {
+                            applyCloneEffect(targetBuffer, x, y, intensity);
+                        }
+                        break;
+                }
+            }
+        }
+    }
+}
+
+// Paints a stored stroke back onto a layer: dabs along the decoded path at
+// the brush spacing, as paintStroke() laid them down originally
+void BrushSystem::replayStroke(Layer& layer, const CompactStroke& stroke) {
+    std::vector<StrokePoint> points = decodeStroke(stroke);
+    if (points.empty()) return;
+    
+    float spacing = std::max(_brushSpacing, 1.0f / static_cast<float>(std::max(1, _textureSize)));
+    stampDab(layer, points[0].position, points[0].color, points[0].radius, points[0].opacity);
+    for (size_t i = 1; i < points.size(); ++i) {
+        const StrokePoint& from = points[i - 1];
+        const StrokePoint& to = points[i];
+        int steps = static_cast<int>(glm::length(to.position - from.position) / spacing) + 1;
+        for (int step = 1; step <= steps; ++step) {
+            float t = static_cast<float>(step) / static_cast<float>(steps);
+            stampDab(layer, glm::mix(from.position, to.position, t), to.color,
+                     glm::mix(from.radius, to.radius, t), glm::mix(from.opacity, to.opacity, t));
+        }
+    }
+}
+
+void BrushSystem::repaintLayer(Layer& layer) {
+    std::fill(layer.pixels.begin(), layer.pixels.end(), 0);
+    for (const auto& stroke : layer.strokeHistory) {
+        replayStroke(layer, stroke);
+    }
+}
+
 void BrushSystem::applyBrushEffect(uint8_t* targetBuffer, int x, int y, const glm::vec3& color, float intensity) {
     int idx = getPixelIndex(x, y);
     uint8_t* dst = &targetBuffer[idx];
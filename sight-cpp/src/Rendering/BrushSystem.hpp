@@ -4,6 +4,7 @@
 #include <string>
 #include <glm/glm.hpp>
 #include <cstdint>
+#include "StrokeCodec.hpp"
 
 class BrushSystem {
 public:
@@ -50,13 +51,22 @@ public:
         float pressure;
     };
 
+    // Finished stroke as stored in history: the path is simplified and packed,
+    // and per-point radius/opacity are the stroke's base values times pressure
+    struct CompactStroke {
+        StrokeCodec::Encoded path;
+        glm::vec3 color;
+        float radius;
+        float opacity;
+    };
+
     // Layer structure
     struct Layer {
         std::vector<uint8_t> pixels;  // RGBA8 pixel buffer
         float opacity;
         BlendMode blendMode;
-        std::vector<std::vector<StrokePoint>> strokeHistory;
-        std::vector<std::vector<StrokePoint>> undoStack;
+        std::vector<CompactStroke> strokeHistory;
+        std::vector<CompactStroke> redoStack;  // strokes taken back by undo(), newest last
         bool visible;
     };
 
@@ -111,7 +121,18 @@ public:
     // 2D specific painting (for Zone strokes)
     void paint2DStroke(const std::vector<glm::vec2>& points, const glm::vec3& color);
 
-    // Undo/Redo
+    // Close the stroke being painted: simplify it to within the stroke tolerance
+    // and append it, packed, to the active layer's history
+    void finalizeStroke();
+    // Maximum deviation (in brush-space units) allowed by finalizeStroke(); 0 = half a texel
+    void setStrokeTolerance(float tolerance) { _strokeTolerance = tolerance; }
+    float getStrokeTolerance() const;
+    std::vector<StrokePoint> decodeStroke(const CompactStroke& stroke) const;
+
+    // Undo/Redo. undo() drops the active layer's last stroke and repaints the
+    // layer from the strokes left in its history; redo() paints it back.
+    // saveStrokeState() marks a new stroke as committed, which ends the redo chain.
+    // Replays use the current brush type and softness, which strokes do not store.
     void saveStrokeState();
     void undo();
     void redo();
@@ -158,6 +179,12 @@ private:
     // Stroke interpolation
     bool _useStrokeInterpolation = true;
 
+    // Full-rate points of the stroke in progress, packed by finalizeStroke()
+    std::vector<StrokePoint> _openStroke;
+    float _openStrokeRadius = 0.0f;
+    float _openStrokeOpacity = 0.0f;
+    float _strokeTolerance = 0.0f;
+
     // Layer system
     bool _useLayers = false;
     int _activeLayer = 0;
@@ -177,6 +204,9 @@ private:
     int _currentPreset = 0;
 
     // Internal methods
+    void stampDab(Layer& layer, const glm::vec2& position, const glm::vec3& color, float radius, float opacity);
+    void replayStroke(Layer& layer, const CompactStroke& stroke);
+    void repaintLayer(Layer& layer);
     void applyBrushEffect(uint8_t* targetBuffer, int x, int y, const glm::vec3& color, float intensity);
     void applyAirbrushEffect(uint8_t* targetBuffer, int x, int y, const glm::vec3& color, float intensity);
     void applyChalkEffect(uint8_t* targetBuffer, int x, int y, const glm::vec3& color, float intensity);
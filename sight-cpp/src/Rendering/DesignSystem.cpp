@@ -1,6 +1,8 @@
 #include "DesignSystem.hpp"
 #include "ZonesOfEarth/Zone/Zone.hpp"
 #include "Util/SaveSystem.hpp"
+#include "TextRenderer.hpp"
+#include "Util/WorkerPool.hpp"
 #include <GLFW/glfw3.h>
 #include <algorithm>
 #include <cmath>
@@ -8,6 +10,83 @@
 #include <cstring>
 #include <iostream>
 #include <fstream>
+#include <utility>
+
+namespace {
+
+// Font size is the line height in pixels
+float textScale(const TextSystem::TextStyle& style) {
+    return style.fontSize / TextRenderer::LineHeight;
+}
+
+// Quadtree hits back into handles, ordered as the elements are drawn
+template <typename T>
+std::vector<SlotHandle> toDrawOrder(const SlotMap<T>& elements, const std::vector<uint64_t>& ids) {
+    std::vector<SlotHandle> handles;
+    handles.reserve(ids.size());
+    for (uint64_t id : ids) {
+        SlotHandle handle = SlotHandle::fromValue(id);
+        if (elements.contains(handle)) handles.push_back(handle);
+    }
+    std::sort(handles.begin(), handles.end(), [&elements](SlotHandle a, SlotHandle b) {
+        return elements.positionOf(a) < elements.positionOf(b);
+    });
+    return handles;
+}
+
+// Insert at the element's creation-order position rather than on top
+template <typename T>
+SlotHandle insertInSequence(SlotMap<T>& elements, T element) {
+    for (auto it = elements.begin(); it != elements.end(); ++it) {
+        if (it->sequence > element.sequence) return elements.insertBefore(it.handle(), std::move(element));
+    }
+    return elements.insert(std::move(element));
+}
+
+// Canvas-space box of a shape as renderShapes() draws it: type extent, then rotation, then stroke
+void shapeBounds(const ShapeSystem::ShapeElement& element, glm::vec2& boundsMin, glm::vec2& boundsMax) {
+    glm::vec2 localMin, localMax;
+    float w = std::fabs(element.size.x), h = std::fabs(element.size.y);
+    switch (element.type) {
+        case ShapeSystem::ShapeType::Star:
+            localMax = glm::vec2(w * 0.5f);
+            localMin = -localMax;
+            break;
+        case ShapeSystem::ShapeType::Heart:
+            // The parametric curve spans x in [-16, 16] and y in [-5, 17], scaled by half the size
+            localMin = glm::vec2(-8.0f * w, -2.5f * h);
+            localMax = glm::vec2(8.0f * w, 8.5f * h);
+            break;
+        case ShapeSystem::ShapeType::Custom:
+            localMin = localMax = glm::vec2(0.0f);
+            if (!element.customPoints.empty()) {
+                localMin = localMax = element.customPoints.front();
+                for (const auto& point : element.customPoints) {
+                    localMin = glm::min(localMin, point);
+                    localMax = glm::max(localMax, point);
+                }
+            }
+            break;
+        default:
+            localMax = glm::vec2(w * 0.5f, h * 0.5f);
+            localMin = -localMax;
+            break;
+    }
+
+    // Rotate the local box and take its extent
+    float radians = glm::radians(element.rotation);
+    float c = std::cos(radians), s = std::sin(radians);
+    glm::vec2 center = (localMin + localMax) * 0.5f;
+    glm::vec2 half = (localMax - localMin) * 0.5f;
+    glm::vec2 rotatedCenter(center.x * c - center.y * s, center.x * s + center.y * c);
+    glm::vec2 rotatedHalf(std::fabs(c) * half.x + std::fabs(s) * half.y, std::fabs(s) * half.x + std::fabs(c) * half.y);
+
+    float pad = element.style.strokeEnabled ? element.style.strokeWidth * 0.5f : 0.0f;
+    boundsMin = element.position + rotatedCenter - rotatedHalf - glm::vec2(pad);
+    boundsMax = element.position + rotatedCenter + rotatedHalf + glm::vec2(pad);
+}
+
+} // namespace
 
 // ============================================================================
 // TextSystem Implementation
@@ -22,7 +101,8 @@ TextSystem::~TextSystem() {
 }
 
 std::string TextSystem::addText(const std::string& text, const glm::vec2& position, const TextStyle& style) {
-    std::string id = "text_" + std::to_string(_nextTextId++);
+    int serial = _nextTextId++;
+    std::string id = "text_" + std::to_string(serial);
     
     TextElement element;
     element.text = text;
@@ -30,48 +110,49 @@ std::string TextSystem::addText(const std::string& text, const glm::vec2& positi
     element.style = style;
     element.transform = glm::mat4(1.0f);
     element.id = id;
+    element.sequence = static_cast<uint64_t>(serial);
     
-    _textElements.push_back(element);
-    _textIndexMap[id] = _textElements.size() - 1;
+    SlotHandle handle = _textElements.insert(std::move(element));
+    _textHandles[id] = handle;
+    updateBounds(handle);
     
     printf("Added text: %s at (%.1f, %.1f)\n", text.c_str(), position.x, position.y);
     return id;
 }
 
 void TextSystem::removeText(const std::string& id) {
-    auto it = _textIndexMap.find(id);
-    if (it != _textIndexMap.end()) {
-        size_t index = it->second;
-        _textElements.erase(_textElements.begin() + index);
-        _textIndexMap.erase(it);
-        
-        // Update indices
-        for (auto& pair : _textIndexMap) {
-            if (pair.second > index) {
-                pair.second--;
-            }
-        }
+    auto it = _textHandles.find(id);
+    if (it != _textHandles.end()) {
+        _spatialIndex.remove(it->second.value());
+        _textElements.erase(it->second);
+        _textHandles.erase(it);
     }
 }
 
 void TextSystem::updateText(const std::string& id, const std::string& newText) {
-    TextElement* element = getTextElement(id);
+    SlotHandle handle = getTextHandle(id);
+    TextElement* element = getTextElement(handle);
     if (element) {
         element->text = newText;
+        updateBounds(handle);
     }
 }
 
 void TextSystem::setTextStyle(const std::string& id, const TextStyle& style) {
-    TextElement* element = getTextElement(id);
+    SlotHandle handle = getTextHandle(id);
+    TextElement* element = getTextElement(handle);
     if (element) {
         element->style = style;
+        updateBounds(handle);
     }
 }
 
 void TextSystem::setTextPosition(const std::string& id, const glm::vec2& position) {
-    TextElement* element = getTextElement(id);
+    SlotHandle handle = getTextHandle(id);
+    TextElement* element = getTextElement(handle);
     if (element) {
         element->position = position;
+        updateBounds(handle);
     }
 }
 
@@ -82,63 +163,117 @@ void TextSystem::setTextTransform(const std::string& id, const glm::mat4& transf
     }
 }
 
+void TextSystem::restoreText(const TextElement& element) {
+    SlotHandle handle = getTextHandle(element.id);
+    if (TextElement* existing = _textElements.get(handle)) {
+        bool selected = existing->selected;
+        *existing = element;
+        existing->selected = selected;
+    } else {
+        TextElement restored = element;
+        restored.selected = false;
+        handle = insertInSequence(_textElements, std::move(restored));
+        _textHandles[element.id] = handle;
+    }
+    updateBounds(handle);
+}
+
 void TextSystem::selectText(const std::string& id) {
     // Deselect all first
-    for (auto& element : _textElements) {
-        element.selected = false;
-    }
+    deselectAll();
     
     // Select the specified text
-    TextElement* element = getTextElement(id);
-    if (element) {
+    SlotHandle handle = getTextHandle(id);
+    if (TextElement* element = getTextElement(handle)) {
         element->selected = true;
-        _selectedTexts.push_back(id);
+        _selectedTexts.push_back(handle);
     }
 }
 
 void TextSystem::deselectAll() {
-    for (auto& element : _textElements) {
-        element.selected = false;
+    // Only the tracked selection can be flagged, so there's no need to walk every element
+    for (SlotHandle handle : _selectedTexts) {
+        if (TextElement* element = _textElements.get(handle)) {
+            element->selected = false;
+        }
     }
     _selectedTexts.clear();
 }
 
 std::vector<std::string> TextSystem::getSelectedTexts() const {
-    return _selectedTexts;
+    std::vector<std::string> ids;
+    ids.reserve(_selectedTexts.size());
+    for (SlotHandle handle : _selectedTexts) {
+        if (const TextElement* element = _textElements.get(handle)) {
+            ids.push_back(element->id);
+        }
+    }
+    return ids;
+}
+
+std::string TextSystem::pickText(const glm::vec2& point) const {
+    std::vector<SlotHandle> hits = queryInDrawOrder(point, point);
+    // Last drawn is on top
+    for (auto it = hits.rbegin(); it != hits.rend(); ++it) {
+        const TextElement* element = _textElements.get(*it);
+        if (element->visible) return element->id;
+    }
+    return std::string();
+}
+
+std::vector<std::string> TextSystem::getTextsInRect(const glm::vec2& rectMin, const glm::vec2& rectMax) const {
+    std::vector<std::string> ids;
+    for (SlotHandle handle : queryInDrawOrder(glm::min(rectMin, rectMax), glm::max(rectMin, rectMax))) {
+        ids.push_back(_textElements.get(handle)->id);
+    }
+    return ids;
 }
 
+size_t TextSystem::selectTextsInRect(const glm::vec2& rectMin, const glm::vec2& rectMax) {
+    deselectAll();
+    for (SlotHandle handle : queryInDrawOrder(glm::min(rectMin, rectMax), glm::max(rectMin, rectMax))) {
+        TextElement* element = _textElements.get(handle);
+        if (!element->visible) continue;
+        element->selected = true;
+        _selectedTexts.push_back(handle);
+    }
+    return _selectedTexts.size();
+}
+
+void TextSystem::updateBounds(SlotHandle handle) {
+    const TextElement* element = _textElements.get(handle);
+    if (!element) return;
+    glm::vec2 boundsMin = element->position;
+    glm::vec2 boundsMax = element->position + TextRenderer::instance().measure(element->text, textScale(element->style));
+    _spatialIndex.update(handle.value(), boundsMin, boundsMax);
+}
+
+std::vector<SlotHandle> TextSystem::queryInDrawOrder(const glm::vec2& rectMin, const glm::vec2& rectMax) const {
+    _queryScratch.clear();
+    _spatialIndex.query(rectMin, rectMax, _queryScratch);
+    return toDrawOrder(_textElements, _queryScratch);
+}
+
+// Texts are positioned in canvas coordinates, which are framebuffer pixels, and
+// only queued here; Game draws every queued text of the frame in one pass
 void TextSystem::renderTexts() const {
-    // TODO: Implement proper text rendering using OpenGL
     for (const auto& element : _textElements) {
-        if (element.visible) {
-            // Simple text rendering using OpenGL
-            glPushMatrix();
-            glLoadIdentity();
-            glTranslatef(element.position.x, element.position.y, 0.0f);
-            
-            // Apply text style
-            glColor3f(element.style.color.x, element.style.color.y, element.style.color.z);
-            glLineWidth(1.0f);
-            
-            // Simple text rendering (placeholder - would use proper font rendering)
-            glBegin(GL_LINES);
-            // Draw a simple text indicator
-            float textWidth = element.text.length() * 8.0f; // Approximate width
-            glVertex2f(0, 0);
-            glVertex2f(textWidth, 0);
-            glVertex2f(0, 0);
-            glVertex2f(0, 16);
-            glVertex2f(textWidth, 0);
-            glVertex2f(textWidth, 16);
-            glVertex2f(0, 16);
-            glVertex2f(textWidth, 16);
-            glEnd();
-            
-            glPopMatrix();
-        }
+        renderText(element);
+    }
+}
+
+void TextSystem::renderTexts(const glm::vec2& viewMin, const glm::vec2& viewMax) const {
+    for (SlotHandle handle : queryInDrawOrder(viewMin, viewMax)) {
+        renderText(*_textElements.get(handle));
     }
 }
 
+void TextSystem::renderText(const TextElement& element) const {
+    if (!element.visible) return;
+    TextRenderer::instance().queue(element.text, element.position.x, element.position.y,
+                                   element.style.color, textScale(element.style));
+}
+
 void TextSystem::applyTextEffect(const std::string& id, const std::string& effectType, float intensity) {
     TextElement* element = getTextElement(id);
     if (element) {
@@ -147,12 +282,13 @@ void TextSystem::applyTextEffect(const std::string& id, const std::string& effec
     }
 }
 
+SlotHandle TextSystem::getTextHandle(const std::string& id) const {
+    auto it = _textHandles.find(id);
+    return it != _textHandles.end() ? it->second : SlotHandle();
+}
+
 TextSystem::TextElement* TextSystem::getTextElement(const std::string& id) {
-    auto it = _textIndexMap.find(id);
-    if (it != _textIndexMap.end() && it->second < _textElements.size()) {
-        return &_textElements[it->second];
-    }
-    return nullptr;
+    return _textElements.get(getTextHandle(id));
 }
 
 // ============================================================================
@@ -168,7 +304,8 @@ ShapeSystem::~ShapeSystem() {
 }
 
 std::string ShapeSystem::addShape(ShapeType type, const glm::vec2& position, const glm::vec2& size, const ShapeStyle& style) {
-    std::string id = "shape_" + std::to_string(_nextShapeId++);
+    int serial = _nextShapeId++;
+    std::string id = "shape_" + std::to_string(serial);
     
     ShapeElement element;
     element.type = type;
@@ -177,9 +314,11 @@ std::string ShapeSystem::addShape(ShapeType type, const glm::vec2& position, con
     element.style = style;
     element.transform = glm::mat4(1.0f);
     element.id = id;
+    element.sequence = static_cast<uint64_t>(serial);
     
-    _shapeElements.push_back(element);
-    _shapeIndexMap[id] = _shapeElements.size() - 1;
+    SlotHandle handle = _shapeElements.insert(std::move(element));
+    _shapeHandles[id] = handle;
+    updateBounds(handle);
     
     printf("Added shape type %d at (%.1f, %.1f) size (%.1f, %.1f)\n", 
            static_cast<int>(type), position.x, position.y, size.x, size.y);
@@ -187,7 +326,8 @@ std::string ShapeSystem::addShape(ShapeType type, const glm::vec2& position, con
 }
 
 std::string ShapeSystem::addCustomShape(const std::vector<glm::vec2>& points, const glm::vec2& position, const ShapeStyle& style) {
-    std::string id = "shape_" + std::to_string(_nextShapeId++);
+    int serial = _nextShapeId++;
+    std::string id = "shape_" + std::to_string(serial);
     
     ShapeElement element;
     element.type = ShapeType::Custom;
@@ -197,42 +337,41 @@ std::string ShapeSystem::addCustomShape(const std::vector<glm::vec2>& points, co
     element.transform = glm::mat4(1.0f);
     element.id = id;
     element.customPoints = points;
+    element.sequence = static_cast<uint64_t>(serial);
     
-    _shapeElements.push_back(element);
-    _shapeIndexMap[id] = _shapeElements.size() - 1;
+    SlotHandle handle = _shapeElements.insert(std::move(element));
+    _shapeHandles[id] = handle;
+    updateBounds(handle);
     
     printf("Added custom shape with %zu points at (%.1f, %.1f)\n", points.size(), position.x, position.y);
     return id;
 }
 
 void ShapeSystem::removeShape(const std::string& id) {
-    auto it = _shapeIndexMap.find(id);
-    if (it != _shapeIndexMap.end()) {
-        size_t index = it->second;
-        _shapeElements.erase(_shapeElements.begin() + index);
-        _shapeIndexMap.erase(it);
-        
-        // Update indices
-        for (auto& pair : _shapeIndexMap) {
-            if (pair.second > index) {
-                pair.second--;
-            }
-        }
+    auto it = _shapeHandles.find(id);
+    if (it != _shapeHandles.end()) {
+        _spatialIndex.remove(it->second.value());
+        _shapeElements.erase(it->second);
+        _shapeHandles.erase(it);
     }
 }
 
 void ShapeSystem::updateShape(const std::string& id, const glm::vec2& position, const glm::vec2& size) {
-    ShapeElement* element = getShapeElement(id);
+    SlotHandle handle = getShapeHandle(id);
+    ShapeElement* element = getShapeElement(handle);
     if (element) {
         element->position = position;
         element->size = size;
+        updateBounds(handle);
     }
 }
 
 void ShapeSystem::setShapeStyle(const std::string& id, const ShapeStyle& style) {
-    ShapeElement* element = getShapeElement(id);
+    SlotHandle handle = getShapeHandle(id);
+    ShapeElement* element = getShapeElement(handle);
     if (element) {
         element->style = style;
+        updateBounds(handle);
     }
 }
 
@@ -243,117 +382,193 @@ void ShapeSystem::setShapeTransform(const std::string& id, const glm::mat4& tran
     }
 }
 
+void ShapeSystem::restoreShape(const ShapeElement& element) {
+    SlotHandle handle = getShapeHandle(element.id);
+    if (ShapeElement* existing = _shapeElements.get(handle)) {
+        bool selected = existing->selected;
+        *existing = element;
+        existing->selected = selected;
+    } else {
+        ShapeElement restored = element;
+        restored.selected = false;
+        handle = insertInSequence(_shapeElements, std::move(restored));
+        _shapeHandles[element.id] = handle;
+    }
+    updateBounds(handle);
+}
+
 void ShapeSystem::selectShape(const std::string& id) {
     // Deselect all first
-    for (auto& element : _shapeElements) {
-        element.selected = false;
-    }
+    deselectAll();
     
     // Select the specified shape
-    ShapeElement* element = getShapeElement(id);
-    if (element) {
+    SlotHandle handle = getShapeHandle(id);
+    if (ShapeElement* element = getShapeElement(handle)) {
         element->selected = true;
-        _selectedShapes.push_back(id);
+        _selectedShapes.push_back(handle);
     }
 }
 
 void ShapeSystem::deselectAll() {
-    for (auto& element : _shapeElements) {
-        element.selected = false;
+    // Only the tracked selection can be flagged, so there's no need to walk every element
+    for (SlotHandle handle : _selectedShapes) {
+        if (ShapeElement* element = _shapeElements.get(handle)) {
+            element->selected = false;
+        }
     }
     _selectedShapes.clear();
 }
 
 std::vector<std::string> ShapeSystem::getSelectedShapes() const {
-    return _selectedShapes;
+    std::vector<std::string> ids;
+    ids.reserve(_selectedShapes.size());
+    for (SlotHandle handle : _selectedShapes) {
+        if (const ShapeElement* element = _shapeElements.get(handle)) {
+            ids.push_back(element->id);
+        }
+    }
+    return ids;
+}
+
+std::string ShapeSystem::pickShape(const glm::vec2& point) const {
+    std::vector<SlotHandle> hits = queryInDrawOrder(point, point);
+    // Last drawn is on top
+    for (auto it = hits.rbegin(); it != hits.rend(); ++it) {
+        const ShapeElement* element = _shapeElements.get(*it);
+        if (element->visible) return element->id;
+    }
+    return std::string();
+}
+
+std::vector<std::string> ShapeSystem::getShapesInRect(const glm::vec2& rectMin, const glm::vec2& rectMax) const {
+    std::vector<std::string> ids;
+    for (SlotHandle handle : queryInDrawOrder(glm::min(rectMin, rectMax), glm::max(rectMin, rectMax))) {
+        ids.push_back(_shapeElements.get(handle)->id);
+    }
+    return ids;
+}
+
+size_t ShapeSystem::selectShapesInRect(const glm::vec2& rectMin, const glm::vec2& rectMax) {
+    deselectAll();
+    for (SlotHandle handle : queryInDrawOrder(glm::min(rectMin, rectMax), glm::max(rectMin, rectMax))) {
+        ShapeElement* element = _shapeElements.get(handle);
+        if (!element->visible) continue;
+        element->selected = true;
+        _selectedShapes.push_back(handle);
+    }
+    return _selectedShapes.size();
+}
+
+void ShapeSystem::updateBounds(SlotHandle handle) {
+    const ShapeElement* element = _shapeElements.get(handle);
+    if (!element) return;
+    glm::vec2 boundsMin, boundsMax;
+    shapeBounds(*element, boundsMin, boundsMax);
+    _spatialIndex.update(handle.value(), boundsMin, boundsMax);
+}
+
+std::vector<SlotHandle> ShapeSystem::queryInDrawOrder(const glm::vec2& rectMin, const glm::vec2& rectMax) const {
+    _queryScratch.clear();
+    _spatialIndex.query(rectMin, rectMax, _queryScratch);
+    return toDrawOrder(_shapeElements, _queryScratch);
 }
 
 void ShapeSystem::renderShapes() const {
-    // TODO: Implement shape rendering using OpenGL
     for (const auto& element : _shapeElements) {
-        if (element.visible) {
-            glPushMatrix();
-            glLoadIdentity();
-            glTranslatef(element.position.x, element.position.y, 0.0f);
-            glRotatef(element.rotation, 0.0f, 0.0f, 1.0f);
-            
-            // Apply shape style
-            if (element.style.fillEnabled) {
-                glColor3f(element.style.fillColor.x, element.style.fillColor.y, element.style.fillColor.z);
-                glEnable(GL_BLEND);
-                glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-                glColor4f(element.style.fillColor.x, element.style.fillColor.y, element.style.fillColor.z, element.style.fillOpacity);
-            }
-            
-            // Render shape based on type
-            switch (element.type) {
-                case ShapeType::Rectangle:
-                    renderRectangle(element.size.x, element.size.y, element.style.cornerRadius);
-                    break;
-                case ShapeType::Ellipse:
-                    renderEllipse(element.size.x, element.size.y);
-                    break;
-                case ShapeType::Line:
-                    renderLine(element.size.x, element.size.y);
-                    break;
-                case ShapeType::Polygon:
-                    renderPolygon(element.size.x, element.size.y, element.style.sides);
-                    break;
-                case ShapeType::Star:
-                    renderStar(element.size.x, element.size.y, element.style.starPoints);
-                    break;
-                case ShapeType::Heart:
-                    renderHeart(element.size.x, element.size.y);
-                    break;
-                case ShapeType::Arrow:
-                    renderArrow(element.size.x, element.size.y);
-                    break;
-                case ShapeType::Custom:
-                    renderCustomShape(element.customPoints);
-                    break;
-            }
-            
-            // Render stroke if enabled
-            if (element.style.strokeEnabled) {
-                glColor3f(element.style.strokeColor.x, element.style.strokeColor.y, element.style.strokeColor.z);
-                glLineWidth(element.style.strokeWidth);
-                glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-                
-                // Re-render shape as wireframe for stroke
-                switch (element.type) {
-                    case ShapeType::Rectangle:
-                        renderRectangle(element.size.x, element.size.y, element.style.cornerRadius);
-                        break;
-                    case ShapeType::Ellipse:
-                        renderEllipse(element.size.x, element.size.y);
-                        break;
-                    case ShapeType::Line:
-                        renderLine(element.size.x, element.size.y);
-                        break;
-                    case ShapeType::Polygon:
-                        renderPolygon(element.size.x, element.size.y, element.style.sides);
-                        break;
-                    case ShapeType::Star:
-                        renderStar(element.size.x, element.size.y, element.style.starPoints);
-                        break;
-                    case ShapeType::Heart:
-                        renderHeart(element.size.x, element.size.y);
-                        break;
-                    case ShapeType::Arrow:
-                        renderArrow(element.size.x, element.size.y);
-                        break;
-                    case ShapeType::Custom:
-                        renderCustomShape(element.customPoints);
-                        break;
-                }
-                
-                glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-            }
-            
-            glDisable(GL_BLEND);
-            glPopMatrix();
+        renderShape(element);
+    }
+}
+
+void ShapeSystem::renderShapes(const glm::vec2& viewMin, const glm::vec2& viewMax) const {
+    for (SlotHandle handle : queryInDrawOrder(viewMin, viewMax)) {
+        renderShape(*_shapeElements.get(handle));
+    }
+}
+
+void ShapeSystem::renderShape(const ShapeElement& element) const {
+    // TODO: Implement shape rendering using OpenGL
+    if (!element.visible) return;
+    
+    glPushMatrix();
+    glLoadIdentity();
+    glTranslatef(element.position.x, element.position.y, 0.0f);
+    glRotatef(element.rotation, 0.0f, 0.0f, 1.0f);
+    
+    // Apply shape style
+    if (element.style.fillEnabled) {
+        glColor3f(element.style.fillColor.x, element.style.fillColor.y, element.style.fillColor.z);
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        glColor4f(element.style.fillColor.x, element.style.fillColor.y, element.style.fillColor.z, element.style.fillOpacity);
+    }
+    
+    // Render shape based on type
+    switch (element.type) {
+        case ShapeType::Rectangle:
+            renderRectangle(element.size.x, element.size.y, element.style.cornerRadius);
+            break;
+        case ShapeType::Ellipse:
+            renderEllipse(element.size.x, element.size.y);
+            break;
+        case ShapeType::Line:
+            renderLine(element.size.x, element.size.y);
+            break;
+        case ShapeType::Polygon:
+            renderPolygon(element.size.x, element.size.y, element.style.sides);
+            break;
+        case ShapeType::Star:
+            renderStar(element.size.x, element.size.y, element.style.starPoints);
+            break;
+        case ShapeType::Heart:
+            renderHeart(element.size.x, element.size.y);
+            break;
+        case ShapeType::Arrow:
+            renderArrow(element.size.x, element.size.y);
+            break;
+        case ShapeType::Custom:
+            renderCustomShape(element.customPoints);
+            break;
+    }
+    
+    // Render stroke if enabled
+    if (element.style.strokeEnabled) {
+        glColor3f(element.style.strokeColor.x, element.style.strokeColor.y, element.style.strokeColor.z);
+        glLineWidth(element.style.strokeWidth);
+        glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+        
+        // Re-render shape as wireframe for stroke
+        switch (element.type) {
+            case ShapeType::Rectangle:
+                renderRectangle(element.size.x, element.size.y, element.style.cornerRadius);
+                break;
+            case ShapeType::Ellipse:
+                renderEllipse(element.size.x, element.size.y);
+                break;
+            case ShapeType::Line:
+                renderLine(element.size.x, element.size.y);
+                break;
+            case ShapeType::Polygon:
+                renderPolygon(element.size.x, element.size.y, element.style.sides);
+                break;
+            case ShapeType::Star:
+                renderStar(element.size.x, element.size.y, element.style.starPoints);
+                break;
+            case ShapeType::Heart:
+                renderHeart(element.size.x, element.size.y);
+                break;
+            case ShapeType::Arrow:
+                renderArrow(element.size.x, element.size.y);
+                break;
+            case ShapeType::Custom:
+                renderCustomShape(element.customPoints);
+                break;
         }
+        
+        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
     }
+    
+    glDisable(GL_BLEND);
+    glPopMatrix();
 }
 
 void ShapeSystem::applyShapeEffect(const std::string& id, const std::string& effectType, float intensity) {
@@ -364,12 +579,13 @@ void ShapeSystem::applyShapeEffect(const std::string& id, const std::string& eff
     }
 }
 
+SlotHandle ShapeSystem::getShapeHandle(const std::string& id) const {
+    auto it = _shapeHandles.find(id);
+    return it != _shapeHandles.end() ? it->second : SlotHandle();
+}
+
 ShapeSystem::ShapeElement* ShapeSystem::getShapeElement(const std::string& id) {
-    auto it = _shapeIndexMap.find(id);
-    if (it != _shapeIndexMap.end() && it->second < _shapeElements.size()) {
-        return &_shapeElements[it->second];
-    }
-    return nullptr;
+    return _shapeElements.get(getShapeHandle(id));
 }
 
 // Shape rendering helper methods
@@ -495,6 +711,103 @@ void ShapeSystem::renderCustomShape(const std::vector<glm::vec2>& points) const
 // EffectsSystem Implementation
 // ============================================================================
 
+namespace {
+
+// Splits [0, count) into contiguous ranges and runs them on the shared worker
+// pool. Each range carries at least ~16K pixel-operations, so small images
+// run inline where waking workers would cost more than the work itself.
+template <typename Fn>
+void parallelRanges(int count, int costPerItem, Fn&& fn) {
+    const size_t grain = std::max<size_t>(1, 16384 / std::max(costPerItem, 1));
+    WorkerPool::instance().parallelFor(static_cast<size_t>(count), grain, [&](size_t begin, size_t end) {
+        fn(static_cast<int>(begin), static_cast<int>(end));
+    });
+}
+
+// Horizontal running-sum pass over rows [y0, y1). The window is clipped at the
+// image edges and normalised by the number of in-bounds pixels, matching the
+// behaviour of the old nested-loop box blur.
+void boxBlurRows(const uint8_t* src, uint8_t* dst, int width, int y0, int y1, int radius) {
+    for (int y = y0; y < y1; ++y) {
+        const uint8_t* in = src + static_cast<size_t>(y) * width * 4;
+        uint8_t* out = dst + static_cast<size_t>(y) * width * 4;
+        
+        int sum[4] = {0, 0, 0, 0};
+        for (int x = 0; x <= std::min(radius, width - 1); ++x) {
+            for (int c = 0; c < 4; ++c) sum[c] += in[x * 4 + c];
+        }
+        
+        for (int x = 0; x < width; ++x) {
+            int count = std::min(width - 1, x + radius) - std::max(0, x - radius) + 1;
+            for (int c = 0; c < 4; ++c) {
+                out[x * 4 + c] = static_cast<uint8_t>((sum[c] + count / 2) / count);
+            }
+            
+            // Slide the window one pixel to the right
+            int enter = x + radius + 1;
+            int leave = x - radius;
+            if (enter < width) {
+                for (int c = 0; c < 4; ++c) sum[c] += in[enter * 4 + c];
+            }
+            if (leave >= 0) {
+                for (int c = 0; c < 4; ++c) sum[c] -= in[leave * 4 + c];
+            }
+        }
+    }
+}
+
+// Vertical running-sum pass over columns [x0, x1). Columns are processed as a
+// block, walking down the rows, so memory access stays sequential.
+void boxBlurColumns(const uint8_t* src, uint8_t* dst, int width, int height, int x0, int x1, int radius) {
+    const size_t stride = static_cast<size_t>(width) * 4;
+    const int span = (x1 - x0) * 4;
+    std::vector<int> sum(span, 0);
+    
+    for (int y = 0; y <= std::min(radius, height - 1); ++y) {
+        const uint8_t* row = src + y * stride + x0 * 4;
+        for (int i = 0; i < span; ++i) sum[i] += row[i];
+    }
+    
+    for (int y = 0; y < height; ++y) {
+        int count = std::min(height - 1, y + radius) - std::max(0, y - radius) + 1;
+        uint8_t* out = dst + y * stride + x0 * 4;
+        for (int i = 0; i < span; ++i) {
+            out[i] = static_cast<uint8_t>((sum[i] + count / 2) / count);
+        }
+        
+        int enter = y + radius + 1;
+        int leave = y - radius;
+        if (enter < height) {
+            const uint8_t* row = src + enter * stride + x0 * 4;
+            for (int i = 0; i < span; ++i) sum[i] += row[i];
+        }
+        if (leave >= 0) {
+            const uint8_t* row = src + leave * stride + x0 * 4;
+            for (int i = 0; i < span; ++i) sum[i] -= row[i];
+        }
+    }
+}
+
+// Radii of three successive box blurs whose result approximates a Gaussian
+// with the given standard deviation (Kovesi, "Fast Almost-Gaussian Filtering").
+void gaussianBoxRadii(float sigma, int radii[3]) {
+    const int passes = 3;
+    float idealWidth = std::sqrt(12.0f * sigma * sigma / passes + 1.0f);
+    int lower = static_cast<int>(std::floor(idealWidth));
+    if (lower % 2 == 0) lower--;
+    int upper = lower + 2;
+    
+    float idealLowerCount = (12.0f * sigma * sigma - passes * lower * lower - 4.0f * passes * lower - 3.0f * passes) /
+                            (-4.0f * lower - 4.0f);
+    int lowerCount = static_cast<int>(std::round(idealLowerCount));
+    
+    for (int i = 0; i < passes; ++i) {
+        radii[i] = ((i < lowerCount ? lower : upper) - 1) / 2;
+    }
+}
+
+} // namespace
+
 EffectsSystem::EffectsSystem() {
     printf("EffectsSystem initialized\n");
 }
@@ -504,33 +817,26 @@ EffectsSystem::~EffectsSystem() {
 }
 
 std::string EffectsSystem::addEffect(EffectType type, float intensity) {
-    std::string id = "effect_" + std::to_string(_nextEffectId++);
+    int serial = _nextEffectId++;
+    std::string id = "effect_" + std::to_string(serial);
     
     Effect effect;
     effect.type = type;
     effect.intensity = intensity;
     effect.id = id;
+    effect.sequence = static_cast<uint64_t>(serial);
     
-    _effects.push_back(effect);
-    _effectIndexMap[id] = _effects.size() - 1;
+    _effectHandles[id] = _effects.insert(std::move(effect));
     
     printf("Added effect type %d with intensity %.2f\n", static_cast<int>(type), intensity);
     return id;
 }
 
 void EffectsSystem::removeEffect(const std::string& id) {
-    auto it = _effectIndexMap.find(id);
-    if (it != _effectIndexMap.end()) {
-        size_t index = it->second;
-        _effects.erase(_effects.begin() + index);
-        _effectIndexMap.erase(it);
-        
-        // Update indices
-        for (auto& pair : _effectIndexMap) {
-            if (pair.second > index) {
-                pair.second--;
-            }
-        }
+    auto it = _effectHandles.find(id);
+    if (it != _effectHandles.end()) {
+        _effects.erase(it->second);
+        _effectHandles.erase(it);
     }
 }
 
@@ -548,25 +854,42 @@ void EffectsSystem::enableEffect(const std::string& id, bool enabled) {
     }
 }
 
+void EffectsSystem::restoreEffect(const Effect& effect) {
+    if (Effect* existing = getEffect(effect.id)) {
+        *existing = effect;
+    } else {
+        _effectHandles[effect.id] = insertInSequence(_effects, effect);
+    }
+}
+
 void EffectsSystem::applyEffects(std::vector<uint8_t>& pixels, int width, int height) const {
+    const size_t imageBytes = static_cast<size_t>(std::max(width, 0)) * std::max(height, 0) * 4;
+    if (imageBytes == 0 || pixels.size() < imageBytes) return;
+    
+    _pingPong.resize(pixels.size());
+    
     for (const auto& effect : _effects) {
         if (!effect.enabled) continue;
         
+        bool wroteTarget = false;
         switch (effect.type) {
             case EffectType::Blur:
                 applyBlur(pixels, width, height, effect.intensity);
                 break;
+            case EffectType::GaussianBlur:
+                applyGaussianBlur(pixels, width, height, effect.radius);
+                break;
             case EffectType::Sharpen:
-                applySharpen(pixels, width, height, effect.intensity);
+                wroteTarget = applySharpen(pixels, _pingPong, width, height, effect.intensity);
                 break;
             case EffectType::Noise:
                 applyNoise(pixels, width, height, effect.intensity);
                 break;
             case EffectType::Glow:
-                applyGlow(pixels, width, height, effect);
+                wroteTarget = applyGlow(pixels, _pingPong, width, height, effect);
                 break;
             case EffectType::Shadow:
-                applyShadow(pixels, width, height, effect);
+                wroteTarget = applyShadow(pixels, _pingPong, width, height, effect);
                 break;
             case EffectType::Gradient:
                 applyGradient(pixels, width, height, effect);
@@ -574,6 +897,14 @@ void EffectsSystem::applyEffects(std::vector<uint8_t>& pixels, int width, int he
             default:
                 break;
         }
+        
+        if (wroteTarget) {
+            pixels.swap(_pingPong);
+            // Effects only write the image area; carry any trailing bytes across
+            if (pixels.size() > imageBytes) {
+                std::copy(_pingPong.begin() + imageBytes, _pingPong.end(), pixels.begin() + imageBytes);
+            }
+        }
     }
 }
 
@@ -582,82 +913,86 @@ void EffectsSystem::applyPresetEffect(const std::string& presetName) {
     printf("Applied preset effect: %s\n", presetName.c_str());
 }
 
+SlotHandle EffectsSystem::getEffectHandle(const std::string& id) const {
+    auto it = _effectHandles.find(id);
+    return it != _effectHandles.end() ? it->second : SlotHandle();
+}
+
 EffectsSystem::Effect* EffectsSystem::getEffect(const std::string& id) {
-    auto it = _effectIndexMap.find(id);
-    if (it != _effectIndexMap.end() && it->second < _effects.size()) {
-        return &_effects[it->second];
-    }
-    return nullptr;
+    return _effects.get(getEffectHandle(id));
 }
 
 void EffectsSystem::applyBlur(std::vector<uint8_t>& pixels, int width, int height, float intensity) const {
-    // Simple box blur implementation
-    if (pixels.size() < width * height * 4) return;
-    
-    std::vector<uint8_t> temp = pixels;
-    int radius = static_cast<int>(intensity * 5.0f);
-    radius = std::max(1, std::min(radius, 10));
+    // Box blur; the running-sum passes make large radii as cheap as small ones
+    int radius = std::max(1, static_cast<int>(intensity * 5.0f));
+    boxBlur(pixels, width, height, radius);
+}
+
+void EffectsSystem::applyGaussianBlur(std::vector<uint8_t>& pixels, int width, int height, float radius) const {
+    // The radius spans roughly two standard deviations of the Gaussian
+    float sigma = radius * 0.5f;
+    if (sigma < 0.5f) return;
     
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            int r = 0, g = 0, b = 0, a = 0;
-            int count = 0;
-            
-            for (int dy = -radius; dy <= radius; ++dy) {
-                for (int dx = -radius; dx <= radius; ++dx) {
-                    int nx = x + dx;
-                    int ny = y + dy;
-                    
-                    if (nx >= 0 && nx < width && ny >= 0 && ny < height) {
-                        int index = (ny * width + nx) * 4;
-                        r += temp[index];
-                        g += temp[index + 1];
-                        b += temp[index + 2];
-                        a += temp[index + 3];
-                        count++;
-                    }
-                }
-            }
-            
-            if (count > 0) {
-                int index = (y * width + x) * 4;
-                pixels[index] = r / count;
-                pixels[index + 1] = g / count;
-                pixels[index + 2] = b / count;
-                pixels[index + 3] = a / count;
-            }
-        }
+    int radii[3];
+    gaussianBoxRadii(sigma, radii);
+    for (int boxRadius : radii) {
+        boxBlur(pixels, width, height, boxRadius);
     }
 }
 
-void EffectsSystem::applySharpen(std::vector<uint8_t>& pixels, int width, int height, float intensity) const {
-    // Simple sharpen implementation
-    if (pixels.size() < width * height * 4) return;
+void EffectsSystem::boxBlur(std::vector<uint8_t>& pixels, int width, int height, int radius) const {
+    if (radius <= 0 || width <= 0 || height <= 0) return;
+    
+    // A window wider than the image behaves the same as one that just covers it
+    radius = std::min(radius, std::max(width, height));
+    _blurScratch.resize(pixels.size());
     
-    std::vector<uint8_t> temp = pixels;
+    const uint8_t* src = pixels.data();
+    uint8_t* scratch = _blurScratch.data();
+    parallelRanges(height, width, [&](int y0, int y1) {
+        boxBlurRows(src, scratch, width, y0, y1, radius);
+    });
+    
+    uint8_t* dst = pixels.data();
+    parallelRanges(width, height, [&](int x0, int x1) {
+        boxBlurColumns(scratch, dst, width, height, x0, x1, radius);
+    });
+}
+
+bool EffectsSystem::applySharpen(const std::vector<uint8_t>& pixels, std::vector<uint8_t>& target, int width, int height, float intensity) const {
+    // Simple sharpen implementation; border pixels are passed through unchanged
     float factor = intensity * 0.5f;
     
-    for (int y = 1; y < height - 1; ++y) {
-        for (int x = 1; x < width - 1; ++x) {
-            int index = (y * width + x) * 4;
-            
-            for (int c = 0; c < 4; ++c) {
-                int current = temp[index + c];
-                int neighbors = temp[((y-1) * width + x) * 4 + c] +
-                               temp[((y+1) * width + x) * 4 + c] +
-                               temp[(y * width + x-1) * 4 + c] +
-                               temp[(y * width + x+1) * 4 + c];
+    parallelRanges(height, width, [&](int y0, int y1) {
+        for (int y = y0; y < y1; ++y) {
+            for (int x = 0; x < width; ++x) {
+                int index = (y * width + x) * 4;
+                
+                if (x == 0 || y == 0 || x == width - 1 || y == height - 1) {
+                    for (int c = 0; c < 4; ++c) target[index + c] = pixels[index + c];
+                    continue;
+                }
                 
-                int sharpened = static_cast<int>(current + factor * (current * 4 - neighbors));
-                pixels[index + c] = std::clamp(sharpened, 0, 255);
+                for (int c = 0; c < 4; ++c) {
+                    int current = pixels[index + c];
+                    int neighbors = pixels[((y-1) * width + x) * 4 + c] +
+                                    pixels[((y+1) * width + x) * 4 + c] +
+                                    pixels[(y * width + x-1) * 4 + c] +
+                                    pixels[(y * width + x+1) * 4 + c];
+                    
+                    int sharpened = static_cast<int>(current + factor * (current * 4 - neighbors));
+                    target[index + c] = std::clamp(sharpened, 0, 255);
+                }
             }
         }
-    }
+    });
+    return true;
 }
 
 void EffectsSystem::applyNoise(std::vector<uint8_t>& pixels, int width, int height, float intensity) const {
     // Simple noise implementation
-    for (size_t i = 0; i < pixels.size(); i += 4) {
+    const size_t imageBytes = static_cast<size_t>(width) * height * 4;
+    for (size_t i = 0; i < imageBytes; i += 4) {
         int noise = static_cast<int>((rand() % 100 - 50) * intensity);
         
         for (int c = 0; c < 3; ++c) { // RGB only
@@ -667,14 +1002,70 @@ void EffectsSystem::applyNoise(std::vector<uint8_t>& pixels, int width, int heig
     }
 }
 
-void EffectsSystem::applyGlow(std::vector<uint8_t>& pixels, int width, int height, const Effect& effect) const {
-    // TODO: Implement glow effect
-    printf("Applied glow effect with radius %.1f\n", effect.radius);
-}
-
-void EffectsSystem::applyShadow(std::vector<uint8_t>& pixels, int width, int height, const Effect& effect) const {
-    // TODO: Implement shadow effect
-    printf("Applied shadow effect with offset (%.1f, %.1f)\n", effect.offset.x, effect.offset.y);
+bool EffectsSystem::applyGlow(const std::vector<uint8_t>& pixels, std::vector<uint8_t>& target, int width, int height, const Effect& effect) const {
+    // Blur a copy of the image into the target, then add it back tinted as a halo
+    const size_t imageBytes = static_cast<size_t>(width) * height * 4;
+    std::copy(pixels.begin(), pixels.begin() + imageBytes, target.begin());
+    applyGaussianBlur(target, width, height, effect.radius);
+    
+    const float tint[3] = {effect.color.x * effect.intensity, effect.color.y * effect.intensity, effect.color.z * effect.intensity};
+    parallelRanges(height, width, [&](int y0, int y1) {
+        for (size_t i = static_cast<size_t>(y0) * width * 4; i < static_cast<size_t>(y1) * width * 4; i += 4) {
+            for (int c = 0; c < 3; ++c) {
+                int value = pixels[i + c] + static_cast<int>(target[i + c] * tint[c]);
+                target[i + c] = static_cast<uint8_t>(std::min(value, 255));
+            }
+            int haloAlpha = static_cast<int>(target[i + 3] * std::min(effect.intensity, 1.0f));
+            target[i + 3] = static_cast<uint8_t>(std::max<int>(pixels[i + 3], haloAlpha));
+        }
+    });
+    return true;
+}
+
+bool EffectsSystem::applyShadow(const std::vector<uint8_t>& pixels, std::vector<uint8_t>& target, int width, int height, const Effect& effect) const {
+    // Build the offset silhouette in the target, soften it, then draw the image over it
+    const int offsetX = static_cast<int>(std::round(effect.offset.x));
+    const int offsetY = static_cast<int>(std::round(effect.offset.y));
+    const uint8_t shadowColor[3] = {
+        static_cast<uint8_t>(std::clamp(effect.color.x, 0.0f, 1.0f) * 255.0f),
+        static_cast<uint8_t>(std::clamp(effect.color.y, 0.0f, 1.0f) * 255.0f),
+        static_cast<uint8_t>(std::clamp(effect.color.z, 0.0f, 1.0f) * 255.0f)
+    };
+    const float strength = std::clamp(effect.intensity, 0.0f, 1.0f);
+    
+    parallelRanges(height, width, [&](int y0, int y1) {
+        for (int y = y0; y < y1; ++y) {
+            int sy = y - offsetY;
+            for (int x = 0; x < width; ++x) {
+                int sx = x - offsetX;
+                int index = (y * width + x) * 4;
+                uint8_t alpha = 0;
+                if (sx >= 0 && sx < width && sy >= 0 && sy < height) {
+                    alpha = static_cast<uint8_t>(pixels[(sy * width + sx) * 4 + 3] * strength);
+                }
+                target[index] = shadowColor[0];
+                target[index + 1] = shadowColor[1];
+                target[index + 2] = shadowColor[2];
+                target[index + 3] = alpha;
+            }
+        }
+    });
+    
+    applyGaussianBlur(target, width, height, effect.radius);
+    
+    parallelRanges(height, width, [&](int y0, int y1) {
+        for (size_t i = static_cast<size_t>(y0) * width * 4; i < static_cast<size_t>(y1) * width * 4; i += 4) {
+            float srcAlpha = pixels[i + 3] / 255.0f;
+            float dstAlpha = target[i + 3] / 255.0f * (1.0f - srcAlpha);
+            float outAlpha = srcAlpha + dstAlpha;
+            for (int c = 0; c < 3; ++c) {
+                float value = outAlpha > 0.0f ? (pixels[i + c] * srcAlpha + target[i + c] * dstAlpha) / outAlpha : 0.0f;
+                target[i + c] = static_cast<uint8_t>(std::clamp(value, 0.0f, 255.0f));
+            }
+            target[i + 3] = static_cast<uint8_t>(outAlpha * 255.0f);
+        }
+    });
+    return true;
 }
 
 void EffectsSystem::applyGradient(std::vector<uint8_t>& pixels, int width, int height, const Effect& effect) const {
@@ -716,32 +1107,28 @@ std::string SelectionSystem::createSelection(SelectionType type, const std::vect
         }
     }
     
-    _selections.push_back(selection);
-    _selectionIndexMap[id] = _selections.size() - 1;
+    _selectionHandles[id] = _selections.insert(std::move(selection));
     
     printf("Created selection type %d with %zu points\n", static_cast<int>(type), points.size());
     return id;
 }
 
 void SelectionSystem::removeSelection(const std::string& id) {
-    auto it = _selectionIndexMap.find(id);
-    if (it != _selectionIndexMap.end()) {
-        size_t index = it->second;
-        _selections.erase(_selections.begin() + index);
-        _selectionIndexMap.erase(it);
-        
-        // Update indices
-        for (auto& pair : _selectionIndexMap) {
-            if (pair.second > index) {
-                pair.second--;
-            }
-        }
+    auto it = _selectionHandles.find(id);
+    if (it != _selectionHandles.end()) {
+        _selections.erase(it->second);
+        _selectionHandles.erase(it);
     }
 }
 
+SlotHandle SelectionSystem::getSelectionHandle(const std::string& id) const {
+    auto it = _selectionHandles.find(id);
+    return it != _selectionHandles.end() ? it->second : SlotHandle();
+}
+
 void SelectionSystem::clearAllSelections() {
     _selections.clear();
-    _selectionIndexMap.clear();
+    _selectionHandles.clear();
 }
 
 void SelectionSystem::selectAll() {
@@ -823,26 +1210,17 @@ std::string TransformSystem::createTransform(TransformType type) {
     transform.active = true;
     transform.id = id;
     
-    _transforms.push_back(transform);
-    _transformIndexMap[id] = _transforms.size() - 1;
+    _transformHandles[id] = _transforms.insert(std::move(transform));
     
     printf("Created transform type %d\n", static_cast<int>(type));
     return id;
 }
 
 void TransformSystem::removeTransform(const std::string& id) {
-    auto it = _transformIndexMap.find(id);
-    if (it != _transformIndexMap.end()) {
-        size_t index = it->second;
-        _transforms.erase(_transforms.begin() + index);
-        _transformIndexMap.erase(it);
-        
-        // Update indices
-        for (auto& pair : _transformIndexMap) {
-            if (pair.second > index) {
-                pair.second--;
-            }
-        }
+    auto it = _transformHandles.find(id);
+    if (it != _transformHandles.end()) {
+        _transforms.erase(it->second);
+        _transformHandles.erase(it);
     }
 }
 
@@ -896,12 +1274,13 @@ void TransformSystem::renderTransforms() const {
     }
 }
 
+SlotHandle TransformSystem::getTransformHandle(const std::string& id) const {
+    auto it = _transformHandles.find(id);
+    return it != _transformHandles.end() ? it->second : SlotHandle();
+}
+
 TransformSystem::Transform* TransformSystem::getTransform(const std::string& id) {
-    auto it = _transformIndexMap.find(id);
-    if (it != _transformIndexMap.end() && it->second < _transforms.size()) {
-        return &_transforms[it->second];
-    }
-    return nullptr;
+    return _transforms.get(getTransformHandle(id));
 }
 
 // ============================================================================
@@ -923,6 +1302,10 @@ DesignSystem::DesignSystem() {
     Layer defaultLayer;
     defaultLayer.name = "Background";
     _layers.push_back(defaultLayer);
+    
+    // Empty document as the base version
+    _versions.emplace_back();
+    _versions.back().action = "base";
 }
 
 DesignSystem::~DesignSystem() {
@@ -977,6 +1360,7 @@ void DesignSystem::endDrawing() {
         _isDrawing = false;
         
         if (_brushSystem) {
+            _brushSystem->finalizeStroke();
             _brushSystem->saveStrokeState();
         }
         
@@ -988,21 +1372,21 @@ void DesignSystem::addText(const std::string& text, const glm::vec2& position) {
     if (_textSystem) {
         std::string id = _textSystem->addText(text, position);
         _layers[_activeLayer].elements.push_back(id);
-        saveHistoryEntry("add_text", "{\"id\":\"" + id + "\",\"text\":\"" + text + "\"}");
+        recordText(id, "add_text");
     }
 }
 
 void DesignSystem::editText(const std::string& id, const std::string& newText) {
     if (_textSystem) {
         _textSystem->updateText(id, newText);
-        saveHistoryEntry("edit_text", "{\"id\":\"" + id + "\",\"text\":\"" + newText + "\"}");
+        recordText(id, "edit_text");
     }
 }
 
 void DesignSystem::removeText(const std::string& id) {
     if (_textSystem) {
         _textSystem->removeText(id);
-        saveHistoryEntry("remove_text", "{\"id\":\"" + id + "\"}");
+        recordText(id, "remove_text");
     }
 }
 
@@ -1011,21 +1395,21 @@ void DesignSystem::addShape(Tool::Type shapeType, const glm::vec2& position, con
         ShapeSystem::ShapeType type = mapToolToShapeType(shapeType);
         std::string id = _shapeSystem->addShape(type, position, size);
         _layers[_activeLayer].elements.push_back(id);
-        saveHistoryEntry("add_shape", "{\"id\":\"" + id + "\",\"type\":" + std::to_string(static_cast<int>(type)) + "}");
+        recordShape(id, "add_shape");
     }
 }
 
 void DesignSystem::editShape(const std::string& id, const glm::vec2& position, const glm::vec2& size) {
     if (_shapeSystem) {
         _shapeSystem->updateShape(id, position, size);
-        saveHistoryEntry("edit_shape", "{\"id\":\"" + id + "\"}");
+        recordShape(id, "edit_shape");
     }
 }
 
 void DesignSystem::removeShape(const std::string& id) {
     if (_shapeSystem) {
         _shapeSystem->removeShape(id);
-        saveHistoryEntry("remove_shape", "{\"id\":\"" + id + "\"}");
+        recordShape(id, "remove_shape");
     }
 }
 
@@ -1051,6 +1435,7 @@ void DesignSystem::endSelection() {
             std::vector<glm::vec2> points = {_startPosition, _currentPosition};
             _selectionSystem->createSelection(SelectionSystem::SelectionType::Rectangle, points);
         }
+        selectElementsInRect(_startPosition, _currentPosition);
         
         printf("Ended selection\n");
     }
@@ -1062,16 +1447,43 @@ void DesignSystem::clearSelection() {
     }
 }
 
+std::string DesignSystem::pickElement(const glm::vec2& point) const {
+    if (_shapeSystem) {
+        std::string id = _shapeSystem->pickShape(point);
+        if (!id.empty()) return id;
+    }
+    return _textSystem ? _textSystem->pickText(point) : std::string();
+}
+
+size_t DesignSystem::selectElementsInRect(const glm::vec2& cornerA, const glm::vec2& cornerB) {
+    size_t count = 0;
+    if (_textSystem) count += _textSystem->selectTextsInRect(cornerA, cornerB);
+    if (_shapeSystem) count += _shapeSystem->selectShapesInRect(cornerA, cornerB);
+    return count;
+}
+
 void DesignSystem::startTransform(const glm::vec2& position) {
     _isTransforming = true;
     _startPosition = position;
     _currentPosition = position;
+    _transformTarget = pickElement(position);
     printf("Started transform at (%.1f, %.1f)\n", position.x, position.y);
 }
 
 void DesignSystem::updateTransform(const glm::vec2& position) {
     if (_isTransforming) {
+        glm::vec2 delta = position - _currentPosition;
         _currentPosition = position;
+        
+        // Drag the picked element; the setters keep the spatial index current
+        if (!_transformTarget.empty()) {
+            if (_shapeSystem && _shapeSystem->getShapeElement(_transformTarget)) {
+                const ShapeSystem::ShapeElement* shape = _shapeSystem->getShapeElement(_transformTarget);
+                _shapeSystem->updateShape(_transformTarget, shape->position + delta, shape->size);
+            } else if (_textSystem && _textSystem->getTextElement(_transformTarget)) {
+                _textSystem->setTextPosition(_transformTarget, _textSystem->getTextElement(_transformTarget)->position + delta);
+            }
+        }
         printf("Updated transform to (%.1f, %.1f)\n", position.x, position.y);
     }
 }
@@ -1079,6 +1491,15 @@ void DesignSystem::updateTransform(const glm::vec2& position) {
 void DesignSystem::endTransform() {
     if (_isTransforming) {
         _isTransforming = false;
+        // One version per drag rather than per mouse move
+        if (!_transformTarget.empty() && _currentPosition != _startPosition) {
+            if (_shapeSystem && _shapeSystem->getShapeElement(_transformTarget)) {
+                recordShape(_transformTarget, "move_shape");
+            } else if (_textSystem && _textSystem->getTextElement(_transformTarget)) {
+                recordText(_transformTarget, "move_text");
+            }
+        }
+        _transformTarget.clear();
         printf("Ended transform\n");
     }
 }
@@ -1087,14 +1508,14 @@ void DesignSystem::addEffect(Tool::Type effectType, float intensity) {
     if (_effectsSystem) {
         EffectsSystem::EffectType type = mapToolToEffectType(effectType);
         std::string id = _effectsSystem->addEffect(type, intensity);
-        saveHistoryEntry("add_effect", "{\"id\":\"" + id + "\",\"type\":" + std::to_string(static_cast<int>(type)) + "}");
+        recordEffect(id, "add_effect");
     }
 }
 
 void DesignSystem::removeEffect(const std::string& id) {
     if (_effectsSystem) {
         _effectsSystem->removeEffect(id);
-        saveHistoryEntry("remove_effect", "{\"id\":\"" + id + "\"}");
+        recordEffect(id, "remove_effect");
     }
 }
 
@@ -1131,9 +1552,23 @@ void DesignSystem::setLayerOpacity(int layerIndex, float opacity) {
 }
 
 void DesignSystem::render() const {
+    // Elements are drawn in framebuffer pixels under the caller's top-left ortho
+    // projection, so the viewport is the visible canvas region
+    GLint viewport[4] = {0, 0, 0, 0};
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    bool cull = viewport[2] > 0 && viewport[3] > 0;
+    glm::vec2 viewMin(0.0f, 0.0f);
+    glm::vec2 viewMax(static_cast<float>(viewport[2]), static_cast<float>(viewport[3]));
+    
     // Render all subsystems
-    if (_textSystem) _textSystem->renderTexts();
-    if (_shapeSystem) _shapeSystem->renderShapes();
+    if (_textSystem) {
+        if (cull) _textSystem->renderTexts(viewMin, viewMax);
+        else _textSystem->renderTexts();
+    }
+    if (_shapeSystem) {
+        if (cull) _shapeSystem->renderShapes(viewMin, viewMax);
+        else _shapeSystem->renderShapes();
+    }
     if (_selectionSystem) _selectionSystem->renderSelections();
     if (_transformSystem) _transformSystem->renderTransforms();
 }
@@ -1144,27 +1579,41 @@ void DesignSystem::renderUI() const {
 }
 
 void DesignSystem::undo() {
-    if (_historyIndex > 0) {
-        _historyIndex--;
-        // TODO: Implement undo functionality
-        printf("Undo: %s\n", _history[_historyIndex].action.c_str());
+    if (_currentVersion > 0) {
+        printf("Undo: %s\n", _versions[_currentVersion].action.c_str());
+        switchToVersion(_currentVersion - 1);
     }
 }
 
 void DesignSystem::redo() {
-    if (_historyIndex < _history.size()) {
-        // TODO: Implement redo functionality
-        printf("Redo: %s\n", _history[_historyIndex].action.c_str());
-        _historyIndex++;
+    if (_currentVersion + 1 < _versions.size()) {
+        switchToVersion(_currentVersion + 1);
+        printf("Redo: %s\n", _versions[_currentVersion].action.c_str());
     }
 }
 
 void DesignSystem::clearHistory() {
-    _history.clear();
-    _historyIndex = 0;
+    // Keep the current document as the new base version
+    DocumentVersion current = _versions[_currentVersion];
+    current.action = "base";
+    _versions.clear();
+    _versions.push_back(std::move(current));
+    _currentVersion = 0;
     printf("History cleared\n");
 }
 
+void DesignSystem::setHistoryLimit(size_t maxVersions) {
+    _historyLimit = std::max<size_t>(maxVersions, 1);
+    // Drop the oldest versions first, but never the current one
+    while (_versions.size() > _historyLimit && _currentVersion > 0) {
+        _versions.pop_front();
+        --_currentVersion;
+    }
+    while (_versions.size() > _historyLimit) {
+        _versions.pop_back();
+    }
+}
+
 void DesignSystem::saveDesign(const std::string& filename) const {
     nlohmann::json j;
     
@@ -1181,18 +1630,6 @@ void DesignSystem::saveDesign(const std::string& filename) const {
     j["layers"] = layersArray;
     j["activeLayer"] = _activeLayer;
     
-    // Save history
-    nlohmann::json historyArray = nlohmann::json::array();
-    for (const auto& entry : _history) {
-        nlohmann::json entryJson;
-        entryJson["action"] = entry.action;
-        entryJson["data"] = entry.data;
-        entryJson["timestamp"] = entry.timestamp;
-        historyArray.push_back(entryJson);
-    }
-    j["history"] = historyArray;
-    j["historyIndex"] = _historyIndex;
-    
     // Save current tool
     j["currentTool"] = static_cast<int>(_currentTool);
     
@@ -1224,21 +1661,6 @@ void DesignSystem::loadDesign(const std::string& filename) {
             
             _activeLayer = j.value("activeLayer", 0);
             
-            // Load history
-            if (j.contains("history")) {
-                _history.clear();
-                const auto& historyArray = j["history"];
-                for (const auto& entryJson : historyArray) {
-                    HistoryEntry entry;
-                    entry.action = entryJson.value("action", "");
-                    entry.data = entryJson.value("data", "");
-                    entry.timestamp = entryJson.value("timestamp", 0.0f);
-                    _history.push_back(entry);
-                }
-            }
-            
-            _historyIndex = j.value("historyIndex", 0);
-            
             // Load current tool
             if (j.contains("currentTool")) {
                 _currentTool = static_cast<Tool::Type>(j["currentTool"].get<int>());
@@ -1252,28 +1674,62 @@ void DesignSystem::loadDesign(const std::string& filename) {
     }
 }
 
-void DesignSystem::saveHistoryEntry(const std::string& action, const std::string& data) {
-    clearFutureHistory();
+void DesignSystem::commitVersion(DocumentVersion version, const std::string& action) {
+    version.action = action;
+    version.timestamp = static_cast<float>(glfwGetTime());
     
-    HistoryEntry entry;
-    entry.action = action;
-    entry.data = data;
-    entry.timestamp = static_cast<float>(glfwGetTime());
-    
-    _history.push_back(entry);
-    _historyIndex = _history.size();
-    
-    // Limit history size
-    if (_history.size() > 100) {
-        _history.erase(_history.begin());
-        _historyIndex--;
+    // A new edit discards the redo branch
+    _versions.erase(_versions.begin() + _currentVersion + 1, _versions.end());
+    _versions.push_back(std::move(version));
+    while (_versions.size() > _historyLimit) {
+        _versions.pop_front();
     }
+    _currentVersion = _versions.size() - 1;
 }
 
-void DesignSystem::clearFutureHistory() {
-    if (_historyIndex < _history.size()) {
-        _history.erase(_history.begin() + _historyIndex, _history.end());
-    }
+void DesignSystem::recordText(const std::string& id, const std::string& action) {
+    DocumentVersion next = _versions[_currentVersion];
+    const TextSystem::TextElement* element = _textSystem->getTextElement(id);
+    next.texts = element ? next.texts.set(id, *element) : next.texts.erase(id);
+    commitVersion(std::move(next), action);
+}
+
+void DesignSystem::recordShape(const std::string& id, const std::string& action) {
+    DocumentVersion next = _versions[_currentVersion];
+    const ShapeSystem::ShapeElement* element = _shapeSystem->getShapeElement(id);
+    next.shapes = element ? next.shapes.set(id, *element) : next.shapes.erase(id);
+    commitVersion(std::move(next), action);
+}
+
+void DesignSystem::recordEffect(const std::string& id, const std::string& action) {
+    DocumentVersion next = _versions[_currentVersion];
+    const EffectsSystem::Effect* effect = _effectsSystem->getEffect(id);
+    next.effects = effect ? next.effects.set(id, *effect) : next.effects.erase(id);
+    commitVersion(std::move(next), action);
+}
+
+void DesignSystem::switchToVersion(size_t index) {
+    const DocumentVersion& from = _versions[_currentVersion];
+    const DocumentVersion& to = _versions[index];
+    
+    // Only elements that differ between the two versions are touched
+    PersistentMap<std::string, TextSystem::TextElement>::diff(from.texts, to.texts,
+        [this](const std::string& id, const TextSystem::TextElement*, const TextSystem::TextElement* after) {
+            if (after) _textSystem->restoreText(*after);
+            else _textSystem->removeText(id);
+        });
+    PersistentMap<std::string, ShapeSystem::ShapeElement>::diff(from.shapes, to.shapes,
+        [this](const std::string& id, const ShapeSystem::ShapeElement*, const ShapeSystem::ShapeElement* after) {
+            if (after) _shapeSystem->restoreShape(*after);
+            else _shapeSystem->removeShape(id);
+        });
+    PersistentMap<std::string, EffectsSystem::Effect>::diff(from.effects, to.effects,
+        [this](const std::string& id, const EffectsSystem::Effect*, const EffectsSystem::Effect* after) {
+            if (after) _effectsSystem->restoreEffect(*after);
+            else _effectsSystem->removeEffect(id);
+        });
+    
+    _currentVersion = index;
 }
 
 ShapeSystem::ShapeType DesignSystem::mapToolToShapeType(Tool::Type toolType) const {
@@ -1292,6 +1748,7 @@ ShapeSystem::ShapeType DesignSystem::mapToolToShapeType(Tool::Type toolType) con
 EffectsSystem::EffectType DesignSystem::mapToolToEffectType(Tool::Type toolType) const {
     switch (toolType) {
         case Tool::Type::Blur: return EffectsSystem::EffectType::Blur;
+        case Tool::Type::GaussianBlur: return EffectsSystem::EffectType::GaussianBlur;
         case Tool::Type::Sharpen: return EffectsSystem::EffectType::Sharpen;
         case Tool::Type::Noise: return EffectsSystem::EffectType::Noise;
         case Tool::Type::Emboss: return EffectsSystem::EffectType::Emboss;
@@ -4,10 +4,14 @@
 #include <string>
 #include <memory>
 #include <unordered_map>
+#include <deque>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include "OurVerse/Tool.hpp"
 #include "BrushSystem.hpp"
+#include "Util/SlotMap.hpp"
+#include "Util/LooseQuadtree.hpp"
+#include "Util/PersistentMap.hpp"
 
 // Forward declarations
 class Zone;
@@ -45,6 +49,7 @@ public:
         bool selected = false;
         bool visible = true;
         std::string id;
+        uint64_t sequence = 0; // creation order, so undo can put an element back at its old depth
     };
 
     TextSystem();
@@ -57,27 +62,46 @@ public:
     void setTextStyle(const std::string& id, const TextStyle& style);
     void setTextPosition(const std::string& id, const glm::vec2& position);
     void setTextTransform(const std::string& id, const glm::mat4& transform);
+    // Put back a saved copy of an element (undo/redo), keeping the live selection state
+    void restoreText(const TextElement& element);
     
     // Text selection
     void selectText(const std::string& id);
     void deselectAll();
     std::vector<std::string> getSelectedTexts() const;
     
-    // Text rendering
+    // Spatial queries in canvas coordinates, served by a loose quadtree
+    std::string pickText(const glm::vec2& point) const;   // topmost hit, or empty
+    std::vector<std::string> getTextsInRect(const glm::vec2& rectMin, const glm::vec2& rectMax) const;
+    size_t selectTextsInRect(const glm::vec2& rectMin, const glm::vec2& rectMax);
+    
+    // Text rendering. The region overload skips elements outside [viewMin, viewMax].
     void renderTexts() const;
+    void renderTexts(const glm::vec2& viewMin, const glm::vec2& viewMax) const;
     
     // Text effects
     void applyTextEffect(const std::string& id, const std::string& effectType, float intensity = 1.0f);
     
-    // Getters
-    const std::vector<TextElement>& getTextElements() const { return _textElements; }
+    // Getters. String IDs are resolved to a handle once; hot paths can keep the
+    // handle and skip the string hash.
+    const SlotMap<TextElement>& getTextElements() const { return _textElements; }
+    SlotHandle getTextHandle(const std::string& id) const;
     TextElement* getTextElement(const std::string& id);
+    TextElement* getTextElement(SlotHandle handle) { return _textElements.get(handle); }
 
 private:
-    std::vector<TextElement> _textElements;
-    std::unordered_map<std::string, size_t> _textIndexMap;
-    std::vector<std::string> _selectedTexts;
+    SlotMap<TextElement> _textElements;
+    std::unordered_map<std::string, SlotHandle> _textHandles;
+    std::vector<SlotHandle> _selectedTexts;
     int _nextTextId = 1;
+    
+    // Element bounds keyed by SlotHandle::value(); kept current by every edit that moves or resizes
+    LooseQuadtree _spatialIndex;
+    mutable std::vector<uint64_t> _queryScratch;
+    
+    void updateBounds(SlotHandle handle);
+    std::vector<SlotHandle> queryInDrawOrder(const glm::vec2& rectMin, const glm::vec2& rectMax) const;
+    void renderText(const TextElement& element) const;
 };
 
 // Shape system for professional shape creation
@@ -125,6 +149,7 @@ public:
         bool visible = true;
         std::string id;
         std::vector<glm::vec2> customPoints; // for custom shapes
+        uint64_t sequence = 0; // creation order, so undo can put an element back at its old depth
     };
 
     ShapeSystem();
@@ -137,28 +162,46 @@ public:
     void updateShape(const std::string& id, const glm::vec2& position, const glm::vec2& size);
     void setShapeStyle(const std::string& id, const ShapeStyle& style);
     void setShapeTransform(const std::string& id, const glm::mat4& transform);
+    // Put back a saved copy of an element (undo/redo), keeping the live selection state
+    void restoreShape(const ShapeElement& element);
     
     // Shape selection
     void selectShape(const std::string& id);
     void deselectAll();
     std::vector<std::string> getSelectedShapes() const;
     
-    // Shape rendering
+    // Spatial queries in canvas coordinates, served by a loose quadtree
+    std::string pickShape(const glm::vec2& point) const;   // topmost hit, or empty
+    std::vector<std::string> getShapesInRect(const glm::vec2& rectMin, const glm::vec2& rectMax) const;
+    size_t selectShapesInRect(const glm::vec2& rectMin, const glm::vec2& rectMax);
+    
+    // Shape rendering. The region overload skips elements outside [viewMin, viewMax].
     void renderShapes() const;
+    void renderShapes(const glm::vec2& viewMin, const glm::vec2& viewMax) const;
     
     // Shape effects
     void applyShapeEffect(const std::string& id, const std::string& effectType, float intensity = 1.0f);
     
     // Getters
-    const std::vector<ShapeElement>& getShapeElements() const { return _shapeElements; }
+    const SlotMap<ShapeElement>& getShapeElements() const { return _shapeElements; }
+    SlotHandle getShapeHandle(const std::string& id) const;
     ShapeElement* getShapeElement(const std::string& id);
+    ShapeElement* getShapeElement(SlotHandle handle) { return _shapeElements.get(handle); }
 
 private:
-    std::vector<ShapeElement> _shapeElements;
-    std::unordered_map<std::string, size_t> _shapeIndexMap;
-    std::vector<std::string> _selectedShapes;
+    SlotMap<ShapeElement> _shapeElements;
+    std::unordered_map<std::string, SlotHandle> _shapeHandles;
+    std::vector<SlotHandle> _selectedShapes;
     int _nextShapeId = 1;
     
+    // Element bounds keyed by SlotHandle::value(); kept current by every edit that moves or resizes
+    LooseQuadtree _spatialIndex;
+    mutable std::vector<uint64_t> _queryScratch;
+    
+    void updateBounds(SlotHandle handle);
+    std::vector<SlotHandle> queryInDrawOrder(const glm::vec2& rectMin, const glm::vec2& rectMax) const;
+    void renderShape(const ShapeElement& element) const;
+    
     // Shape rendering helper methods
     void renderRectangle(float width, float height, float cornerRadius) const;
     void renderEllipse(float width, float height) const;
@@ -190,7 +233,8 @@ public:
         Invert,
         Sepia,
         Vintage,
-        Neon
+        Neon,
+        GaussianBlur
     };
 
     struct Effect {
@@ -201,6 +245,7 @@ public:
         float radius = 10.0f;
         bool enabled = true;
         std::string id;
+        uint64_t sequence = 0; // creation order, so undo can put an effect back at its old place in the chain
     };
 
     EffectsSystem();
@@ -211,29 +256,45 @@ public:
     void removeEffect(const std::string& id);
     void updateEffect(const std::string& id, const Effect& effect);
     void enableEffect(const std::string& id, bool enabled);
+    // Put back a saved copy of an effect (undo/redo)
+    void restoreEffect(const Effect& effect);
     
-    // Effect rendering
+    // Effect rendering. The whole chain runs through `pixels` and one reusable
+    // ping-pong buffer, so enabling more effects does not add full-buffer copies.
     void applyEffects(std::vector<uint8_t>& pixels, int width, int height) const;
     
     // Preset effects
     void applyPresetEffect(const std::string& presetName);
     
     // Getters
-    const std::vector<Effect>& getEffects() const { return _effects; }
+    const SlotMap<Effect>& getEffects() const { return _effects; }
+    SlotHandle getEffectHandle(const std::string& id) const;
     Effect* getEffect(const std::string& id);
+    Effect* getEffect(SlotHandle handle) { return _effects.get(handle); }
 
 private:
-    std::vector<Effect> _effects;
-    std::unordered_map<std::string, size_t> _effectIndexMap;
+    SlotMap<Effect> _effects;
+    std::unordered_map<std::string, SlotHandle> _effectHandles;
     int _nextEffectId = 1;
     
-    // Effect application methods
+    // Scratch storage reused across applyEffects() calls: the ping-pong target for
+    // effects that cannot run in place, and the intermediate for separable blurs.
+    mutable std::vector<uint8_t> _pingPong;
+    mutable std::vector<uint8_t> _blurScratch;
+    
+    // Effect application methods. Effects that need the untouched source write
+    // into `target` and return true; the caller then swaps the two buffers.
     void applyBlur(std::vector<uint8_t>& pixels, int width, int height, float intensity) const;
-    void applySharpen(std::vector<uint8_t>& pixels, int width, int height, float intensity) const;
+    void applyGaussianBlur(std::vector<uint8_t>& pixels, int width, int height, float radius) const;
+    bool applySharpen(const std::vector<uint8_t>& pixels, std::vector<uint8_t>& target, int width, int height, float intensity) const;
     void applyNoise(std::vector<uint8_t>& pixels, int width, int height, float intensity) const;
-    void applyGlow(std::vector<uint8_t>& pixels, int width, int height, const Effect& effect) const;
-    void applyShadow(std::vector<uint8_t>& pixels, int width, int height, const Effect& effect) const;
+    bool applyGlow(const std::vector<uint8_t>& pixels, std::vector<uint8_t>& target, int width, int height, const Effect& effect) const;
+    bool applyShadow(const std::vector<uint8_t>& pixels, std::vector<uint8_t>& target, int width, int height, const Effect& effect) const;
     void applyGradient(std::vector<uint8_t>& pixels, int width, int height, const Effect& effect) const;
+    
+    // Separable running-sum box blur: O(1) per pixel regardless of radius.
+    // Rows are blurred into _blurScratch, then columns back into `pixels`.
+    void boxBlur(std::vector<uint8_t>& pixels, int width, int height, int radius) const;
 };
 
 // Selection system for professional selection tools
@@ -277,11 +338,12 @@ public:
     std::vector<glm::vec2> getSelectedPoints() const;
     
     // Getters
-    const std::vector<Selection>& getSelections() const { return _selections; }
+    const SlotMap<Selection>& getSelections() const { return _selections; }
+    SlotHandle getSelectionHandle(const std::string& id) const;
 
 private:
-    std::vector<Selection> _selections;
-    std::unordered_map<std::string, size_t> _selectionIndexMap;
+    SlotMap<Selection> _selections;
+    std::unordered_map<std::string, SlotHandle> _selectionHandles;
     int _nextSelectionId = 1;
 };
 
@@ -324,12 +386,14 @@ public:
     void renderTransforms() const;
     
     // Getters
-    const std::vector<Transform>& getTransforms() const { return _transforms; }
+    const SlotMap<Transform>& getTransforms() const { return _transforms; }
+    SlotHandle getTransformHandle(const std::string& id) const;
     Transform* getTransform(const std::string& id);
+    Transform* getTransform(SlotHandle handle) { return _transforms.get(handle); }
 
 private:
-    std::vector<Transform> _transforms;
-    std::unordered_map<std::string, size_t> _transformIndexMap;
+    SlotMap<Transform> _transforms;
+    std::unordered_map<std::string, SlotHandle> _transformHandles;
     int _nextTransformId = 1;
 };
 
@@ -377,6 +441,10 @@ public:
     void endSelection();
     void clearSelection();
     
+    // Hit-testing over texts and shapes (shapes draw on top of texts)
+    std::string pickElement(const glm::vec2& point) const;   // topmost element ID, or empty
+    size_t selectElementsInRect(const glm::vec2& cornerA, const glm::vec2& cornerB);
+    
     // Transform operations
     void startTransform(const glm::vec2& position);
     void updateTransform(const glm::vec2& position);
@@ -396,10 +464,15 @@ public:
     void render() const;
     void renderUI() const;
     
-    // Undo/Redo
+    // Undo/Redo. Each edit commits a new document version that shares every
+    // unchanged element with the one before it, so undo and redo are version
+    // switches that only touch the elements that differ.
     void undo();
     void redo();
     void clearHistory();
+    void setHistoryLimit(size_t maxVersions); // versions kept, including the current one
+    size_t getHistoryLimit() const { return _historyLimit; }
+    size_t getVersionCount() const { return _versions.size(); }
     
     // Save/Load
     void saveDesign(const std::string& filename) const;
@@ -426,6 +499,7 @@ private:
     bool _isTransforming = false;
     glm::vec2 _startPosition = glm::vec2(0.0f, 0.0f);
     glm::vec2 _currentPosition = glm::vec2(0.0f, 0.0f);
+    std::string _transformTarget; // element picked by startTransform()
     
     // Layer system
     struct Layer {
@@ -438,18 +512,24 @@ private:
     std::vector<Layer> _layers;
     int _activeLayer = 0;
     
-    // History system
-    struct HistoryEntry {
+    // History system: immutable snapshots of the document elements
+    struct DocumentVersion {
         std::string action;
-        std::string data; // JSON serialized data
-        float timestamp;
+        float timestamp = 0.0f;
+        PersistentMap<std::string, TextSystem::TextElement> texts;
+        PersistentMap<std::string, ShapeSystem::ShapeElement> shapes;
+        PersistentMap<std::string, EffectsSystem::Effect> effects;
     };
-    std::vector<HistoryEntry> _history;
-    size_t _historyIndex = 0;
+    std::deque<DocumentVersion> _versions; // oldest first, never empty
+    size_t _currentVersion = 0;
+    size_t _historyLimit = 100;
     
     // Helper methods
-    void saveHistoryEntry(const std::string& action, const std::string& data);
-    void clearFutureHistory();
+    void commitVersion(DocumentVersion version, const std::string& action);
+    void recordText(const std::string& id, const std::string& action);
+    void recordShape(const std::string& id, const std::string& action);
+    void recordEffect(const std::string& id, const std::string& action);
+    void switchToVersion(size_t index);
     ShapeSystem::ShapeType mapToolToShapeType(Tool::Type toolType) const;
     EffectsSystem::EffectType mapToolToEffectType(Tool::Type toolType) const;
 }; 
\ No newline at end of file
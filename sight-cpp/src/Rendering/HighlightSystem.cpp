@@ -4,20 +4,18 @@
 namespace Rendering {
 
 Object* HighlightSystem::s_selected = nullptr;
-std::unordered_set<std::string> HighlightSystem::s_lawIds = {};
+EntityNameSet HighlightSystem::s_lawIds;
 
 void HighlightSystem::setSelected(Object* obj) { s_selected = obj; }
 Object* HighlightSystem::getSelected() { return s_selected; }
 
 void HighlightSystem::setLawCandidateIds(const std::unordered_set<std::string>& ids) {
-    s_lawIds = ids;
+    s_lawIds.assign(ids.begin(), ids.end());
 }
 
 bool HighlightSystem::isLawCandidate(const Object* obj) {
-    if (!obj) return false;
-    const std::string& id = obj->getIdentifier();
-    if (id.empty()) return false;
-    return s_lawIds.find(id) != s_lawIds.end();
+    if (!obj || s_lawIds.empty()) return false;
+    return s_lawIds.contains(obj->entityId());
 }
 
 bool HighlightSystem::isSelected(const Object* obj) {
@@ -1,6 +1,8 @@
 #pragma once
 #include <unordered_set>
 #include <string>
+#include <vector>
+#include "Form/EntityRegistry.hpp"
 
 class Object;
 
@@ -17,7 +19,7 @@ public:
 
 private:
     static Object* s_selected;
-    static std::unordered_set<std::string> s_lawIds;
+    static EntityNameSet s_lawIds;
 };
 
 } // namespace Rendering
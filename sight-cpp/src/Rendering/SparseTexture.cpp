@@ -0,0 +1,372 @@
+#include "SparseTexture.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+int roundUpToPowerOfTwo(int value) {
+    int result = 1;
+    while (result < value) result <<= 1;
+    return result;
+}
+
+int log2Int(int value) {
+    int result = 0;
+    while ((1 << (result + 1)) <= value) ++result;
+    return result;
+}
+
+} // namespace
+
+SparseTexture::SparseTexture(int size, uint32_t baseRGBA, int tileSize) {
+    _tileSize = roundUpToPowerOfTwo(std::max(1, tileSize));
+    _size = roundUpToPowerOfTwo(std::max(size, _tileSize));
+    _tilesPerSide = _size / _tileSize;
+    _tileLevels = log2Int(_tileSize);
+    _levelCount = log2Int(_size) + 1;
+    _gpuSize = std::min(_size, MaxGPUSize);
+    _gpuShift = log2Int(_size / _gpuSize);
+    _tiles.resize(static_cast<size_t>(_tilesPerSide) * _tilesPerSide);
+    clear(baseRGBA);
+}
+
+void SparseTexture::clear(uint32_t baseRGBA) {
+    _baseColor = baseRGBA;
+    _baseTexel[0] = static_cast<uint8_t>(baseRGBA & 0xFF);
+    _baseTexel[1] = static_cast<uint8_t>((baseRGBA >> 8) & 0xFF);
+    _baseTexel[2] = static_cast<uint8_t>((baseRGBA >> 16) & 0xFF);
+    _baseTexel[3] = static_cast<uint8_t>((baseRGBA >> 24) & 0xFF);
+
+    for (auto& tile : _tiles) tile.reset();
+    _dirtyTiles.clear();
+    _releasedTiles.clear();
+    _residentCount = 0;
+    clearUndo();
+
+    _coarse.resize(_tiles.size() * 4);
+    for (size_t i = 0; i < _tiles.size(); ++i) {
+        std::memcpy(&_coarse[i * 4], _baseTexel, 4);
+    }
+    _coarseDirty = true;
+
+    // The base colour changed everywhere, so the GPU copy has to be refilled
+    _gpuAllocated = false;
+}
+
+SparseTexture::Tile* SparseTexture::tileFor(int x, int y) const {
+    return _tiles[static_cast<size_t>(y / _tileSize) * _tilesPerSide + (x / _tileSize)].get();
+}
+
+SparseTexture::Tile& SparseTexture::residentTile(size_t index) {
+    std::unique_ptr<Tile>& slot = _tiles[index];
+    if (_recording && (!slot || slot->stroke != _strokeSerial)) {
+        // First write of this stroke to the tile: keep what it looked like before
+        _undo.back().push_back({index, slot ? slot->pixels : std::vector<uint8_t>()});
+        if (slot) slot->stroke = _strokeSerial;
+    }
+    if (!slot) {
+        slot = std::make_unique<Tile>();
+        slot->pixels.resize(static_cast<size_t>(_tileSize) * _tileSize * 4);
+        for (size_t i = 0; i < slot->pixels.size(); i += 4) {
+            std::memcpy(&slot->pixels[i], _baseTexel, 4);
+        }
+        slot->dirty = false;
+        slot->stroke = _recording ? _strokeSerial : 0;
+        ++_residentCount;
+    }
+    if (!slot->dirty) {
+        slot->dirty = true;
+        _dirtyTiles.push_back(index);
+    }
+    return *slot;
+}
+
+void SparseTexture::releaseTile(size_t index) {
+    if (!_tiles[index]) return;
+    _tiles[index].reset();
+    --_residentCount;
+    std::memcpy(&_coarse[index * 4], _baseTexel, 4);
+    _coarseDirty = true;
+    _releasedTiles.push_back(index);
+}
+
+const uint8_t* SparseTexture::texel(int x, int y) const {
+    const Tile* tile = tileFor(x, y);
+    if (!tile) return _baseTexel;
+    int localX = x % _tileSize;
+    int localY = y % _tileSize;
+    return &tile->pixels[(static_cast<size_t>(localY) * _tileSize + localX) * 4];
+}
+
+uint8_t* SparseTexture::texelForWrite(int x, int y) {
+    size_t index = static_cast<size_t>(y / _tileSize) * _tilesPerSide + (x / _tileSize);
+    Tile* tile = _tiles[index].get();
+    if (!tile || !tile->dirty || (_recording && tile->stroke != _strokeSerial)) tile = &residentTile(index);
+    int localX = x % _tileSize;
+    int localY = y % _tileSize;
+    return &tile->pixels[(static_cast<size_t>(localY) * _tileSize + localX) * 4];
+}
+
+bool SparseTexture::isTileResident(int tileX, int tileY) const {
+    if (tileX < 0 || tileY < 0 || tileX >= _tilesPerSide || tileY >= _tilesPerSide) return false;
+    return _tiles[static_cast<size_t>(tileY) * _tilesPerSide + tileX] != nullptr;
+}
+
+const std::vector<uint8_t>* SparseTexture::getTilePixels(int tileX, int tileY) const {
+    if (!isTileResident(tileX, tileY)) return nullptr;
+    return &_tiles[static_cast<size_t>(tileY) * _tilesPerSide + tileX]->pixels;
+}
+
+void SparseTexture::setTilePixels(int tileX, int tileY, std::vector<uint8_t> pixels) {
+    if (tileX < 0 || tileY < 0 || tileX >= _tilesPerSide || tileY >= _tilesPerSide) return;
+    if (pixels.size() != static_cast<size_t>(_tileSize) * _tileSize * 4) return;
+    Tile& tile = residentTile(static_cast<size_t>(tileY) * _tilesPerSide + tileX);
+    tile.pixels = std::move(pixels);
+}
+
+size_t SparseTexture::getMemoryBytes() const {
+    size_t bytes = _tiles.size() * sizeof(std::unique_ptr<Tile>) + _coarse.size();
+    bytes += static_cast<size_t>(_residentCount) * (sizeof(Tile) + static_cast<size_t>(_tileSize) * _tileSize * 4);
+    return bytes;
+}
+
+void SparseTexture::resampleFrom(const SparseTexture& source) {
+    const int srcTile = source._tileSize;
+    for (int ty = 0; ty < source._tilesPerSide; ++ty) {
+        for (int tx = 0; tx < source._tilesPerSide; ++tx) {
+            if (!source.isTileResident(tx, ty)) continue;
+
+            if (_size >= source._size) {
+                // Scaling up: each source texel covers a block
+                int scale = _size / source._size;
+                for (int y = ty * srcTile; y < (ty + 1) * srcTile; ++y) {
+                    for (int x = tx * srcTile; x < (tx + 1) * srcTile; ++x) {
+                        const uint8_t* src = source.texel(x, y);
+                        if (std::memcmp(src, _baseTexel, 4) == 0) continue;
+                        for (int by = 0; by < scale; ++by) {
+                            for (int bx = 0; bx < scale; ++bx) {
+                                std::memcpy(texelForWrite(x * scale + bx, y * scale + by), src, 4);
+                            }
+                        }
+                    }
+                }
+                continue;
+            }
+
+            // Scaling down: each destination texel averages a block, which may
+            // reach into neighbouring (possibly unpainted) source tiles
+            int factor = source._size / _size;
+            int x0 = tx * srcTile / factor, x1 = ((tx + 1) * srcTile + factor - 1) / factor;
+            int y0 = ty * srcTile / factor, y1 = ((ty + 1) * srcTile + factor - 1) / factor;
+            for (int y = y0; y < y1; ++y) {
+                for (int x = x0; x < x1; ++x) {
+                    int sum[4] = {0, 0, 0, 0};
+                    for (int by = 0; by < factor; ++by) {
+                        for (int bx = 0; bx < factor; ++bx) {
+                            const uint8_t* src = source.texel(x * factor + bx, y * factor + by);
+                            for (int c = 0; c < 4; ++c) sum[c] += src[c];
+                        }
+                    }
+                    uint8_t avg[4];
+                    const int count = factor * factor;
+                    for (int c = 0; c < 4; ++c) avg[c] = static_cast<uint8_t>((sum[c] + count / 2) / count);
+                    if (std::memcmp(avg, _baseTexel, 4) == 0) continue;
+                    std::memcpy(texelForWrite(x, y), avg, 4);
+                }
+            }
+        }
+    }
+}
+
+void SparseTexture::beginStroke() {
+    ++_strokeSerial;
+    // A stroke that wrote nothing (a click off the face) leaves its record empty; reuse it
+    if (_undo.empty() || !_undo.back().empty()) _undo.emplace_back();
+    if (_undo.size() > MaxUndoStrokes) _undo.erase(_undo.begin());
+    _recording = true;
+}
+
+bool SparseTexture::undoStroke() {
+    while (!_undo.empty() && _undo.back().empty()) _undo.pop_back();
+    if (_undo.empty()) return false;
+
+    std::vector<SavedTile> saved = std::move(_undo.back());
+    _undo.pop_back();
+    // Restoring must not be recorded; the next stroke starts with beginStroke()
+    _recording = false;
+    for (SavedTile& tile : saved) {
+        if (tile.pixels.empty()) releaseTile(tile.index);
+        else residentTile(tile.index).pixels = std::move(tile.pixels);
+    }
+    return true;
+}
+
+void SparseTexture::clearUndo() {
+    _undo.clear();
+    _recording = false;
+}
+
+void SparseTexture::uploadToGPU(GLuint textureId) {
+    if (textureId == 0) return;
+
+    glBindTexture(GL_TEXTURE_2D, textureId);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    const bool retarget = !_gpuAllocated || _gpuTexture != textureId;
+    _gpuTexture = textureId;
+
+    if (_residentCount == 0) {
+        // Nothing painted: one texel of the base colour stands in for the face
+        if (retarget || _gpuMirror) allocateBaseOnly();
+        _dirtyTiles.clear();
+        _releasedTiles.clear();
+        return;
+    }
+
+    if (retarget || !_gpuMirror) {
+        allocateGPU();
+        // Every resident tile has to be streamed into the fresh storage
+        _dirtyTiles.clear();
+        _releasedTiles.clear();
+        for (size_t i = 0; i < _tiles.size(); ++i) {
+            if (_tiles[i]) {
+                _tiles[i]->dirty = true;
+                _dirtyTiles.push_back(i);
+            }
+        }
+    }
+
+    if (!_releasedTiles.empty()) {
+        // Tiles dropped by undo go back to the base colour on the GPU
+        Tile blank;
+        blank.pixels.resize(static_cast<size_t>(_tileSize) * _tileSize * 4);
+        for (size_t i = 0; i < blank.pixels.size(); i += 4) {
+            std::memcpy(&blank.pixels[i], _baseTexel, 4);
+        }
+        for (size_t index : _releasedTiles) {
+            if (!_tiles[index]) uploadTile(index, blank);
+        }
+        _releasedTiles.clear();
+    }
+
+    for (size_t index : _dirtyTiles) {
+        Tile* tile = _tiles[index].get();
+        if (tile && tile->dirty) uploadTile(index, *tile);
+    }
+    _dirtyTiles.clear();
+
+    if (_coarseDirty) {
+        uploadCoarseLevels();
+    }
+}
+
+void SparseTexture::allocateBaseOnly() {
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, _baseTexel);
+
+    _gpuAllocated = true;
+    _gpuMirror = false;
+}
+
+void SparseTexture::allocateGPU() {
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, _levelCount - 1 - _gpuShift);
+
+    // Allocate every mirrored level (virtual level `level` is GPU level
+    // level - _gpuShift) and fill the tile-resolution ones with the base colour
+    // one strip of tiles at a time, so no full-size staging buffer is needed
+    for (int level = _gpuShift; level < _levelCount; ++level) {
+        int levelSize = _size >> level;
+        glTexImage2D(GL_TEXTURE_2D, level - _gpuShift, GL_RGBA, levelSize, levelSize, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        if (level >= _tileLevels) continue; // covered by uploadCoarseLevels()
+
+        int stripHeight = _tileSize >> level;
+        std::vector<uint8_t>& strip = _mipScratch[0];
+        strip.resize(static_cast<size_t>(levelSize) * stripHeight * 4);
+        for (size_t i = 0; i < strip.size(); i += 4) {
+            std::memcpy(&strip[i], _baseTexel, 4);
+        }
+        for (int row = 0; row < _tilesPerSide; ++row) {
+            glTexSubImage2D(GL_TEXTURE_2D, level - _gpuShift, 0, row * stripHeight, levelSize, stripHeight,
+                            GL_RGBA, GL_UNSIGNED_BYTE, strip.data());
+        }
+    }
+    // The staging strip can be as large as a row of tiles; don't keep it around
+    std::vector<uint8_t>().swap(_mipScratch[0]);
+
+    _coarseDirty = true;
+    _gpuAllocated = true;
+    _gpuMirror = true;
+}
+
+void SparseTexture::uploadTile(size_t index, Tile& tile) {
+    int tileX = static_cast<int>(index % _tilesPerSide);
+    int tileY = static_cast<int>(index / _tilesPerSide);
+
+    if (_gpuShift == 0) {
+        glTexSubImage2D(GL_TEXTURE_2D, 0, tileX * _tileSize, tileY * _tileSize, _tileSize, _tileSize,
+                        GL_RGBA, GL_UNSIGNED_BYTE, tile.pixels.data());
+    }
+
+    // Lower mips of this tile's footprint, built from the tile alone. Levels
+    // finer than the GPU mirror are only stepping stones.
+    const uint8_t* src = tile.pixels.data();
+    int srcSize = _tileSize;
+    for (int level = 1; level <= _tileLevels; ++level) {
+        std::vector<uint8_t>& dst = _mipScratch[level & 1];
+        downsample(src, srcSize, dst);
+        srcSize /= 2;
+        src = dst.data();
+        if (level < _tileLevels && level >= _gpuShift) {
+            glTexSubImage2D(GL_TEXTURE_2D, level - _gpuShift, tileX * srcSize, tileY * srcSize, srcSize, srcSize,
+                            GL_RGBA, GL_UNSIGNED_BYTE, src);
+        }
+    }
+
+    // The final 1×1 reduction is this tile's texel in the coarse grid
+    std::memcpy(&_coarse[index * 4], src, 4);
+    _coarseDirty = true;
+    tile.dirty = false;
+}
+
+void SparseTexture::uploadCoarseLevels() {
+    // Level _tileLevels has exactly one texel per tile; coarser levels reduce that grid
+    const uint8_t* src = _coarse.data();
+    int srcSize = _tilesPerSide;
+    if (_tileLevels >= _gpuShift) {
+        glTexSubImage2D(GL_TEXTURE_2D, _tileLevels - _gpuShift, 0, 0, srcSize, srcSize, GL_RGBA, GL_UNSIGNED_BYTE, src);
+    }
+
+    for (int level = _tileLevels + 1; level < _levelCount; ++level) {
+        std::vector<uint8_t>& dst = _mipScratch[level & 1];
+        downsample(src, srcSize, dst);
+        srcSize /= 2;
+        src = dst.data();
+        if (level >= _gpuShift) {
+            glTexSubImage2D(GL_TEXTURE_2D, level - _gpuShift, 0, 0, srcSize, srcSize, GL_RGBA, GL_UNSIGNED_BYTE, src);
+        }
+    }
+    _coarseDirty = false;
+}
+
+void SparseTexture::downsample(const uint8_t* src, int srcSize, std::vector<uint8_t>& dst) {
+    int dstSize = std::max(1, srcSize / 2);
+    dst.resize(static_cast<size_t>(dstSize) * dstSize * 4);
+    for (int y = 0; y < dstSize; ++y) {
+        for (int x = 0; x < dstSize; ++x) {
+            const uint8_t* a = src + ((static_cast<size_t>(y) * 2) * srcSize + x * 2) * 4;
+            const uint8_t* b = a + static_cast<size_t>(srcSize) * 4;
+            uint8_t* out = &dst[(static_cast<size_t>(y) * dstSize + x) * 4];
+            for (int c = 0; c < 4; ++c) {
+                out[c] = static_cast<uint8_t>((a[c] + a[c + 4] + b[c] + b[c + 4] + 2) / 4);
+            }
+        }
+    }
+}
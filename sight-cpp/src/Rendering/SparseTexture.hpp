@@ -0,0 +1,118 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+#include <GLFW/glfw3.h>
+
+// Sparse, tiled RGBA8 texture for high-resolution face painting.
+// Only tiles that have been painted are allocated; every other texel reads as
+// a solid base colour, so CPU memory follows the painted area instead of the
+// virtual resolution.
+//
+// The GPU copy is a mirror of at most MaxGPUSize² texels. Until something is
+// painted it is a single texel of the base colour. Once a tile is resident the
+// mirror holds the virtual image downsampled to min(size, MaxGPUSize) with a
+// full mip chain (up to ~21 MB at 2048²). Only dirty tiles are streamed into it,
+// and the mips are rebuilt from those tiles rather than from the whole image.
+// Detail above MaxGPUSize is kept on the CPU (painting, saving) but not drawn.
+class SparseTexture {
+public:
+    static constexpr int DefaultTileSize = 64;
+    static constexpr int MaxGPUSize = 2048;
+    // Strokes kept for undoStroke(); older ones are forgotten
+    static constexpr size_t MaxUndoStrokes = 32;
+
+    // `size` is rounded up to a power of two no smaller than the tile size.
+    SparseTexture(int size = 2048, uint32_t baseRGBA = 0xFFFFFFFF, int tileSize = DefaultTileSize);
+
+    int getSize() const { return _size; }
+    int getTileSize() const { return _tileSize; }
+    int getTilesPerSide() const { return _tilesPerSide; }
+    uint32_t getBaseColor() const { return _baseColor; }
+
+    // Drop every tile and make the whole texture the given colour. Also clears undo.
+    void clear(uint32_t baseRGBA);
+
+    // Copy another texture's paint into this one, scaling it to this size.
+    // Only the source's resident tiles are read.
+    void resampleFrom(const SparseTexture& source);
+
+    // Per-stroke undo. After beginStroke(), the first write to each tile saves
+    // that tile's previous contents, so undoing costs one tile copy per tile
+    // the stroke touched. undoStroke() returns false when there is nothing to undo.
+    void beginStroke();
+    bool undoStroke();
+    void clearUndo();
+
+    // Texel access. Unpainted texels read as the base colour; writing allocates the tile.
+    const uint8_t* texel(int x, int y) const;
+    uint8_t* texelForWrite(int x, int y);
+
+    // Tile access (serialization, diagnostics)
+    bool isTileResident(int tileX, int tileY) const;
+    const std::vector<uint8_t>* getTilePixels(int tileX, int tileY) const;
+    void setTilePixels(int tileX, int tileY, std::vector<uint8_t> pixels);
+    int getResidentTileCount() const { return _residentCount; }
+    size_t getMemoryBytes() const;
+
+    // Stream changes into `textureId`. With no resident tiles the texture is one
+    // base-colour texel. The first upload after a tile becomes resident allocates
+    // the capped mirror (see above) filled with the base colour; later calls only
+    // upload tiles painted since the previous upload.
+    void uploadToGPU(GLuint textureId);
+    int getGPUSize() const { return _gpuMirror ? _gpuSize : 1; }
+
+private:
+    struct Tile {
+        std::vector<uint8_t> pixels;
+        bool dirty = true;
+        uint32_t stroke = 0;   // last stroke that saved this tile for undo
+    };
+
+    // Tiles as they were before one stroke first wrote them. An empty
+    // `pixels` means the tile was not resident.
+    struct SavedTile {
+        size_t index;
+        std::vector<uint8_t> pixels;
+    };
+
+    int _size;
+    int _tileSize;
+    int _tilesPerSide;
+    int _tileLevels;      // mip levels that still fit inside one tile (log2(tileSize))
+    int _levelCount;      // total mip levels down to 1×1
+    int _gpuSize;         // level-0 size of the GPU mirror
+    int _gpuShift;        // virtual mip level that becomes GPU level 0
+    uint32_t _baseColor;
+    uint8_t _baseTexel[4];
+
+    std::vector<std::unique_ptr<Tile>> _tiles;   // row-major tile grid, null = not resident
+    std::vector<size_t> _dirtyTiles;             // indices into _tiles awaiting upload
+    std::vector<size_t> _releasedTiles;          // dropped by undo; GPU still shows their paint
+    int _residentCount = 0;
+
+    std::vector<std::vector<SavedTile>> _undo;   // oldest first
+    uint32_t _strokeSerial = 0;
+    bool _recording = false;                     // between beginStroke() and the next undo/clear
+
+    // One texel per tile (the tile's average). Mip levels coarser than a tile
+    // are built from this grid instead of from full-resolution texels.
+    std::vector<uint8_t> _coarse;
+    bool _coarseDirty = true;
+    bool _gpuAllocated = false;
+    bool _gpuMirror = false;   // false: the GPU texture is the 1×1 base colour
+    GLuint _gpuTexture = 0;
+    std::vector<uint8_t> _mipScratch[2];
+
+    Tile* tileFor(int x, int y) const;
+    Tile& residentTile(size_t index);
+    void releaseTile(size_t index);
+    void allocateBaseOnly();
+    void allocateGPU();
+    void uploadTile(size_t index, Tile& tile);
+    void uploadCoarseLevels();
+
+    static void downsample(const uint8_t* src, int srcSize, std::vector<uint8_t>& dst);
+};
@@ -0,0 +1,191 @@
+#include "StrokeCodec.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+namespace {
+
+float distanceToSegment(const glm::vec2& p, const glm::vec2& a, const glm::vec2& b, float& t) {
+    glm::vec2 ab = b - a;
+    float lenSq = glm::dot(ab, ab);
+    t = lenSq > 0.0f ? std::clamp(glm::dot(p - a, ab) / lenSq, 0.0f, 1.0f) : 0.0f;
+    return glm::length(p - (a + ab * t));
+}
+
+// Iterative RDP; `pressure` may be null
+std::vector<size_t> rdp(const glm::vec2* points, const float* pressure, size_t count, float tolerance) {
+    std::vector<size_t> kept;
+    if (count == 0) return kept;
+    if (count <= 2 || tolerance <= 0.0f) {
+        kept.resize(count);
+        for (size_t i = 0; i < count; ++i) kept[i] = i;
+        return kept;
+    }
+
+    std::vector<bool> keep(count, false);
+    keep[0] = keep[count - 1] = true;
+    std::vector<std::pair<size_t, size_t>> stack;
+    stack.emplace_back(0, count - 1);
+
+    while (!stack.empty()) {
+        auto [first, last] = stack.back();
+        stack.pop_back();
+        if (last <= first + 1) continue;
+
+        float worst = tolerance;
+        size_t split = 0;
+        for (size_t i = first + 1; i < last; ++i) {
+            float t;
+            float d = distanceToSegment(points[i], points[first], points[last], t);
+            if (pressure) {
+                float expected = pressure[first] + (pressure[last] - pressure[first]) * t;
+                // Scale so the pressure threshold competes on equal terms with distance
+                d = std::max(d, std::fabs(pressure[i] - expected) * (tolerance / StrokeCodec::PressureTolerance));
+            }
+            if (d > worst) {
+                worst = d;
+                split = i;
+            }
+        }
+        if (split != 0) {
+            keep[split] = true;
+            stack.emplace_back(first, split);
+            stack.emplace_back(split, last);
+        }
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        if (keep[i]) kept.push_back(i);
+    }
+    return kept;
+}
+
+void putVarint(std::vector<uint8_t>& out, int32_t value) {
+    uint32_t zigzag = (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+    while (zigzag >= 0x80) {
+        out.push_back(static_cast<uint8_t>(zigzag | 0x80));
+        zigzag >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(zigzag));
+}
+
+bool getVarint(const std::vector<uint8_t>& in, size_t& pos, int32_t& value) {
+    uint32_t zigzag = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        if (pos >= in.size()) return false;
+        uint8_t byte = in[pos++];
+        zigzag |= static_cast<uint32_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            value = static_cast<int32_t>(zigzag >> 1) ^ -static_cast<int32_t>(zigzag & 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+void putFloat(std::vector<uint8_t>& out, float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, 4);
+    for (int i = 0; i < 4; ++i) out.push_back(static_cast<uint8_t>(bits >> (8 * i)));
+}
+
+float getFloat(const uint8_t* in) {
+    uint32_t bits = in[0] | (in[1] << 8) | (in[2] << 16) | (static_cast<uint32_t>(in[3]) << 24);
+    float value;
+    std::memcpy(&value, &bits, 4);
+    return value;
+}
+
+} // namespace
+
+std::vector<size_t> StrokeCodec::simplify(const std::vector<Sample>& samples, float tolerance) {
+    std::vector<glm::vec2> points(samples.size());
+    std::vector<float> pressure(samples.size());
+    for (size_t i = 0; i < samples.size(); ++i) {
+        points[i] = samples[i].position;
+        pressure[i] = samples[i].pressure;
+    }
+    return rdp(points.data(), pressure.data(), points.size(), tolerance);
+}
+
+std::vector<size_t> StrokeCodec::simplify(const std::vector<glm::vec2>& points, float tolerance) {
+    return rdp(points.data(), nullptr, points.size(), tolerance);
+}
+
+StrokeCodec::Encoded StrokeCodec::encode(const std::vector<Sample>& samples, float tolerance, bool simplifyPath) {
+    Encoded encoded;
+    if (samples.empty()) return encoded;
+
+    // Half the budget goes to simplification and half to the grid. Rounding to a
+    // grid of step q moves a point by at most q·√2/2, so q = tolerance/2 keeps the
+    // total comfortably under `tolerance`.
+    float half = std::max(tolerance, 1e-6f) * 0.5f;
+    std::vector<size_t> kept = simplify(samples, simplifyPath ? half : 0.0f);
+
+    encoded.quantum = half;
+    encoded.origin = samples[kept.front()].position;
+    encoded.startTime = samples[kept.front()].time;
+    encoded.pointCount = static_cast<uint32_t>(kept.size());
+    encoded.data.reserve(kept.size() * 4);
+
+    // Deltas are taken between quantized absolute values so rounding never accumulates
+    int32_t prevX = 0, prevY = 0, prevP = 0, prevMs = 0;
+    for (size_t index : kept) {
+        const Sample& s = samples[index];
+        int32_t qx = static_cast<int32_t>(std::lround((s.position.x - encoded.origin.x) / encoded.quantum));
+        int32_t qy = static_cast<int32_t>(std::lround((s.position.y - encoded.origin.y) / encoded.quantum));
+        int32_t qp = static_cast<int32_t>(std::lround(std::clamp(s.pressure, 0.0f, 1.0f) * 255.0f));
+        int32_t ms = std::max(prevMs, static_cast<int32_t>(std::lround((s.time - encoded.startTime) * 1000.0f)));
+        putVarint(encoded.data, qx - prevX);
+        putVarint(encoded.data, qy - prevY);
+        putVarint(encoded.data, qp - prevP);
+        putVarint(encoded.data, ms - prevMs);
+        prevX = qx; prevY = qy; prevP = qp; prevMs = ms;
+    }
+    encoded.data.shrink_to_fit();
+    return encoded;
+}
+
+std::vector<StrokeCodec::Sample> StrokeCodec::decode(const Encoded& encoded) {
+    std::vector<Sample> samples;
+    samples.reserve(encoded.pointCount);
+    size_t pos = 0;
+    int32_t x = 0, y = 0, p = 0, ms = 0;
+    for (uint32_t i = 0; i < encoded.pointCount; ++i) {
+        int32_t dx, dy, dp, dms;
+        if (!getVarint(encoded.data, pos, dx) || !getVarint(encoded.data, pos, dy) ||
+            !getVarint(encoded.data, pos, dp) || !getVarint(encoded.data, pos, dms)) {
+            break; // truncated data: return what decoded cleanly
+        }
+        x += dx; y += dy; p += dp; ms += dms;
+        Sample s;
+        s.position = encoded.origin + glm::vec2(static_cast<float>(x), static_cast<float>(y)) * encoded.quantum;
+        s.pressure = std::clamp(p, 0, 255) / 255.0f;
+        s.time = encoded.startTime + ms / 1000.0f;
+        samples.push_back(s);
+    }
+    return samples;
+}
+
+std::vector<uint8_t> StrokeCodec::toBytes(const Encoded& encoded) {
+    std::vector<uint8_t> bytes;
+    bytes.reserve(20 + encoded.data.size());
+    putFloat(bytes, encoded.quantum);
+    putFloat(bytes, encoded.origin.x);
+    putFloat(bytes, encoded.origin.y);
+    putFloat(bytes, encoded.startTime);
+    for (int i = 0; i < 4; ++i) bytes.push_back(static_cast<uint8_t>(encoded.pointCount >> (8 * i)));
+    bytes.insert(bytes.end(), encoded.data.begin(), encoded.data.end());
+    return bytes;
+}
+
+bool StrokeCodec::fromBytes(const std::vector<uint8_t>& bytes, Encoded& out) {
+    if (bytes.size() < 20) return false;
+    out.quantum = getFloat(&bytes[0]);
+    out.origin = glm::vec2(getFloat(&bytes[4]), getFloat(&bytes[8]));
+    out.startTime = getFloat(&bytes[12]);
+    out.pointCount = bytes[16] | (bytes[17] << 8) | (bytes[18] << 16) | (static_cast<uint32_t>(bytes[19]) << 24);
+    out.data.assign(bytes.begin() + 20, bytes.end());
+    return out.quantum > 0.0f || out.pointCount <= 1;
+}
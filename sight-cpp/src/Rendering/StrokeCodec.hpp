@@ -0,0 +1,46 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <glm/glm.hpp>
+
+// Compact storage for finished strokes.
+// encode() drops points with Ramer-Douglas-Peucker, then stores the survivors
+// quantized to a grid and delta-encoded as zigzag varints, together with an
+// 8-bit pressure and a millisecond timestamp per point. decode() reproduces
+// every kept point within `tolerance` of the input polyline.
+class StrokeCodec {
+public:
+    struct Sample {
+        glm::vec2 position{0.0f};
+        float pressure = 1.0f;   // 0..1
+        float time = 0.0f;       // seconds
+    };
+
+    struct Encoded {
+        float quantum = 0.0f;        // position grid step
+        glm::vec2 origin{0.0f};      // first point, unquantized
+        float startTime = 0.0f;
+        uint32_t pointCount = 0;
+        std::vector<uint8_t> data;   // per point: dx, dy, dpressure, dt(ms)
+    };
+
+    // Pressure changes smaller than this are treated as linear by simplify()
+    static constexpr float PressureTolerance = 1.0f / 32.0f;
+
+    // Indices of the samples RDP keeps at the given distance tolerance. The first
+    // and last samples are always kept. Samples whose pressure departs from the
+    // interpolated value by more than PressureTolerance are kept as well.
+    static std::vector<size_t> simplify(const std::vector<Sample>& samples, float tolerance);
+    static std::vector<size_t> simplify(const std::vector<glm::vec2>& points, float tolerance);
+
+    // With `simplifyPath` false every sample is kept and only quantized; use it for
+    // paths that were already simplified so repeated saves don't keep eroding them.
+    static Encoded encode(const std::vector<Sample>& samples, float tolerance, bool simplifyPath = true);
+    static std::vector<Sample> decode(const Encoded& encoded);
+
+    // Flat little-endian byte form for saving
+    static std::vector<uint8_t> toBytes(const Encoded& encoded);
+    static bool fromBytes(const std::vector<uint8_t>& bytes, Encoded& out);
+};
@@ -0,0 +1,166 @@
+#include "StrokeRenderer.hpp"
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+uint8_t toByte(float value) {
+    return static_cast<uint8_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+}
+
+} // namespace
+
+StrokeRenderer::~StrokeRenderer() {
+    releaseGPU();
+}
+
+StrokeRenderer::StrokeRenderer(StrokeRenderer&& other) noexcept
+    : _chunks(std::move(other._chunks)), _strokeCount(other._strokeCount),
+      _revision(other._revision), _synced(other._synced) {
+    other._chunks.clear();
+    other._strokeCount = 0;
+    other._synced = false;
+}
+
+StrokeRenderer& StrokeRenderer::operator=(StrokeRenderer&& other) noexcept {
+    if (this != &other) {
+        releaseGPU();
+        _chunks = std::move(other._chunks);
+        _strokeCount = other._strokeCount;
+        _revision = other._revision;
+        _synced = other._synced;
+        other._chunks.clear();
+        other._strokeCount = 0;
+        other._synced = false;
+    }
+    return *this;
+}
+
+void StrokeRenderer::strokeAppended(uint64_t revision) {
+    if (!_synced || revision != _revision + 1) {
+        // Missed changes somewhere; draw() will resynchronise
+        return;
+    }
+    if (_chunks.empty() || _chunks.back().strokeCount >= StrokesPerChunk) {
+        Chunk chunk;
+        chunk.firstStroke = _strokeCount;
+        _chunks.push_back(std::move(chunk));
+    }
+    Chunk& last = _chunks.back();
+    ++last.strokeCount;
+    last.dirty = true;
+    ++_strokeCount;
+    _revision = revision;
+}
+
+void StrokeRenderer::strokeRemoved(size_t index, uint64_t revision) {
+    if (!_synced || revision != _revision + 1 || index >= _strokeCount) return;
+    for (size_t i = 0; i < _chunks.size(); ++i) {
+        Chunk& chunk = _chunks[i];
+        if (index < chunk.firstStroke || index >= chunk.firstStroke + chunk.strokeCount) continue;
+
+        --chunk.strokeCount;
+        chunk.dirty = true;
+        // Later chunks keep their baked geometry; only their start index moves
+        for (size_t j = i + 1; j < _chunks.size(); ++j) --_chunks[j].firstStroke;
+        if (chunk.strokeCount == 0) {
+            if (chunk.vbo != 0) glDeleteBuffers(1, &chunk.vbo);
+            _chunks.erase(_chunks.begin() + i);
+        }
+        break;
+    }
+    --_strokeCount;
+    _revision = revision;
+}
+
+void StrokeRenderer::draw(const std::vector<ArtStroke>& strokes, uint64_t revision, float lineWidthOverride) {
+    if (!_synced || revision != _revision || strokes.size() != _strokeCount) {
+        resetChunks(strokes.size(), revision);
+    }
+    if (_chunks.empty()) return;
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+
+    for (auto& chunk : _chunks) {
+        if (chunk.dirty) rebuildChunk(chunk, strokes);
+        if (chunk.vertexCount == 0) continue;
+
+        glBindBuffer(GL_ARRAY_BUFFER, chunk.vbo);
+        glVertexPointer(2, GL_FLOAT, sizeof(Vertex), reinterpret_cast<const void*>(offsetof(Vertex, x)));
+        glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), reinterpret_cast<const void*>(offsetof(Vertex, r)));
+
+        if (lineWidthOverride > 0.0f) {
+            glLineWidth(lineWidthOverride);
+            glDrawArrays(GL_LINES, 0, chunk.vertexCount);
+            continue;
+        }
+        for (const auto& batch : chunk.batches) {
+            glLineWidth(batch.lineWidth);
+            glDrawArrays(GL_LINES, batch.first, batch.count);
+        }
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+}
+
+void StrokeRenderer::rebuildChunk(Chunk& chunk, const std::vector<ArtStroke>& strokes) {
+    size_t begin = std::min(chunk.firstStroke, strokes.size());
+    size_t end = std::min(chunk.firstStroke + chunk.strokeCount, strokes.size());
+
+    // Order by line width so each width is one contiguous draw
+    std::vector<size_t> order;
+    order.reserve(end - begin);
+    for (size_t i = begin; i < end; ++i) {
+        if (strokes[i].points.size() >= 4) order.push_back(i);
+    }
+    std::stable_sort(order.begin(), order.end(), [&strokes](size_t a, size_t b) {
+        return strokes[a].lineWidth < strokes[b].lineWidth;
+    });
+
+    _scratch.clear();
+    chunk.batches.clear();
+    for (size_t index : order) {
+        const ArtStroke& stroke = strokes[index];
+        if (chunk.batches.empty() || chunk.batches.back().lineWidth != stroke.lineWidth) {
+            chunk.batches.push_back({stroke.lineWidth, static_cast<GLint>(_scratch.size()), 0});
+        }
+        uint8_t r = toByte(stroke.r), g = toByte(stroke.g), b = toByte(stroke.b);
+        // Line strip -> independent segments, so strokes can share one draw call
+        for (size_t p = 0; p + 3 < stroke.points.size(); p += 2) {
+            _scratch.push_back({stroke.points[p], stroke.points[p + 1], r, g, b, 255});
+            _scratch.push_back({stroke.points[p + 2], stroke.points[p + 3], r, g, b, 255});
+        }
+        chunk.batches.back().count = static_cast<GLsizei>(_scratch.size()) - chunk.batches.back().first;
+    }
+
+    chunk.vertexCount = static_cast<GLsizei>(_scratch.size());
+    if (chunk.vertexCount > 0) {
+        if (chunk.vbo == 0) glGenBuffers(1, &chunk.vbo);
+        glBindBuffer(GL_ARRAY_BUFFER, chunk.vbo);
+        glBufferData(GL_ARRAY_BUFFER, _scratch.size() * sizeof(Vertex), _scratch.data(), GL_STATIC_DRAW);
+    }
+    chunk.dirty = false;
+}
+
+void StrokeRenderer::resetChunks(size_t strokeCount, uint64_t revision) {
+    releaseGPU();
+    for (size_t first = 0; first < strokeCount; first += StrokesPerChunk) {
+        Chunk chunk;
+        chunk.firstStroke = first;
+        chunk.strokeCount = std::min(StrokesPerChunk, strokeCount - first);
+        _chunks.push_back(std::move(chunk));
+    }
+    _strokeCount = strokeCount;
+    _revision = revision;
+    _synced = true;
+}
+
+void StrokeRenderer::releaseGPU() {
+    for (auto& chunk : _chunks) {
+        if (chunk.vbo != 0) glDeleteBuffers(1, &chunk.vbo);
+    }
+    _chunks.clear();
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <GLFW/glfw3.h>
+
+// A finished 2D line stroke (zone canvas art)
+struct ArtStroke {
+    std::vector<float> points;   // x0,y0,x1,y1,...
+    float r = 1.0f, g = 1.0f, b = 1.0f;
+    float lineWidth = 2.0f;
+};
+
+// Bakes finished strokes into vertex buffers so the canvas costs a handful of
+// draw calls per frame instead of one glBegin/glEnd per stroke. Strokes are
+// grouped into fixed-size chunks by index; appending or removing a stroke only
+// rebuilds the chunk it belongs to. The stroke in progress is not cached.
+class StrokeRenderer {
+public:
+    static constexpr size_t StrokesPerChunk = 64;
+
+    StrokeRenderer() = default;
+    ~StrokeRenderer();
+    StrokeRenderer(const StrokeRenderer&) = delete;
+    StrokeRenderer& operator=(const StrokeRenderer&) = delete;
+    StrokeRenderer(StrokeRenderer&& other) noexcept;
+    StrokeRenderer& operator=(StrokeRenderer&& other) noexcept;
+
+    // Change notifications carry the owner's revision of the stroke list, bumped
+    // once per change. One that does not directly follow the last revision seen
+    // means a change went unreported (an in-place edit, the vector replaced
+    // wholesale); draw() then rebuilds everything.
+    void strokeAppended(uint64_t revision);
+    void strokeRemoved(size_t index, uint64_t revision);
+
+    // Draw every finished stroke as of `revision`. A positive `lineWidthOverride`
+    // replaces the stored per-stroke widths.
+    void draw(const std::vector<ArtStroke>& strokes, uint64_t revision, float lineWidthOverride = 0.0f);
+
+private:
+    struct Vertex {
+        float x, y;
+        uint8_t r, g, b, a;
+    };
+
+    // Consecutive vertices sharing one line width
+    struct Batch {
+        float lineWidth;
+        GLint first;
+        GLsizei count;
+    };
+
+    struct Chunk {
+        size_t firstStroke = 0;
+        size_t strokeCount = 0;
+        GLuint vbo = 0;
+        GLsizei vertexCount = 0;
+        std::vector<Batch> batches;
+        bool dirty = true;
+    };
+
+    std::vector<Chunk> _chunks;
+    size_t _strokeCount = 0;
+    uint64_t _revision = 0;     // owner revision the chunks reflect
+    bool _synced = false;       // false until the first draw() bakes the list
+    std::vector<Vertex> _scratch;
+
+    void rebuildChunk(Chunk& chunk, const std::vector<ArtStroke>& strokes);
+    void resetChunks(size_t strokeCount, uint64_t revision);
+    void releaseGPU();
+};
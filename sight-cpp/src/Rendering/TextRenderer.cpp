@@ -0,0 +1,256 @@
+#include "TextRenderer.hpp"
+#include "Form/Object/Formation/Menu/stb_easy_font.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace {
+
+// Atlas geometry. Glyph quads from stb_easy_font fit in an 8x10 unit box; each
+// cell adds the distance-field spread on every side.
+constexpr int TexelsPerUnit = 4;
+constexpr float Spread = 1.5f;                  // font units on each side of an edge
+constexpr float CellUnitsW = 8.0f + 2.0f * Spread;
+constexpr float CellUnitsH = 10.0f + 2.0f * Spread;
+constexpr int CellW = static_cast<int>(CellUnitsW * TexelsPerUnit);
+constexpr int CellH = static_cast<int>(CellUnitsH * TexelsPerUnit);
+constexpr int AtlasColumns = 11;
+constexpr int AtlasSize = 512;
+constexpr int GlyphCount = 95;
+
+// Cached layouts not drawn for this many flushes are dropped
+constexpr uint64_t EvictAfterFlushes = 600;
+
+struct Rect {
+    float x0, y0, x1, y1;
+};
+
+// Signed distance to a union of rectangles: negative inside
+float signedDistance(const std::vector<Rect>& rects, float px, float py) {
+    float best = 1e9f;
+    for (const Rect& r : rects) {
+        float dx = std::max(r.x0 - px, px - r.x1);
+        float dy = std::max(r.y0 - py, py - r.y1);
+        float d = (dx > 0.0f || dy > 0.0f)
+            ? std::sqrt(std::max(dx, 0.0f) * std::max(dx, 0.0f) + std::max(dy, 0.0f) * std::max(dy, 0.0f))
+            : std::max(dx, dy);
+        best = std::min(best, d);
+    }
+    return best;
+}
+
+} // namespace
+
+TextRenderer& TextRenderer::instance() {
+    static TextRenderer renderer;
+    return renderer;
+}
+
+TextRenderer::TextRenderer() {
+    buildAtlas();
+}
+
+// The GL context is usually gone by static destruction; releaseGPU() is explicit
+TextRenderer::~TextRenderer() = default;
+
+int TextRenderer::glyphIndex(char c) {
+    // stb_easy_font only covers printable ASCII
+    if (c < ' ' || c > '~') c = '?';
+    return c - ' ';
+}
+
+void TextRenderer::buildAtlas() {
+    _atlasPixels.assign(AtlasSize * AtlasSize, 0);
+    std::vector<Rect> rects;
+    char vertices[4096];
+
+    for (int i = 0; i < GlyphCount; ++i) {
+        char text[2] = {static_cast<char>(' ' + i), 0};
+        Glyph& glyph = _glyphs[i];
+        glyph.advance = static_cast<float>(stb_easy_font_width(text));
+
+        // stb_easy_font emits one quad (4 verts, 16 bytes each) per segment
+        int quads = stb_easy_font_print(0.0f, 0.0f, text, nullptr, vertices, sizeof(vertices));
+        rects.clear();
+        for (int q = 0; q < quads; ++q) {
+            const float* v0 = reinterpret_cast<const float*>(vertices + q * 64);
+            const float* v2 = reinterpret_cast<const float*>(vertices + q * 64 + 32);
+            rects.push_back({v0[0], v0[1], v2[0], v2[1]});
+        }
+        glyph.empty = rects.empty();
+        if (glyph.empty) continue;
+
+        int cellX = (i % AtlasColumns) * CellW;
+        int cellY = (i / AtlasColumns) * CellH;
+        for (int ty = 0; ty < CellH; ++ty) {
+            for (int tx = 0; tx < CellW; ++tx) {
+                float px = (tx + 0.5f) / TexelsPerUnit - Spread;
+                float py = (ty + 0.5f) / TexelsPerUnit - Spread;
+                // 0.5 on the outline, rising inside; alpha testing at 0.5 recovers the shape
+                float value = 0.5f - signedDistance(rects, px, py) / (2.0f * Spread);
+                _atlasPixels[(cellY + ty) * AtlasSize + cellX + tx] =
+                    static_cast<uint8_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+            }
+        }
+        glyph.u0 = static_cast<float>(cellX) / AtlasSize;
+        glyph.v0 = static_cast<float>(cellY) / AtlasSize;
+        glyph.u1 = static_cast<float>(cellX + CellW) / AtlasSize;
+        glyph.v1 = static_cast<float>(cellY + CellH) / AtlasSize;
+    }
+}
+
+glm::vec2 TextRenderer::measure(const std::string& text, float scale) const {
+    float width = 0.0f, lineWidth = 0.0f;
+    int lines = 1;
+    for (char c : text) {
+        if (c == '\n') {
+            width = std::max(width, lineWidth);
+            lineWidth = 0.0f;
+            ++lines;
+            continue;
+        }
+        lineWidth += _glyphs[glyphIndex(c)].advance;
+    }
+    width = std::max(width, lineWidth);
+    return glm::vec2(width, lines * LineHeight) * scale;
+}
+
+TextRenderer::CachedText& TextRenderer::layout(const std::string& text) {
+    auto it = _cache.find(text);
+    if (it == _cache.end()) {
+        CachedText cached;
+        cached.vertices.reserve(text.size() * 4);
+        float penX = 0.0f, penY = 0.0f;
+        for (char c : text) {
+            if (c == '\n') {
+                penX = 0.0f;
+                penY += LineHeight;
+                continue;
+            }
+            const Glyph& glyph = _glyphs[glyphIndex(c)];
+            if (!glyph.empty) {
+                float x0 = penX - Spread, y0 = penY - Spread;
+                float x1 = x0 + CellUnitsW, y1 = y0 + CellUnitsH;
+                cached.vertices.push_back({x0, y0, glyph.u0, glyph.v0});
+                cached.vertices.push_back({x1, y0, glyph.u1, glyph.v0});
+                cached.vertices.push_back({x1, y1, glyph.u1, glyph.v1});
+                cached.vertices.push_back({x0, y1, glyph.u0, glyph.v1});
+            }
+            penX += glyph.advance;
+        }
+        it = _cache.emplace(text, std::move(cached)).first;
+    }
+    it->second.lastUsed = _flushCount;
+    return it->second;
+}
+
+void TextRenderer::queue(const std::string& text, float x, float y, const glm::vec3& color, float scale) {
+    if (text.empty() || scale <= 0.0f) return;
+    auto toByte = [](float v) { return static_cast<uint8_t>(std::clamp(v, 0.0f, 1.0f) * 255.0f + 0.5f); };
+    _queue.push_back({&layout(text), x, y, scale, toByte(color.r), toByte(color.g), toByte(color.b)});
+}
+
+void TextRenderer::upload(CachedText& text) {
+    text.vertexCount = static_cast<GLsizei>(text.vertices.size());
+    if (text.vertexCount > 0) {
+        glGenBuffers(1, &text.vbo);
+        glBindBuffer(GL_ARRAY_BUFFER, text.vbo);
+        glBufferData(GL_ARRAY_BUFFER, text.vertices.size() * sizeof(Vertex), text.vertices.data(), GL_STATIC_DRAW);
+    }
+    text.vertices = std::vector<Vertex>();
+}
+
+void TextRenderer::flush(int framebufferWidth, int framebufferHeight) {
+    ++_flushCount;
+    if (_queue.empty()) {
+        evictUnused();
+        return;
+    }
+
+    if (_atlasTexture == 0) {
+        glGenTextures(1, &_atlasTexture);
+        glBindTexture(GL_TEXTURE_2D, _atlasTexture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, AtlasSize, AtlasSize, 0, GL_ALPHA, GL_UNSIGNED_BYTE, _atlasPixels.data());
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    }
+
+    glPushAttrib(GL_ENABLE_BIT | GL_COLOR_BUFFER_BIT | GL_TEXTURE_BIT | GL_CURRENT_BIT);
+    glDisable(GL_LIGHTING);
+    glDisable(GL_DEPTH_TEST);
+    glEnable(GL_TEXTURE_2D);
+    glBindTexture(GL_TEXTURE_2D, _atlasTexture);
+    glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+    glEnable(GL_ALPHA_TEST);
+    glAlphaFunc(GL_GEQUAL, 0.5f);
+
+    glMatrixMode(GL_PROJECTION);
+    glPushMatrix();
+    glLoadIdentity();
+    glOrtho(0, framebufferWidth, framebufferHeight, 0, -1, 1);
+    glMatrixMode(GL_MODELVIEW);
+    glPushMatrix();
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    // Only position, scale and colour change per string; its quads come
+    // straight from the buffer uploaded when it was first drawn
+    for (const QueuedText& item : _queue) {
+        CachedText& text = *item.text;
+        if (text.vbo == 0 && !text.vertices.empty()) upload(text);
+        if (text.vertexCount == 0) continue;
+        glBindBuffer(GL_ARRAY_BUFFER, text.vbo);
+        glVertexPointer(2, GL_FLOAT, sizeof(Vertex), reinterpret_cast<const void*>(offsetof(Vertex, x)));
+        glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), reinterpret_cast<const void*>(offsetof(Vertex, u)));
+        const GLfloat placement[16] = {
+            item.scale, 0.0f, 0.0f, 0.0f,
+            0.0f, item.scale, 0.0f, 0.0f,
+            0.0f, 0.0f, 1.0f, 0.0f,
+            item.x, item.y, 0.0f, 1.0f
+        };
+        glLoadMatrixf(placement);
+        glColor4ub(item.r, item.g, item.b, 255);
+        glDrawArrays(GL_QUADS, 0, text.vertexCount);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    _queue.clear();
+
+    glPopMatrix();
+    glMatrixMode(GL_PROJECTION);
+    glPopMatrix();
+    glMatrixMode(GL_MODELVIEW);
+    glPopAttrib();
+
+    evictUnused();
+}
+
+void TextRenderer::evictUnused() {
+    if (_flushCount % 64 != 0) return;
+    for (auto it = _cache.begin(); it != _cache.end();) {
+        if (_flushCount - it->second.lastUsed > EvictAfterFlushes) {
+            if (it->second.vbo != 0) glDeleteBuffers(1, &it->second.vbo);
+            it = _cache.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void TextRenderer::releaseGPU() {
+    // Layouts are rebuilt on demand; anything queued would point into them
+    _queue.clear();
+    for (auto& entry : _cache) {
+        if (entry.second.vbo != 0) glDeleteBuffers(1, &entry.second.vbo);
+    }
+    _cache.clear();
+    if (_atlasTexture != 0) {
+        glDeleteTextures(1, &_atlasTexture);
+        _atlasTexture = 0;
+    }
+}
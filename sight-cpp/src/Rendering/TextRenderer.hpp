@@ -0,0 +1,82 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <GLFW/glfw3.h>
+
+// Batched 2D text from a signed-distance glyph atlas.
+// The stb_easy_font glyphs are turned into a distance field once, so text stays
+// sharp at any scale with plain alpha testing. Each distinct string is laid out
+// once into its own vertex buffer, which stays on the GPU for as long as the
+// string keeps being drawn; queue() only records where to draw it. Game calls
+// flush() once per frame, which draws everything queued in one pass: the atlas
+// and state are bound once and each string is a draw from its cached buffer.
+class TextRenderer {
+public:
+    static TextRenderer& instance();
+
+    // Height of one text line at scale 1, in pixels (same metrics as stb_easy_font)
+    static constexpr float LineHeight = 12.0f;
+
+    // Queue `text` with its top-left corner at (x, y) in framebuffer pixels,
+    // origin at the top left
+    void queue(const std::string& text, float x, float y, const glm::vec3& color, float scale = 1.0f);
+
+    // Draw everything queued this frame over a framebuffer of the given size,
+    // then clear the queue. Sets up and restores its own projection.
+    void flush(int framebufferWidth, int framebufferHeight);
+
+    // Size of `text` at `scale`; needs no GL context
+    glm::vec2 measure(const std::string& text, float scale = 1.0f) const;
+
+    void releaseGPU();
+
+private:
+    TextRenderer();
+    ~TextRenderer();
+    TextRenderer(const TextRenderer&) = delete;
+    TextRenderer& operator=(const TextRenderer&) = delete;
+
+    // Glyph corner in string-local font units plus its atlas coordinate
+    struct Vertex {
+        float x, y;
+        float u, v;
+    };
+
+    // Vertices are kept on the CPU only until the first flush uploads them
+    struct CachedText {
+        std::vector<Vertex> vertices;
+        GLuint vbo = 0;
+        GLsizei vertexCount = 0;
+        uint64_t lastUsed = 0;
+    };
+
+    struct QueuedText {
+        CachedText* text;
+        float x, y, scale;
+        uint8_t r, g, b;
+    };
+
+    struct Glyph {
+        float advance = 0.0f;
+        bool empty = true;       // nothing to draw (e.g. space)
+        float u0 = 0.0f, v0 = 0.0f, u1 = 0.0f, v1 = 0.0f;
+    };
+
+    Glyph _glyphs[95];           // printable ASCII, ' ' through '~'
+    std::vector<uint8_t> _atlasPixels;
+    GLuint _atlasTexture = 0;
+
+    std::unordered_map<std::string, CachedText> _cache;
+    std::vector<QueuedText> _queue;
+    uint64_t _flushCount = 0;
+
+    void buildAtlas();
+    CachedText& layout(const std::string& text);
+    void upload(CachedText& text);
+    void evictUnused();
+    static int glyphIndex(char c);
+};
@@ -0,0 +1,315 @@
+#include "VectorTexture.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+int roundUpToPowerOfTwo(int value) {
+    int result = 1;
+    while (result < value) result <<= 1;
+    return result;
+}
+
+uint16_t quantizeUnit(float value) {
+    return static_cast<uint16_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 65535.0f));
+}
+
+uint8_t quantizeByte(float value) {
+    return static_cast<uint8_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 255.0f));
+}
+
+// Stable per-texel noise in [0,1) so textured brushes rasterize the same way every time
+float hashNoise(int x, int y, uint32_t seed) {
+    uint32_t h = static_cast<uint32_t>(x) * 0x8da6b343u ^ static_cast<uint32_t>(y) * 0xd8163841u ^ seed * 0xcb1ab31fu;
+    h ^= h >> 16;
+    h *= 0x7feb352du;
+    h ^= h >> 15;
+    h *= 0x846ca68bu;
+    h ^= h >> 16;
+    return static_cast<float>(h >> 8) / static_cast<float>(1u << 24);
+}
+
+} // namespace
+
+VectorTexture::VectorTexture(uint32_t baseRGBA, int maxResolution) {
+    _maxResolution = roundUpToPowerOfTwo(std::max(MinResolution, maxResolution));
+    clear(baseRGBA);
+}
+
+VectorTexture::~VectorTexture() {
+    releaseGPU();
+}
+
+void VectorTexture::clear(uint32_t baseRGBA) {
+    _baseColor = baseRGBA;
+    _baseTexel[0] = static_cast<uint8_t>(baseRGBA & 0xFF);
+    _baseTexel[1] = static_cast<uint8_t>((baseRGBA >> 8) & 0xFF);
+    _baseTexel[2] = static_cast<uint8_t>((baseRGBA >> 16) & 0xFF);
+    _baseTexel[3] = static_cast<uint8_t>((baseRGBA >> 24) & 0xFF);
+    _dabs.clear();
+    _strokeStarts.clear();
+    invalidateRasters();
+}
+
+void VectorTexture::beginStroke() {
+    uint32_t start = static_cast<uint32_t>(_dabs.size());
+    if (!_strokeStarts.empty() && _strokeStarts.back() == start) return;
+    _strokeStarts.push_back(start);
+}
+
+bool VectorTexture::undoStroke() {
+    // A trailing empty stroke (begun but never painted) is dropped first
+    while (!_strokeStarts.empty() && _strokeStarts.back() >= _dabs.size()) {
+        _strokeStarts.pop_back();
+    }
+    if (_dabs.empty()) return false;
+
+    size_t keep = _strokeStarts.empty() ? 0 : _strokeStarts.back();
+    if (!_strokeStarts.empty()) _strokeStarts.pop_back();
+    _dabs.resize(keep);
+
+    // Rasters that already contain the removed dabs are rebuilt on next use
+    for (auto& raster : _rasters) {
+        if (raster.rasterizedDabs > keep) resetRaster(raster);
+    }
+    return true;
+}
+
+void VectorTexture::addDab(float u, float v, float radius, float r, float g, float b,
+                           float opacity, float softness, int brush) {
+    if (_strokeStarts.empty()) _strokeStarts.push_back(static_cast<uint32_t>(_dabs.size()));
+    Dab dab;
+    dab.u = quantizeUnit(u);
+    dab.v = quantizeUnit(v);
+    dab.radius = quantizeUnit(radius);
+    dab.r = quantizeByte(r);
+    dab.g = quantizeByte(g);
+    dab.b = quantizeByte(b);
+    dab.opacity = quantizeByte(opacity);
+    dab.softness = quantizeByte(softness);
+    dab.brush = static_cast<uint8_t>(std::clamp(brush, 0, static_cast<int>(Spray)));
+    _dabs.push_back(dab);
+}
+
+void VectorTexture::setDabs(std::vector<Dab> dabs, std::vector<uint32_t> strokeStarts) {
+    _dabs = std::move(dabs);
+    _strokeStarts.clear();
+    for (uint32_t start : strokeStarts) {
+        // Keep only increasing, in-range boundaries
+        if (start < _dabs.size() && (_strokeStarts.empty() || start > _strokeStarts.back())) {
+            _strokeStarts.push_back(start);
+        }
+    }
+    invalidateRasters();
+}
+
+std::vector<uint8_t> VectorTexture::packDabs(const std::vector<Dab>& dabs) {
+    std::vector<uint8_t> bytes;
+    bytes.reserve(dabs.size() * PackedDabSize);
+    for (const Dab& dab : dabs) {
+        for (uint16_t value : {dab.u, dab.v, dab.radius}) {
+            bytes.push_back(static_cast<uint8_t>(value & 0xFF));
+            bytes.push_back(static_cast<uint8_t>(value >> 8));
+        }
+        bytes.insert(bytes.end(), {dab.r, dab.g, dab.b, dab.opacity, dab.softness, dab.brush});
+    }
+    return bytes;
+}
+
+std::vector<VectorTexture::Dab> VectorTexture::unpackDabs(const std::vector<uint8_t>& bytes) {
+    std::vector<Dab> dabs(bytes.size() / PackedDabSize);
+    for (size_t i = 0; i < dabs.size(); ++i) {
+        const uint8_t* p = &bytes[i * PackedDabSize];
+        Dab& dab = dabs[i];
+        dab.u = static_cast<uint16_t>(p[0] | (p[1] << 8));
+        dab.v = static_cast<uint16_t>(p[2] | (p[3] << 8));
+        dab.radius = static_cast<uint16_t>(p[4] | (p[5] << 8));
+        dab.r = p[6];
+        dab.g = p[7];
+        dab.b = p[8];
+        dab.opacity = p[9];
+        dab.softness = p[10];
+        dab.brush = std::min<uint8_t>(p[11], Spray);
+    }
+    return dabs;
+}
+
+int VectorTexture::resolutionFor(int screenPixels) const {
+    if (screenPixels <= 0) return _maxResolution;
+    return std::clamp(roundUpToPowerOfTwo(screenPixels), MinResolution, _maxResolution);
+}
+
+GLuint VectorTexture::textureFor(int screenPixels) {
+    int size = resolutionFor(screenPixels);
+
+    auto it = std::find_if(_rasters.begin(), _rasters.end(),
+                           [size](const Raster& raster) { return raster.size == size; });
+    if (it == _rasters.end()) {
+        if (static_cast<int>(_rasters.size()) >= MaxCachedRasters) {
+            auto oldest = std::min_element(_rasters.begin(), _rasters.end(),
+                                           [](const Raster& a, const Raster& b) { return a.lastUse < b.lastUse; });
+            if (oldest->texture != 0) glDeleteTextures(1, &oldest->texture);
+            _rasters.erase(oldest);
+        }
+        Raster raster;
+        raster.size = size;
+        resetRaster(raster);
+        _rasters.push_back(std::move(raster));
+        it = _rasters.end() - 1;
+    }
+
+    Raster& raster = *it;
+    raster.lastUse = ++_useClock;
+    if (raster.rasterizedDabs < _dabs.size()) rasterize(raster);
+    upload(raster);
+    return raster.texture;
+}
+
+size_t VectorTexture::getMemoryBytes() const {
+    size_t bytes = _dabs.capacity() * sizeof(Dab) + _strokeStarts.capacity() * sizeof(uint32_t);
+    for (const auto& raster : _rasters) bytes += raster.pixels.capacity();
+    return bytes;
+}
+
+void VectorTexture::resetRaster(Raster& raster) const {
+    raster.pixels.resize(static_cast<size_t>(raster.size) * raster.size * 4);
+    for (size_t i = 0; i < raster.pixels.size(); i += 4) {
+        std::memcpy(&raster.pixels[i], _baseTexel, 4);
+    }
+    raster.rasterizedDabs = 0;
+    raster.dirtyX0 = 0;
+    raster.dirtyY0 = 0;
+    raster.dirtyX1 = raster.size - 1;
+    raster.dirtyY1 = raster.size - 1;
+}
+
+void VectorTexture::rasterize(Raster& raster) const {
+    for (size_t i = raster.rasterizedDabs; i < _dabs.size(); ++i) {
+        rasterizeDab(raster, _dabs[i], static_cast<uint32_t>(i));
+    }
+    raster.rasterizedDabs = _dabs.size();
+}
+
+void VectorTexture::rasterizeDab(Raster& raster, const Dab& dab, uint32_t seed) const {
+    const int size = raster.size;
+    const float cx = dab.u / 65535.0f * size;
+    const float cy = dab.v / 65535.0f * size;
+    const float radius = dab.radius / 65535.0f * size;
+    const float softness = dab.softness / 255.0f;
+    const float opacity = dab.opacity / 255.0f;
+
+    // Below half a texel the dab lands on one texel, weighted by the area it covers,
+    // so strokes fade out smoothly on small rasters instead of vanishing
+    const bool subTexel = radius < 0.5f;
+    const float coverage = subTexel ? (radius * radius) / 0.25f : 1.0f;
+
+    int x0, x1, y0, y1;
+    if (subTexel) {
+        x0 = x1 = std::clamp(static_cast<int>(cx), 0, size - 1);
+        y0 = y1 = std::clamp(static_cast<int>(cy), 0, size - 1);
+    } else {
+        x0 = std::max(0, static_cast<int>(std::floor(cx - radius)));
+        x1 = std::min(size - 1, static_cast<int>(std::floor(cx + radius)));
+        y0 = std::max(0, static_cast<int>(std::floor(cy - radius)));
+        y1 = std::min(size - 1, static_cast<int>(std::floor(cy + radius)));
+        if (x0 > x1 || y0 > y1) return;
+    }
+
+    const float radiusSq = radius * radius;
+    for (int y = y0; y <= y1; ++y) {
+        for (int x = x0; x <= x1; ++x) {
+            float dx = (x + 0.5f) - cx;
+            float dy = (y + 0.5f) - cy;
+            float distSq = dx * dx + dy * dy;
+            if (!subTexel && distSq > radiusSq) continue;
+
+            float t = coverage;
+            if (!subTexel && softness < 0.99f) {
+                float distNorm = std::sqrt(distSq) / radius;
+                t = std::pow(std::clamp(1.0f - distNorm, 0.0f, 1.0f), 1.0f / std::max(0.001f, softness));
+            }
+
+            switch (dab.brush) {
+                case Airbrush:
+                    t *= 0.5f + 0.5f * hashNoise(x, y, seed);
+                    break;
+                case Chalk:
+                    t *= 0.3f + 0.7f * hashNoise(x, y, seed);
+                    break;
+                case Spray:
+                    if (hashNoise(x, y, seed) > 0.7f) t *= 0.3f;
+                    break;
+            }
+
+            t *= opacity;
+            uint8_t* dst = &raster.pixels[(static_cast<size_t>(y) * size + x) * 4];
+            float inv = 1.0f - t;
+            dst[0] = static_cast<uint8_t>(dst[0] * inv + dab.r * t);
+            dst[1] = static_cast<uint8_t>(dst[1] * inv + dab.g * t);
+            dst[2] = static_cast<uint8_t>(dst[2] * inv + dab.b * t);
+            dst[3] = 255;
+        }
+    }
+
+    if (raster.dirtyX0 > raster.dirtyX1) {
+        raster.dirtyX0 = x0; raster.dirtyY0 = y0;
+        raster.dirtyX1 = x1; raster.dirtyY1 = y1;
+    } else {
+        raster.dirtyX0 = std::min(raster.dirtyX0, x0);
+        raster.dirtyY0 = std::min(raster.dirtyY0, y0);
+        raster.dirtyX1 = std::max(raster.dirtyX1, x1);
+        raster.dirtyY1 = std::max(raster.dirtyY1, y1);
+    }
+}
+
+void VectorTexture::upload(Raster& raster) const {
+    bool fresh = raster.texture == 0;
+    if (!fresh && raster.dirtyX0 > raster.dirtyX1) return;
+
+    if (fresh) glGenTextures(1, &raster.texture);
+    glBindTexture(GL_TEXTURE_2D, raster.texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    if (fresh) {
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, raster.size, raster.size, 0,
+                     GL_RGBA, GL_UNSIGNED_BYTE, raster.pixels.data());
+    } else {
+        // Only the rectangle touched since the last upload
+        int width = raster.dirtyX1 - raster.dirtyX0 + 1;
+        int height = raster.dirtyY1 - raster.dirtyY0 + 1;
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, raster.size);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, raster.dirtyX0, raster.dirtyY0, width, height, GL_RGBA, GL_UNSIGNED_BYTE,
+                        &raster.pixels[(static_cast<size_t>(raster.dirtyY0) * raster.size + raster.dirtyX0) * 4]);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    }
+
+    typedef void (*GenerateMipmapFunc)(GLenum);
+    GenerateMipmapFunc generateMipmap = reinterpret_cast<GenerateMipmapFunc>(glfwGetProcAddress("glGenerateMipmap"));
+    if (generateMipmap) {
+        generateMipmap(GL_TEXTURE_2D);
+    } else {
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    }
+
+    raster.dirtyX0 = 0;
+    raster.dirtyY0 = 0;
+    raster.dirtyX1 = -1;
+    raster.dirtyY1 = -1;
+}
+
+void VectorTexture::invalidateRasters() {
+    for (auto& raster : _rasters) resetRaster(raster);
+}
+
+void VectorTexture::releaseGPU() {
+    for (auto& raster : _rasters) {
+        if (raster.texture != 0) glDeleteTextures(1, &raster.texture);
+        raster.texture = 0;
+    }
+    _rasters.clear();
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <GLFW/glfw3.h>
+
+// Resolution-independent face texture whose document is the list of brush dabs.
+// Dabs are stored quantized (12 bytes each) and rasterized lazily at whatever
+// resolution the view asks for. Each requested resolution keeps its own cached
+// raster and GL texture; new dabs are applied incrementally and only the
+// touched rectangle is re-uploaded. A distant face therefore costs a tiny raster,
+// and saving it costs only the dab list.
+class VectorTexture {
+public:
+    // Brush kinds, matching the brushType values used by Object::paintFaceAdvanced
+    enum BrushKind : uint8_t { Round = 0, Airbrush = 1, Chalk = 2, Spray = 3 };
+
+    struct Dab {
+        uint16_t u, v;        // centre in UV, 0..65535
+        uint16_t radius;      // radius as a fraction of the face, 0..65535
+        uint8_t r, g, b;
+        uint8_t opacity;      // opacity × flow
+        uint8_t softness;     // 255 = hard edge
+        uint8_t brush;        // BrushKind
+    };
+
+    static constexpr int MinResolution = 8;
+    static constexpr int MaxCachedRasters = 2;
+    static constexpr size_t PackedDabSize = 12;
+
+    explicit VectorTexture(uint32_t baseRGBA = 0xFFFFFFFF, int maxResolution = 1024);
+    ~VectorTexture();
+    VectorTexture(const VectorTexture&) = delete;
+    VectorTexture& operator=(const VectorTexture&) = delete;
+
+    int getMaxResolution() const { return _maxResolution; }
+    uint32_t getBaseColor() const { return _baseColor; }
+
+    // Drop every dab and make the whole face the given colour
+    void clear(uint32_t baseRGBA);
+
+    // Stroke boundaries for undo. beginStroke() is a no-op if nothing was added since the last one.
+    void beginStroke();
+    bool undoStroke();
+
+    void addDab(float u, float v, float radius, float r, float g, float b,
+                float opacity, float softness, int brush);
+
+    const std::vector<Dab>& getDabs() const { return _dabs; }
+    const std::vector<uint32_t>& getStrokeStarts() const { return _strokeStarts; }
+    void setDabs(std::vector<Dab> dabs, std::vector<uint32_t> strokeStarts);
+
+    // Fixed little-endian layout for saving
+    static std::vector<uint8_t> packDabs(const std::vector<Dab>& dabs);
+    static std::vector<Dab> unpackDabs(const std::vector<uint8_t>& bytes);
+
+    // Power-of-two raster size for a face covering roughly `screenPixels` on screen.
+    // Zero or negative means "unknown" and selects the maximum resolution.
+    int resolutionFor(int screenPixels) const;
+
+    // Texture holding the face rasterized at resolutionFor(screenPixels).
+    // Rasterizes and uploads lazily; evicts the least recently used raster.
+    GLuint textureFor(int screenPixels);
+
+    size_t getMemoryBytes() const;
+
+private:
+    struct Raster {
+        int size = 0;
+        std::vector<uint8_t> pixels;
+        GLuint texture = 0;
+        size_t rasterizedDabs = 0;  // prefix of _dabs already applied to `pixels`
+        uint64_t lastUse = 0;
+        // Texel rectangle changed since the last upload (inclusive, empty when x0 > x1)
+        int dirtyX0 = 0, dirtyY0 = 0, dirtyX1 = -1, dirtyY1 = -1;
+    };
+
+    uint32_t _baseColor;
+    uint8_t _baseTexel[4];
+    int _maxResolution;
+    std::vector<Dab> _dabs;
+    std::vector<uint32_t> _strokeStarts;   // index of the first dab of each stroke
+    std::vector<Raster> _rasters;
+    uint64_t _useClock = 0;
+
+    void resetRaster(Raster& raster) const;
+    void rasterize(Raster& raster) const;
+    void rasterizeDab(Raster& raster, const Dab& dab, uint32_t seed) const;
+    void upload(Raster& raster) const;
+    void invalidateRasters();
+    void releaseGPU();
+};
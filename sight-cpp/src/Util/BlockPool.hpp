@@ -0,0 +1,78 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <cstddef>
+
+// Fixed-size allocator for one type. Blocks are carved out of chunks of
+// BlocksPerChunk and recycled through an intrusive free list, so values
+// allocated together sit together and a create/destroy pair never reaches
+// the general-purpose heap once the pool has warmed up. Chunks are only
+// returned when the pool itself is destroyed.
+// Thread-safe.
+template <typename T, size_t BlocksPerChunk = 64>
+class BlockPool {
+public:
+    BlockPool() = default;
+    BlockPool(const BlockPool&) = delete;
+    BlockPool& operator=(const BlockPool&) = delete;
+
+    template <typename... Args>
+    T* create(Args&&... args) {
+        Block* block;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (!_free) grow();
+            block = _free;
+            _free = block->next;
+            ++_live;
+        }
+        try {
+            return new (block->storage) T(std::forward<Args>(args)...);
+        } catch (...) {
+            release(block); // a throwing constructor must not cost the pool a block
+            throw;
+        }
+    }
+
+    void destroy(T* value) {
+        if (!value) return;
+        value->~T();
+        release(reinterpret_cast<Block*>(value));
+    }
+
+    size_t liveCount() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _live;
+    }
+
+private:
+    union Block {
+        Block* next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    void release(Block* block) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        block->next = _free;
+        _free = block;
+        --_live;
+    }
+
+    void grow() {
+        _chunks.emplace_back(new Block[BlocksPerChunk]);
+        Block* chunk = _chunks.back().get();
+        for (size_t i = BlocksPerChunk; i-- > 0;) {
+            chunk[i].next = _free;
+            _free = &chunk[i];
+        }
+    }
+
+    mutable std::mutex _mutex;
+    std::vector<std::unique_ptr<Block[]>> _chunks;
+    Block* _free = nullptr;
+    size_t _live = 0;
+};
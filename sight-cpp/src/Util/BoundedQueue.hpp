@@ -0,0 +1,90 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+
+// Fixed-capacity lock-free ring (Vyukov's bounded queue). Any number of threads
+// may push; pops are meant for a single consumer. Cells are allocated once and
+// reused: tryPush() hands the producer a cell to fill in place and tryPop()
+// hands the consumer the filled cell, so elements are never copied or moved.
+template <typename T>
+class BoundedQueue {
+public:
+    // Capacity is rounded up to a power of two
+    explicit BoundedQueue(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) size <<= 1;
+        _mask = size - 1;
+        _cells.reset(new Cell[size]);
+        for (size_t i = 0; i < size; ++i) _cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    // Calls fill(T&) on a free cell; false if the queue is full
+    template <typename Fill>
+    bool tryPush(Fill&& fill) {
+        uint64_t pos = _enqueuePos.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &_cells[pos & _mask];
+            uint64_t seq = cell->sequence.load(std::memory_order_acquire);
+            int64_t diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos);
+            if (diff == 0) {
+                if (_enqueuePos.compare_exchange_weak(pos, pos + 1)) break;
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = _enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+        fill(cell->value);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Calls consume(T&) on the oldest filled cell; false if there is none yet.
+    // The cell is only released back to producers after consume() returns.
+    template <typename Consume>
+    bool tryPop(Consume&& consume) {
+        uint64_t pos = _dequeuePos.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &_cells[pos & _mask];
+            uint64_t seq = cell->sequence.load(std::memory_order_acquire);
+            int64_t diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos + 1);
+            if (diff == 0) {
+                if (_dequeuePos.compare_exchange_weak(pos, pos + 1)) break;
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = _dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+        consume(cell->value);
+        cell->sequence.store(pos + _mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t capacity() const { return _mask + 1; }
+
+    // Positions count every push/pop ever claimed; a claimed push may still be
+    // filling its cell, so empty() can be false before tryPop() succeeds.
+    uint64_t enqueuePosition() const { return _enqueuePos.load(); }
+    uint64_t dequeuePosition() const { return _dequeuePos.load(); }
+    bool empty() const { return enqueuePosition() == dequeuePosition(); }
+
+private:
+    struct Cell {
+        std::atomic<uint64_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> _cells;
+    size_t _mask = 0;
+    alignas(64) std::atomic<uint64_t> _enqueuePos{0};
+    alignas(64) std::atomic<uint64_t> _dequeuePos{0};
+};
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+#include <glm/glm.hpp>
+
+// Loose quadtree over 2D axis-aligned boxes, keyed by a 64-bit ID (e.g. a
+// SlotHandle value). Each node accepts items up to its own cell size whose
+// centre falls in the cell, and its query bounds are the cell grown by half a
+// cell on every side. An item therefore sits in exactly one node picked from its
+// centre and size alone, so moving it costs O(depth) and never splits it.
+// Items outside the root go on an overflow list that every query checks.
+class LooseQuadtree {
+public:
+    explicit LooseQuadtree(const glm::vec2& center = glm::vec2(0.0f), float halfSize = 8192.0f, int maxDepth = 10)
+        : _maxDepth(maxDepth) {
+        _nodes.push_back(Node{center, halfSize, {NoNode, NoNode, NoNode, NoNode}, {}});
+    }
+
+    // Insert or move an item
+    void update(uint64_t id, const glm::vec2& boundsMin, const glm::vec2& boundsMax) {
+        int32_t node = locate(boundsMin, boundsMax);
+        auto it = _nodeOf.find(id);
+        if (it != _nodeOf.end()) {
+            if (it->second == node) {
+                // Common case for small moves: same node, just refresh the box
+                for (Item& item : listFor(node)) {
+                    if (item.id == id) {
+                        item.min = boundsMin;
+                        item.max = boundsMax;
+                        return;
+                    }
+                }
+            }
+            detach(id, it->second);
+            it->second = node;
+        } else {
+            _nodeOf.emplace(id, node);
+        }
+        listFor(node).push_back(Item{id, boundsMin, boundsMax});
+    }
+
+    void remove(uint64_t id) {
+        auto it = _nodeOf.find(id);
+        if (it == _nodeOf.end()) return;
+        detach(id, it->second);
+        _nodeOf.erase(it);
+    }
+
+    void clear() {
+        Node root = _nodes.front();
+        root.items.clear();
+        root.children[0] = root.children[1] = root.children[2] = root.children[3] = NoNode;
+        _nodes.assign(1, root);
+        _overflow.clear();
+        _nodeOf.clear();
+    }
+
+    size_t size() const { return _nodeOf.size(); }
+
+    // IDs of every item whose box overlaps [queryMin, queryMax] (unordered)
+    void query(const glm::vec2& queryMin, const glm::vec2& queryMax, std::vector<uint64_t>& out) const {
+        for (const Item& item : _overflow) collect(item, queryMin, queryMax, out);
+
+        _stack.clear();
+        _stack.push_back(0);
+        while (!_stack.empty()) {
+            const Node& node = _nodes[_stack.back()];
+            _stack.pop_back();
+            // Loose bounds: the cell grown by half a cell on every side
+            float loose = node.halfSize * 2.0f;
+            if (queryMax.x < node.center.x - loose || queryMin.x > node.center.x + loose ||
+                queryMax.y < node.center.y - loose || queryMin.y > node.center.y + loose) {
+                continue;
+            }
+            for (const Item& item : node.items) collect(item, queryMin, queryMax, out);
+            for (int32_t child : node.children) {
+                if (child != NoNode) _stack.push_back(child);
+            }
+        }
+    }
+
+    void query(const glm::vec2& point, std::vector<uint64_t>& out) const {
+        query(point, point, out);
+    }
+
+private:
+    static constexpr int32_t NoNode = -1;
+
+    // Boxes are stored inline so queries never leave the node's list
+    struct Item {
+        uint64_t id;
+        glm::vec2 min, max;
+    };
+
+    struct Node {
+        glm::vec2 center;
+        float halfSize;
+        int32_t children[4];
+        std::vector<Item> items;
+    };
+
+    std::vector<Node> _nodes;
+    std::vector<Item> _overflow;
+    std::unordered_map<uint64_t, int32_t> _nodeOf;   // NoNode = overflow list
+    int _maxDepth;
+    mutable std::vector<int32_t> _stack;
+
+    // Deepest node whose cell holds the item's centre and is at least as large as the item
+    int32_t locate(const glm::vec2& boundsMin, const glm::vec2& boundsMax) {
+        glm::vec2 center = (boundsMin + boundsMax) * 0.5f;
+        float extent = std::max(boundsMax.x - boundsMin.x, boundsMax.y - boundsMin.y) * 0.5f;
+
+        const Node& root = _nodes.front();
+        if (std::abs(center.x - root.center.x) > root.halfSize ||
+            std::abs(center.y - root.center.y) > root.halfSize || extent > root.halfSize) {
+            return NoNode;
+        }
+
+        int32_t index = 0;
+        for (int depth = 0; depth < _maxDepth; ++depth) {
+            float childHalf = _nodes[index].halfSize * 0.5f;
+            if (extent > childHalf) break;
+            int quadrant = (center.x >= _nodes[index].center.x ? 1 : 0) | (center.y >= _nodes[index].center.y ? 2 : 0);
+            int32_t child = _nodes[index].children[quadrant];
+            if (child == NoNode) {
+                glm::vec2 offset((quadrant & 1) ? childHalf : -childHalf, (quadrant & 2) ? childHalf : -childHalf);
+                child = static_cast<int32_t>(_nodes.size());
+                _nodes.push_back(Node{_nodes[index].center + offset, childHalf, {NoNode, NoNode, NoNode, NoNode}, {}});
+                _nodes[index].children[quadrant] = child;
+            }
+            index = child;
+        }
+        return index;
+    }
+
+    std::vector<Item>& listFor(int32_t node) {
+        return node == NoNode ? _overflow : _nodes[node].items;
+    }
+
+    void detach(uint64_t id, int32_t node) {
+        std::vector<Item>& list = listFor(node);
+        auto it = std::find_if(list.begin(), list.end(), [id](const Item& item) { return item.id == id; });
+        if (it != list.end()) {
+            *it = list.back();
+            list.pop_back();
+        }
+    }
+
+    static void collect(const Item& item, const glm::vec2& queryMin, const glm::vec2& queryMax, std::vector<uint64_t>& out) {
+        if (item.max.x >= queryMin.x && item.min.x <= queryMax.x &&
+            item.max.y >= queryMin.y && item.min.y <= queryMax.y) {
+            out.push_back(item.id);
+        }
+    }
+};
@@ -0,0 +1,237 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <functional>
+
+// Immutable hash map with structural sharing (a hash array mapped trie).
+// set() and erase() return a new map that copies only the O(log32 n) nodes on
+// the path to the changed key and shares everything else with the original, so
+// keeping many versions costs memory proportional to what changed between them.
+// Copying a map is a pointer copy.
+template <typename K, typename V, typename Hash = std::hash<K>>
+class PersistentMap {
+public:
+    size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+
+    const V* find(const K& key) const {
+        size_t hash = Hash()(key);
+        const Node* node = _root.get();
+        for (int shift = 0; node; shift += BitsPerLevel) {
+            uint32_t bit = bitFor(hash, shift);
+            if (!(node->bitmap & bit)) return nullptr;
+            const Slot& slot = node->slots[slotIndex(node->bitmap, bit)];
+            if (slot.leaf) {
+                if (slot.leaf->hash != hash) return nullptr;
+                for (const auto& entry : slot.leaf->entries) {
+                    if (entry.first == key) return &entry.second;
+                }
+                return nullptr;
+            }
+            node = slot.child.get();
+        }
+        return nullptr;
+    }
+
+    PersistentMap set(const K& key, V value) const {
+        PersistentMap result(*this);
+        bool added = false;
+        result._root = setIn(_root, 0, Hash()(key), key, std::move(value), added);
+        if (added) ++result._size;
+        return result;
+    }
+
+    PersistentMap erase(const K& key) const {
+        if (!find(key)) return *this;
+        PersistentMap result(*this);
+        result._root = eraseIn(_root, 0, Hash()(key), key);
+        --result._size;
+        return result;
+    }
+
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        if (_root) forEachIn(*_root, fn);
+    }
+
+    // Calls fn(key, before, after) for every key whose entry differs between
+    // `from` and `to`; a null pointer means the key is absent on that side.
+    // Subtrees the two maps share are skipped without being visited, so the cost
+    // follows the size of the edit rather than the size of the map.
+    template <typename Fn>
+    static void diff(const PersistentMap& from, const PersistentMap& to, Fn&& fn) {
+        diffSlots(Slot{from._root, nullptr}, Slot{to._root, nullptr}, fn);
+    }
+
+private:
+    static constexpr int BitsPerLevel = 5;
+    static constexpr int HashBits = static_cast<int>(sizeof(size_t) * 8);
+
+    struct Node;
+    struct Leaf {
+        size_t hash;
+        std::vector<std::pair<K, V>> entries;   // more than one only on full-hash collisions
+    };
+    struct Slot {
+        std::shared_ptr<const Node> child;
+        std::shared_ptr<const Leaf> leaf;
+    };
+    struct Node {
+        uint32_t bitmap = 0;
+        std::vector<Slot> slots;   // one per set bit, in bit order
+    };
+
+    std::shared_ptr<const Node> _root;
+    size_t _size = 0;
+
+    static uint32_t bitFor(size_t hash, int shift) {
+        return shift < HashBits ? 1u << ((hash >> shift) & 31) : 1u;
+    }
+    static size_t slotIndex(uint32_t bitmap, uint32_t bit) {
+        uint32_t below = bitmap & (bit - 1);
+        size_t count = 0;
+        while (below) { below &= below - 1; ++count; }
+        return count;
+    }
+
+    static std::shared_ptr<const Node> setIn(const std::shared_ptr<const Node>& node, int shift, size_t hash,
+                                             const K& key, V&& value, bool& added) {
+        auto copy = node ? std::make_shared<Node>(*node) : std::make_shared<Node>();
+        uint32_t bit = bitFor(hash, shift);
+        size_t index = slotIndex(copy->bitmap, bit);
+
+        if (!(copy->bitmap & bit)) {
+            auto leaf = std::make_shared<Leaf>();
+            leaf->hash = hash;
+            leaf->entries.emplace_back(key, std::move(value));
+            copy->slots.insert(copy->slots.begin() + index, Slot{nullptr, std::move(leaf)});
+            copy->bitmap |= bit;
+            added = true;
+            return copy;
+        }
+
+        Slot& slot = copy->slots[index];
+        if (slot.child) {
+            slot.child = setIn(slot.child, shift + BitsPerLevel, hash, key, std::move(value), added);
+        } else if (slot.leaf->hash == hash) {
+            auto leaf = std::make_shared<Leaf>(*slot.leaf);
+            bool replaced = false;
+            for (auto& entry : leaf->entries) {
+                if (entry.first == key) {
+                    entry.second = std::move(value);
+                    replaced = true;
+                    break;
+                }
+            }
+            if (!replaced) {
+                leaf->entries.emplace_back(key, std::move(value));
+                added = true;
+            }
+            slot.leaf = std::move(leaf);
+        } else {
+            // Two different hashes share this prefix: push the old leaf one level down
+            auto child = std::make_shared<Node>();
+            child->bitmap = bitFor(slot.leaf->hash, shift + BitsPerLevel);
+            child->slots.push_back(Slot{nullptr, slot.leaf});
+            slot.leaf.reset();
+            slot.child = setIn(child, shift + BitsPerLevel, hash, key, std::move(value), added);
+        }
+        return copy;
+    }
+
+    static std::shared_ptr<const Node> eraseIn(const std::shared_ptr<const Node>& node, int shift, size_t hash, const K& key) {
+        uint32_t bit = bitFor(hash, shift);
+        size_t index = slotIndex(node->bitmap, bit);
+        auto copy = std::make_shared<Node>(*node);
+        Slot& slot = copy->slots[index];
+
+        if (slot.child) {
+            slot.child = eraseIn(slot.child, shift + BitsPerLevel, hash, key);
+            if (!slot.child) {
+                copy->slots.erase(copy->slots.begin() + index);
+                copy->bitmap &= ~bit;
+            } else if (slot.child->slots.size() == 1 && slot.child->slots[0].leaf) {
+                // Collapse single-leaf children so lookups don't walk empty levels
+                slot.leaf = slot.child->slots[0].leaf;
+                slot.child.reset();
+            }
+        } else {
+            auto leaf = std::make_shared<Leaf>(*slot.leaf);
+            for (size_t i = 0; i < leaf->entries.size(); ++i) {
+                if (leaf->entries[i].first == key) {
+                    leaf->entries.erase(leaf->entries.begin() + i);
+                    break;
+                }
+            }
+            if (leaf->entries.empty()) {
+                copy->slots.erase(copy->slots.begin() + index);
+                copy->bitmap &= ~bit;
+            } else {
+                slot.leaf = std::move(leaf);
+            }
+        }
+        return copy->bitmap ? copy : nullptr;
+    }
+
+    template <typename Fn>
+    static void forEachIn(const Node& node, Fn& fn) {
+        for (const Slot& slot : node.slots) {
+            if (slot.child) {
+                forEachIn(*slot.child, fn);
+            } else {
+                for (const auto& entry : slot.leaf->entries) fn(entry.first, entry.second);
+            }
+        }
+    }
+
+    static void collect(const Slot& slot, std::vector<const std::pair<K, V>*>& out) {
+        if (slot.leaf) {
+            for (const auto& entry : slot.leaf->entries) out.push_back(&entry);
+        } else if (slot.child) {
+            for (const Slot& inner : slot.child->slots) collect(inner, out);
+        }
+    }
+
+    template <typename Fn>
+    static void diffSlots(const Slot& a, const Slot& b, Fn& fn) {
+        if (a.child == b.child && a.leaf == b.leaf) return;   // shared, nothing changed below
+
+        if (a.child && b.child) {
+            const Node& left = *a.child;
+            const Node& right = *b.child;
+            uint32_t bits = left.bitmap | right.bitmap;
+            while (bits) {
+                uint32_t bit = bits & (~bits + 1);
+                bits &= bits - 1;
+                Slot empty;
+                const Slot& l = (left.bitmap & bit) ? left.slots[slotIndex(left.bitmap, bit)] : empty;
+                const Slot& r = (right.bitmap & bit) ? right.slots[slotIndex(right.bitmap, bit)] : empty;
+                diffSlots(l, r, fn);
+            }
+            return;
+        }
+
+        // Mixed shapes (leaf against subtree, or a side missing): compare entry by entry
+        std::vector<const std::pair<K, V>*> before, after;
+        collect(a, before);
+        collect(b, after);
+        for (const auto* entry : before) {
+            const std::pair<K, V>* match = nullptr;
+            for (const auto* other : after) {
+                if (other->first == entry->first) { match = other; break; }
+            }
+            if (match != entry) fn(entry->first, &entry->second, match ? &match->second : nullptr);
+        }
+        for (const auto* entry : after) {
+            bool existed = false;
+            for (const auto* other : before) {
+                if (other->first == entry->first) { existed = true; break; }
+            }
+            if (!existed) fn(entry->first, nullptr, &entry->second);
+        }
+    }
+};
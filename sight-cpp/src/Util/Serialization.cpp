@@ -12,35 +12,6 @@ namespace {
     static const char kBase64Table[] =
         "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
 
-    std::string base64Encode(const std::vector<uint8_t>& data) {
-        std::string out;
-        out.reserve(((data.size() + 2) / 3) * 4);
-        size_t i = 0;
-        while (i + 3 <= data.size()) {
-            uint32_t n = (static_cast<uint32_t>(data[i]) << 16) |
-                         (static_cast<uint32_t>(data[i + 1]) << 8) |
-                         (static_cast<uint32_t>(data[i + 2]));
-            out.push_back(kBase64Table[(n >> 18) & 63]);
-            out.push_back(kBase64Table[(n >> 12) & 63]);
-            out.push_back(kBase64Table[(n >> 6) & 63]);
-            out.push_back(kBase64Table[n & 63]);
-            i += 3;
-        }
-        if (i < data.size()) {
-            uint32_t n = static_cast<uint32_t>(data[i]) << 16;
-            if (i + 1 < data.size()) n |= static_cast<uint32_t>(data[i + 1]) << 8;
-            out.push_back(kBase64Table[(n >> 18) & 63]);
-            out.push_back(kBase64Table[(n >> 12) & 63]);
-            if (i + 1 < data.size()) {
-                out.push_back(kBase64Table[(n >> 6) & 63]);
-            } else {
-                out.push_back('=');
-            }
-            out.push_back('=');
-        }
-        return out;
-    }
-
     inline uint8_t b64Val(char c) {
         if (c >= 'A' && c <= 'Z') return static_cast<uint8_t>(c - 'A');
         if (c >= 'a' && c <= 'z') return static_cast<uint8_t>(c - 'a' + 26);
@@ -49,43 +20,72 @@ namespace {
         if (c == '/') return 63;
         return 255; // invalid
     }
+} // namespace
 
-    std::vector<uint8_t> base64Decode(const std::string& input) {
-        // Remove whitespace
-        std::string s; s.reserve(input.size());
-        for (char c : input) {
-            if (c == '\n' || c == '\r' || c == '\t' || c == ' ') continue;
-            s.push_back(c);
+std::string base64Encode(const std::vector<uint8_t>& data) {
+    std::string out;
+    out.reserve(((data.size() + 2) / 3) * 4);
+    size_t i = 0;
+    while (i + 3 <= data.size()) {
+        uint32_t n = (static_cast<uint32_t>(data[i]) << 16) |
+                     (static_cast<uint32_t>(data[i + 1]) << 8) |
+                     (static_cast<uint32_t>(data[i + 2]));
+        out.push_back(kBase64Table[(n >> 18) & 63]);
+        out.push_back(kBase64Table[(n >> 12) & 63]);
+        out.push_back(kBase64Table[(n >> 6) & 63]);
+        out.push_back(kBase64Table[n & 63]);
+        i += 3;
+    }
+    if (i < data.size()) {
+        uint32_t n = static_cast<uint32_t>(data[i]) << 16;
+        if (i + 1 < data.size()) n |= static_cast<uint32_t>(data[i + 1]) << 8;
+        out.push_back(kBase64Table[(n >> 18) & 63]);
+        out.push_back(kBase64Table[(n >> 12) & 63]);
+        if (i + 1 < data.size()) {
+            out.push_back(kBase64Table[(n >> 6) & 63]);
+        } else {
+            out.push_back('=');
         }
+        out.push_back('=');
+    }
+    return out;
+}
 
-        size_t len = s.size();
-        if (len % 4 != 0) return {};
-        size_t pad = 0;
-        if (len >= 2) {
-            if (s[len - 1] == '=') pad++;
-            if (s[len - 2] == '=') pad++;
-        }
-        size_t outLen = (len / 4) * 3 - pad;
-        std::vector<uint8_t> out; out.reserve(outLen);
-        for (size_t i = 0; i < len; i += 4) {
-            uint8_t a = b64Val(s[i]);
-            uint8_t b = b64Val(s[i + 1]);
-            uint8_t c = s[i + 2] == '=' ? 0 : b64Val(s[i + 2]);
-            uint8_t d = s[i + 3] == '=' ? 0 : b64Val(s[i + 3]);
-            if (a == 255 || b == 255 || (s[i + 2] != '=' && c == 255) || (s[i + 3] != '=' && d == 255)) {
-                return {}; // invalid char
-            }
-            uint32_t n = (static_cast<uint32_t>(a) << 18) |
-                         (static_cast<uint32_t>(b) << 12) |
-                         (static_cast<uint32_t>(c) << 6) |
-                         (static_cast<uint32_t>(d));
-            out.push_back(static_cast<uint8_t>((n >> 16) & 0xFF));
-            if (s[i + 2] != '=') out.push_back(static_cast<uint8_t>((n >> 8) & 0xFF));
-            if (s[i + 3] != '=') out.push_back(static_cast<uint8_t>(n & 0xFF));
+std::vector<uint8_t> base64Decode(const std::string& input) {
+    // Remove whitespace
+    std::string s; s.reserve(input.size());
+    for (char c : input) {
+        if (c == '\n' || c == '\r' || c == '\t' || c == ' ') continue;
+        s.push_back(c);
+    }
+
+    size_t len = s.size();
+    if (len % 4 != 0) return {};
+    size_t pad = 0;
+    if (len >= 2) {
+        if (s[len - 1] == '=') pad++;
+        if (s[len - 2] == '=') pad++;
+    }
+    size_t outLen = (len / 4) * 3 - pad;
+    std::vector<uint8_t> out; out.reserve(outLen);
+    for (size_t i = 0; i < len; i += 4) {
+        uint8_t a = b64Val(s[i]);
+        uint8_t b = b64Val(s[i + 1]);
+        uint8_t c = s[i + 2] == '=' ? 0 : b64Val(s[i + 2]);
+        uint8_t d = s[i + 3] == '=' ? 0 : b64Val(s[i + 3]);
+        if (a == 255 || b == 255 || (s[i + 2] != '=' && c == 255) || (s[i + 3] != '=' && d == 255)) {
+            return {}; // invalid char
         }
-        return out;
+        uint32_t n = (static_cast<uint32_t>(a) << 18) |
+                     (static_cast<uint32_t>(b) << 12) |
+                     (static_cast<uint32_t>(c) << 6) |
+                     (static_cast<uint32_t>(d));
+        out.push_back(static_cast<uint8_t>((n >> 16) & 0xFF));
+        if (s[i + 2] != '=') out.push_back(static_cast<uint8_t>((n >> 8) & 0xFF));
+        if (s[i + 3] != '=') out.push_back(static_cast<uint8_t>(n & 0xFF));
     }
-} // namespace
+    return out;
+}
 
 // Helper: serialise glm::mat4 to vector<float>
 static std::vector<float> mat4ToVector(const glm::mat4& m){
@@ -134,24 +134,59 @@ void to_json(nlohmann::json& j, const Object& obj){
     }
 
     // Persist mass attribute if present
-    if (obj.hasAttribute("mass")) {
-        j["mass"] = obj.getAttribute("mass");
+    if (const AttributeValue* mass = obj.findAttribute(AttributeStore::key("mass"))) {
+        if (const float* f = std::get_if<float>(mass)) j["mass"] = *f;
+        else j["mass"] = AttributeStore::toString(*mass);
     }
 
     // Per-face textures (composited RGBA8, Base64-encoded)
     if (!obj.faceTextures.empty()) {
         nlohmann::json texArr = nlohmann::json::array();
         for (const auto& ft : obj.faceTextures) {
+            nlohmann::json ftj;
+            ftj["size"] = ft.size;
+            if (ft.isVector()) {
+                // Vector faces save only their dabs; rasters are rebuilt on demand
+                const VectorTexture& vector = *ft.vector;
+                ftj["vector"] = true;
+                ftj["baseColor"] = vector.getBaseColor();
+                ftj["dabsB64"] = base64Encode(VectorTexture::packDabs(vector.getDabs()));
+                ftj["strokeStarts"] = vector.getStrokeStarts();
+                texArr.push_back(std::move(ftj));
+                continue;
+            }
+            if (ft.isSparse()) {
+                // Sparse faces save their base colour plus resident tiles only
+                const SparseTexture& sparse = *ft.sparse;
+                ftj["sparse"] = true;
+                ftj["tileSize"] = sparse.getTileSize();
+                ftj["baseColor"] = sparse.getBaseColor();
+                nlohmann::json tiles = nlohmann::json::array();
+                for (int ty = 0; ty < sparse.getTilesPerSide(); ++ty) {
+                    for (int tx = 0; tx < sparse.getTilesPerSide(); ++tx) {
+                        const std::vector<uint8_t>* tilePixels = sparse.getTilePixels(tx, ty);
+                        if (!tilePixels) continue;
+                        tiles.push_back({{"x", tx}, {"y", ty}, {"pixelsB64", base64Encode(*tilePixels)}});
+                    }
+                }
+                ftj["tiles"] = std::move(tiles);
+                texArr.push_back(std::move(ftj));
+                continue;
+            }
             // If layers are used, composite into pixels before saving
             if (ft.useLayers) {
                 ft.compositeLayers();
             }
-            nlohmann::json ftj;
-            ftj["size"] = ft.size;
             ftj["pixelsB64"] = base64Encode(ft.pixels);
             texArr.push_back(std::move(ftj));
         }
         j["textureVersion"] = 1;
+        if (obj.getSparseFaceTextureSize() > 0) {
+            j["sparseFaceTextureSize"] = obj.getSparseFaceTextureSize();
+        }
+        if (obj.getVectorFaceTextureResolution() > 0) {
+            j["vectorFaceTextureResolution"] = obj.getVectorFaceTextureResolution();
+        }
         j["faceTextures"] = std::move(texArr);
     }
 }
@@ -164,11 +199,11 @@ void from_json(const nlohmann::json& j, Object& obj){
     if (j.contains("baseline") && j["baseline"].is_string()) {
         obj.setAttribute("baseline", j["baseline"].get<std::string>());
     }
-    // Load mass attribute (store as attribute string)
+    // Load mass attribute (numbers are kept as floats; older saves wrote strings)
     if (j.contains("mass")) {
         try {
             if (j["mass"].is_number()) {
-                obj.setAttribute("mass", std::to_string(j["mass"].get<double>()));
+                obj.setAttribute(AttributeStore::key("mass"), j["mass"].get<float>());
             } else if (j["mass"].is_string()) {
                 obj.setAttribute("mass", j["mass"].get<std::string>());
             }
@@ -208,11 +243,39 @@ void from_json(const nlohmann::json& j, Object& obj){
     }
 
     // Load per-face textures if present (after geometry restoration for correct sizing)
+    if (j.value("sparseFaceTextureSize", 0) > 0) {
+        obj.setSparseFaceTextures(j["sparseFaceTextureSize"].get<int>());
+    }
+    if (j.value("vectorFaceTextureResolution", 0) > 0) {
+        obj.setVectorFaceTextures(j["vectorFaceTextureResolution"].get<int>());
+    }
     if (j.contains("faceTextures")) {
         const auto& arr = j["faceTextures"];
         int limit = std::min<int>(static_cast<int>(arr.size()), static_cast<int>(obj.faceTextures.size()));
         for (int i = 0; i < limit; ++i) {
             const auto& ftj = arr[i];
+            if (ftj.value("vector", false)) {
+                auto& ft = obj.faceTextures[i];
+                ft.createVector(ftj.value("baseColor", 0xFFFFFFFFu),
+                                ftj.value("size", std::max(obj.getVectorFaceTextureResolution(), 64)));
+                ft.vector->setDabs(VectorTexture::unpackDabs(base64Decode(ftj.value("dabsB64", std::string()))),
+                                   ftj.value("strokeStarts", std::vector<uint32_t>{}));
+                continue;
+            }
+            if (ftj.value("sparse", false)) {
+                auto& ft = obj.faceTextures[i];
+                ft.createSparse(ftj.value("size", obj.getSparseFaceTextureSize()),
+                                ftj.value("baseColor", 0xFFFFFFFFu),
+                                ftj.value("tileSize", static_cast<int>(SparseTexture::DefaultTileSize)));
+                if (ftj.contains("tiles")) {
+                    for (const auto& tj : ftj["tiles"]) {
+                        ft.sparse->setTilePixels(tj.value("x", -1), tj.value("y", -1),
+                                                 base64Decode(tj.value("pixelsB64", std::string())));
+                    }
+                }
+                ft.uploadToGPU();
+                continue;
+            }
             int size = ftj.value("size", (i < static_cast<int>(obj.faceTextures.size()) ? obj.faceTextures[i].size : 64));
             std::string b64 = ftj.value("pixelsB64", std::string());
             if (!b64.empty()) {
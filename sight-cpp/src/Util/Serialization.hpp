@@ -4,6 +4,13 @@
 #include "Form/Object/Object.hpp"
 #include "ZonesOfEarth/World/World.hpp"
 #include <glm/gtc/type_ptr.hpp>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// Base64 for binary blobs embedded in JSON (pixel buffers, packed strokes)
+std::string base64Encode(const std::vector<uint8_t>& data);
+std::vector<uint8_t> base64Decode(const std::string& input);
 
 // Free functions enabling nlohmann::json (ADL) serialization
 
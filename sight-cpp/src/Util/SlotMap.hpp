@@ -0,0 +1,179 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+
+// Handle into a SlotMap: slot index plus the generation the slot had when the
+// value was inserted. A handle whose value was removed stops resolving, even
+// after its slot is reused.
+struct SlotHandle {
+    uint32_t index = 0;
+    uint32_t generation = 0;   // 0 is never issued, so a default handle is always invalid
+
+    bool isValid() const { return generation != 0; }
+    uint64_t value() const { return (static_cast<uint64_t>(generation) << 32) | index; }
+    static SlotHandle fromValue(uint64_t v) {
+        return SlotHandle{static_cast<uint32_t>(v & 0xFFFFFFFFu), static_cast<uint32_t>(v >> 32)};
+    }
+    bool operator==(const SlotHandle& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const SlotHandle& other) const { return !(*this == other); }
+};
+
+// Generational slot map with O(1) insert, erase and lookup.
+// Values live in one dense array in insertion order, so iteration is a linear
+// walk. Erase leaves a tombstone instead of shifting (which would make removal
+// O(n) and reorder what is drawn on top); tombstones are compacted away in
+// order once they make up half the array, so erase stays amortized O(1).
+template <typename T>
+class SlotMap {
+public:
+    SlotHandle insert(T value) {
+        uint32_t slotIndex;
+        if (_freeHead != NoSlot) {
+            slotIndex = _freeHead;
+            _freeHead = _slots[slotIndex].dense;
+        } else {
+            slotIndex = static_cast<uint32_t>(_slots.size());
+            _slots.push_back(Slot{NoSlot, 0});
+        }
+        Slot& slot = _slots[slotIndex];
+        if (++slot.generation == 0) slot.generation = 1; // skip the invalid generation on wrap
+        slot.dense = static_cast<uint32_t>(_values.size());
+        _values.push_back(std::move(value));
+        _denseToSlot.push_back(slotIndex);
+        ++_size;
+        return SlotHandle{slotIndex, slot.generation};
+    }
+
+    // Insert so the value iterates just before `next` (appends if `next` is
+    // not live). O(n): it shifts the dense array, so keep it off hot paths.
+    SlotHandle insertBefore(SlotHandle next, T value) {
+        if (!contains(next)) return insert(std::move(value));
+        uint32_t position = _slots[next.index].dense;
+        SlotHandle handle = insert(std::move(value));
+        uint32_t added = _slots[handle.index].dense;
+        for (uint32_t i = added; i > position; --i) {
+            std::swap(_values[i], _values[i - 1]);
+            std::swap(_denseToSlot[i], _denseToSlot[i - 1]);
+            if (_denseToSlot[i] != NoSlot) _slots[_denseToSlot[i]].dense = i;
+        }
+        _slots[handle.index].dense = position;
+        return handle;
+    }
+
+    bool erase(SlotHandle handle) {
+        if (!contains(handle)) return false;
+        Slot& slot = _slots[handle.index];
+        _denseToSlot[slot.dense] = NoSlot;
+        _values[slot.dense] = T();          // release the value's resources now
+        ++slot.generation;                  // outstanding handles stop resolving
+        if (slot.generation == 0) slot.generation = 1;
+        slot.dense = _freeHead;
+        _freeHead = handle.index;
+        --_size;
+        if (_values.size() - _size > _size) compact();
+        return true;
+    }
+
+    bool contains(SlotHandle handle) const {
+        return handle.isValid() && handle.index < _slots.size() &&
+               _slots[handle.index].generation == handle.generation &&
+               _slots[handle.index].dense != NoSlot && isLive(handle.index);
+    }
+
+    T* get(SlotHandle handle) { return contains(handle) ? &_values[_slots[handle.index].dense] : nullptr; }
+    const T* get(SlotHandle handle) const { return contains(handle) ? &_values[_slots[handle.index].dense] : nullptr; }
+
+    void clear() {
+        // Bump every live slot so old handles can't resolve into new values
+        for (uint32_t i = 0; i < _slots.size(); ++i) {
+            if (isLive(i) && ++_slots[i].generation == 0) _slots[i].generation = 1;
+        }
+        _values.clear();
+        _denseToSlot.clear();
+        _freeHead = NoSlot;
+        for (uint32_t i = static_cast<uint32_t>(_slots.size()); i-- > 0;) {
+            _slots[i].dense = _freeHead;
+            _freeHead = i;
+        }
+        _size = 0;
+    }
+
+    size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+
+    // Iteration-order position of a live handle. Positions shift on compaction but
+    // keep their relative order, so they are only good for comparing handles.
+    size_t positionOf(SlotHandle handle) const { return _slots[handle.index].dense; }
+
+    // Handle of the value at dense position `i` (valid only for live positions)
+    SlotHandle handleAt(size_t i) const {
+        uint32_t slotIndex = _denseToSlot[i];
+        return SlotHandle{slotIndex, _slots[slotIndex].generation};
+    }
+
+    // Forward iteration over live values in insertion order
+    template <typename MapT, typename ValueT>
+    class Iterator {
+    public:
+        Iterator(MapT* map, size_t pos) : _map(map), _pos(pos) { skipDead(); }
+        ValueT& operator*() const { return _map->_values[_pos]; }
+        ValueT* operator->() const { return &_map->_values[_pos]; }
+        Iterator& operator++() { ++_pos; skipDead(); return *this; }
+        bool operator!=(const Iterator& other) const { return _pos != other._pos; }
+        bool operator==(const Iterator& other) const { return _pos == other._pos; }
+        SlotHandle handle() const { return _map->handleAt(_pos); }
+    private:
+        void skipDead() {
+            while (_pos < _map->_values.size() && _map->_denseToSlot[_pos] == NoSlot) ++_pos;
+        }
+        MapT* _map;
+        size_t _pos;
+    };
+    using iterator = Iterator<SlotMap, T>;
+    using const_iterator = Iterator<const SlotMap, const T>;
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, _values.size()); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, _values.size()); }
+
+private:
+    static constexpr uint32_t NoSlot = 0xFFFFFFFFu;
+
+    // For a live slot `dense` is its position in _values; for a free slot it
+    // links to the next free slot.
+    struct Slot {
+        uint32_t dense;
+        uint32_t generation;
+    };
+
+    std::vector<T> _values;
+    std::vector<uint32_t> _denseToSlot;   // NoSlot marks a tombstone
+    std::vector<Slot> _slots;
+    uint32_t _freeHead = NoSlot;
+    size_t _size = 0;
+
+    bool isLive(uint32_t slotIndex) const {
+        uint32_t dense = _slots[slotIndex].dense;
+        return dense < _denseToSlot.size() && _denseToSlot[dense] == slotIndex;
+    }
+
+    void compact() {
+        size_t write = 0;
+        for (size_t read = 0; read < _values.size(); ++read) {
+            uint32_t slotIndex = _denseToSlot[read];
+            if (slotIndex == NoSlot) continue;
+            if (write != read) {
+                _values[write] = std::move(_values[read]);
+                _denseToSlot[write] = slotIndex;
+            }
+            _slots[slotIndex].dense = static_cast<uint32_t>(write);
+            ++write;
+        }
+        _values.resize(write);
+        _denseToSlot.resize(write);
+    }
+};
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <deque>
+#include <unordered_map>
+#include <mutex>
+#include <cstdint>
+
+// Maps strings to small stable IDs so repeated names can be stored and compared
+// as integers. IDs are never reused; 0 is always the empty string.
+// Thread-safe.
+class StringInterner {
+public:
+    StringInterner() { intern(std::string_view()); }
+
+    uint32_t intern(std::string_view text) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _ids.find(text);
+        if (it != _ids.end()) return it->second;
+        // Deque elements never move, so the map can key on views into them
+        _strings.emplace_back(text);
+        uint32_t id = static_cast<uint32_t>(_strings.size() - 1);
+        _ids.emplace(std::string_view(_strings.back()), id);
+        return id;
+    }
+
+    static constexpr uint32_t NotFound = 0xFFFFFFFFu;
+
+    // Like intern() but never adds: NotFound for text not interned yet
+    uint32_t find(std::string_view text) const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _ids.find(text);
+        return it != _ids.end() ? it->second : NotFound;
+    }
+
+    // Unknown IDs give the empty string
+    std::string lookup(uint32_t id) const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return id < _strings.size() ? _strings[id] : std::string();
+    }
+
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _strings.size();
+    }
+
+private:
+    mutable std::mutex _mutex;
+    std::deque<std::string> _strings;
+    std::unordered_map<std::string_view, uint32_t> _ids;
+};
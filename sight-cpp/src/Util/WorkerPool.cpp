@@ -0,0 +1,76 @@
+#include "WorkerPool.hpp"
+#include <algorithm>
+
+namespace {
+// Set on pool threads so a nested parallelFor runs inline
+thread_local bool t_inPool = false;
+}
+
+WorkerPool& WorkerPool::instance() {
+    // Never destroyed: workers sleep until process exit rather than being
+    // joined during static destruction
+    static WorkerPool* pool = new WorkerPool(std::max(1u, std::thread::hardware_concurrency()) - 1);
+    return *pool;
+}
+
+WorkerPool::WorkerPool(size_t workers) {
+    _threads.reserve(workers);
+    for (size_t i = 0; i < workers; ++i) _threads.emplace_back(&WorkerPool::workerLoop, this);
+}
+
+void WorkerPool::Job::work() {
+    for (size_t chunk = nextChunk.fetch_add(1, std::memory_order_relaxed); chunk < chunkCount;
+         chunk = nextChunk.fetch_add(1, std::memory_order_relaxed)) {
+        const size_t begin = chunk * chunkSize;
+        fn(context, begin, std::min(count, begin + chunkSize));
+    }
+}
+
+void WorkerPool::workerLoop() {
+    t_inPool = true;
+    uint64_t seen = 0;
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (true) {
+        _wake.wait(lock, [&] { return _job && _generation != seen; });
+        seen = _generation;
+        Job* job = _job;
+        ++job->attached;
+        lock.unlock();
+        job->work();
+        lock.lock();
+        if (--job->attached == 0) _detached.notify_all();
+    }
+}
+
+void WorkerPool::run(size_t count, size_t grain, RangeFn fn, void* context) {
+    // A few chunks per thread so uneven ranges balance out
+    const size_t chunkCount = std::min(count / std::max<size_t>(grain, 1), concurrency() * 4);
+    if (chunkCount <= 1 || t_inPool || !_submitMutex.try_lock()) {
+        if (count) fn(context, 0, count);
+        return;
+    }
+    std::lock_guard<std::mutex> submit(_submitMutex, std::adopt_lock);
+
+    Job job;
+    job.fn = fn;
+    job.context = context;
+    job.count = count;
+    job.chunkSize = (count + chunkCount - 1) / chunkCount;
+    job.chunkCount = (count + job.chunkSize - 1) / job.chunkSize;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _job = &job;
+        ++_generation;
+    }
+    _wake.notify_all();
+
+    t_inPool = true;
+    job.work();
+    t_inPool = false;
+
+    // Every chunk has been claimed; wait for the workers still finishing
+    // theirs and keep late wakers from picking up a job that is going away
+    std::unique_lock<std::mutex> lock(_mutex);
+    _job = nullptr;
+    _detached.wait(lock, [&] { return job.attached == 0; });
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Process-wide set of worker threads for data-parallel loops. Threads are
+// started once and sleep between jobs, so a caller that splits work many
+// times a frame (a blur pass, every level of a BFS) pays a wake-up rather
+// than a thread creation per split.
+//
+// One job runs at a time. A parallelFor() issued while another job is
+// running, or from inside a job, runs on the calling thread instead of
+// waiting, so nesting and concurrent callers never deadlock.
+class WorkerPool {
+public:
+    static WorkerPool& instance();
+
+    // Calls fn(begin, end) over [0, count) in chunks of at least `grain`,
+    // spread across the workers and the calling thread, and returns once
+    // every chunk is done. Ranges are disjoint. fn must not throw.
+    template <typename Fn>
+    void parallelFor(size_t count, size_t grain, Fn&& fn) {
+        using F = std::remove_reference_t<Fn>;
+        run(count, grain, [](void* context, size_t begin, size_t end) { (*static_cast<F*>(context))(begin, end); },
+            const_cast<void*>(static_cast<const void*>(&fn)));
+    }
+
+    // Threads that can work on a job, counting the caller
+    size_t concurrency() const { return _threads.size() + 1; }
+
+private:
+    using RangeFn = void (*)(void* context, size_t begin, size_t end);
+
+    struct Job {
+        RangeFn fn;
+        void* context;
+        size_t count;
+        size_t chunkSize;
+        size_t chunkCount;
+        std::atomic<size_t> nextChunk{0};
+        size_t attached = 0;           // workers inside work(); guarded by _mutex
+
+        void work();
+    };
+
+    explicit WorkerPool(size_t workers);
+    void run(size_t count, size_t grain, RangeFn fn, void* context);
+    void workerLoop();
+
+    std::vector<std::thread> _threads;
+    std::mutex _submitMutex;           // held by the caller for the whole job
+    std::mutex _mutex;
+    std::condition_variable _wake;
+    std::condition_variable _detached;
+    Job* _job = nullptr;
+    uint64_t _generation = 0;
+};
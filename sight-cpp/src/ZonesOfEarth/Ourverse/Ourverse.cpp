@@ -138,9 +138,9 @@ void Ourverse::renderModeUI() {
                 law.target.limitByObjectType = byType;
                 if (byType && typeBuf[0]) law.target.objectTypes = { std::string(typeBuf) };
                 law.target.limitByAttribute = byAttr;
-                if (byAttr) { law.target.attributeKey = attrKey; law.target.attributeValue = attrVal; }
+                if (byAttr) law.target.setAttributeFilter(attrKey, attrVal);
                 law.target.limitByTag = byTag;
-                if (byTag && tagBuf[0]) law.target.tag = tagBuf;
+                if (byTag && tagBuf[0]) law.target.setTagFilter(tagBuf);
                 addLaw(law);
                 nameBuf[0] = '\0'; typeIdx = 0; strength = 9.81f; damping = 0.1f; direction = glm::vec3(0, -1, 0);
             }
@@ -188,7 +188,7 @@ void Ourverse::renderModeUI() {
                             std::string id = o->getIdentifier();
                             if (!id.empty()) {
                                 sel->target.limitByExplicitList = true;
-                                sel->target.objectIdentifiers.push_back(id);
+                                sel->target.objectIdentifiers.add(id);
                             }
                             break;
                         }
@@ -198,7 +198,7 @@ void Ourverse::renderModeUI() {
                 /*
                 {
                     std::unordered_set<std::string> ids;
-                    for (const auto& id : sel->target.objectIdentifiers) ids.insert(id);
+                    for (const auto& id : sel->target.objectIdentifiers.names()) ids.insert(id);
                     // Avoid direct include dependency to keep UI isolated; forward-declare linkage is not practical here.
                     // Instead, update via a simple global hook exposed in HighlightSystem
                     extern void HighlightSystem_setLawIds(const std::unordered_set<std::string>&);
@@ -263,7 +263,7 @@ void Ourverse::renderModeUI() {
                 if (ImGui::Button("Apply selection to law")) {
                     sel->target.limitByExplicitList = true;
                     sel->target.objectIdentifiers.clear();
-                    for (const auto& kv : selectedById) if (kv.second) sel->target.objectIdentifiers.push_back(kv.first);
+                    for (const auto& kv : selectedById) if (kv.second) sel->target.objectIdentifiers.add(kv.first);
                     // Publish list to highlight system for red outline
                     Rendering::HighlightSystem::setLawCandidateIds({});
                     {
@@ -286,7 +286,7 @@ void Ourverse::renderModeUI() {
                 ImGui::SameLine(); if (ImGui::Button("Add ID to Law")) {
                     if (idBuf[0]) {
                         sel->target.limitByExplicitList = true;
-                        sel->target.objectIdentifiers.push_back(std::string(idBuf));
+                        sel->target.objectIdentifiers.add(std::string(idBuf));
                         std::unordered_set<std::string> ids;
                         for (const auto& kv : selectedById) if (kv.second) ids.insert(kv.first);
                         ids.insert(std::string(idBuf));
@@ -302,30 +302,6 @@ void Ourverse::renderModeUI() {
     }
 }
 
-void Ourverse::updateObjectCollisions(glm::vec3& position, const Object& obj, const glm::mat4& transform) const {
-    obj.updateCollisionZone(transform);
-    if (obj.isPointInside(position)) {
-        // Push the position out to the nearest face of the cube's AABB
-        glm::vec3 minCorner = obj.collisionZone.corners[0];
-        glm::vec3 maxCorner = obj.collisionZone.corners[0];
-        for (int i = 1; i < 8; ++i) {
-            minCorner = glm::min(minCorner, obj.collisionZone.corners[i]);
-            maxCorner = glm::max(maxCorner, obj.collisionZone.corners[i]);
-        }
-        // Find the closest face and move the position to that face
-        float dx = std::min(std::abs(position.x - minCorner.x), std::abs(position.x - maxCorner.x));
-        float dy = std::min(std::abs(position.y - minCorner.y), std::abs(position.y - maxCorner.y));
-        float dz = std::min(std::abs(position.z - minCorner.z), std::abs(position.z - maxCorner.z));
-        if (dx <= dy && dx <= dz) {
-            position.x = (std::abs(position.x - minCorner.x) < std::abs(position.x - maxCorner.x)) ? minCorner.x : maxCorner.x;
-        } else if (dy <= dx && dy <= dz) {
-            position.y = (std::abs(position.y - minCorner.y) < std::abs(position.y - maxCorner.y)) ? minCorner.y : maxCorner.y;
-        } else {
-            position.z = (std::abs(position.z - minCorner.z) < std::abs(position.z - maxCorner.z)) ? minCorner.z : maxCorner.z;
-        }
-    }
-}
-
 void Ourverse::onUpdate(float deltaTime) {
     if (!cameraPos) return;
     // Determine the visible ground height so physics collisions align with the rendered plane
@@ -347,17 +323,11 @@ void Ourverse::onUpdate(float deltaTime) {
         Physics::setFlying(false);
     }
     if (physicsEnabled) {
-        // Ensure every owned object has a physics body (zone-level toggle is true by default)
-        for (const auto& upObj : ownedObjects) {
-            if (upObj) {
-                Physics::getBodyFor(upObj.get());
-            }
-        }
-
-        // Step physics for all object bodies and bonds
-        Physics::updateBodies(ownedObjects, deltaTime, /*gravityAccel*/ 9.81f, /*airResistance*/ 0.1f, groundY);
+        // Step physics for all object bodies and bonds (every owned object
+        // gets a body; the zone-level toggle is true by default)
+        Physics::updateBodies(*_hot, deltaTime, /*gravityAccel*/ 9.81f, /*airResistance*/ 0.1f, groundY);
 
-        Physics::enforceCollisions(*cameraPos, ownedObjects);
+        Physics::enforceCollisions(*cameraPos, *_hot);
     }
 }
 
@@ -38,17 +38,20 @@ public:
     void display() const;
     void renderModeUI();
 
-    void updateObjectCollisions(glm::vec3& position, const Object& obj, const glm::mat4& transform) const;
-
     void onUpdate(float deltaTime = 0.016f);
 
     void setCamera(glm::vec3* cam) { cameraPos = cam; }
     glm::vec3* getCamera() const { return cameraPos; }
 
-    void addOwnedObject(std::unique_ptr<Object> obj) { ownedObjects.push_back(std::move(obj)); }
+    void addOwnedObject(std::unique_ptr<Object> obj) {
+        if (!obj) return;
+        obj->moveHotTo(*_hot);
+        ownedObjects.push_back(std::move(obj));
+    }
     const std::vector<std::unique_ptr<Object>>& getOwnedObjects() const { return ownedObjects; }
 
-    // Mutable access (use with caution)
+    // Mutable access (use with caution; add objects through addOwnedObject
+    // so physics sees them)
     std::vector<std::unique_ptr<Object>>& getOwnedObjectsMutable() { return ownedObjects; }
 
     // Remove all objects spawned dynamically (keep baseline 0 and 1)
@@ -59,6 +62,8 @@ public:
 
 private:
     glm::vec3* cameraPos = nullptr;
+    // Declared before the objects so it outlives the records they release
+    std::unique_ptr<ObjectHotStore> _hot = std::make_unique<ObjectHotStore>();
     std::vector<std::unique_ptr<Object>> ownedObjects;
 };
 
@@ -7,6 +7,7 @@
 #include <algorithm>
 #include <unordered_map>
 #include <unordered_set>
+#include <deque>
 #include <cfloat>
 #include <atomic>
 #include <cmath>
@@ -26,8 +27,19 @@ namespace Physics {
 
     static bool isFlying = false;
 
-    // Map Object* to RigidBody
-    static std::unordered_map<Object*, RigidBody> g_objectBodies;
+    // Rigid bodies of world Objects. An object's slot is kept in its hot
+    // record and handed back through the store's release hook when the
+    // record goes; the owner column catches slots left over from a reset.
+    // A deque so references survive new bodies.
+    static std::deque<RigidBody> g_bodies;
+    static std::vector<const Object*> g_bodyOwners;
+    static std::vector<uint32_t> g_freeBodies;
+
+    static RigidBody* findBody(const Object* obj) {
+        uint32_t slot = obj->getPhysicsBody();
+        if (slot >= g_bodies.size() || g_bodyOwners[slot] != obj) return nullptr;
+        return &g_bodies[slot];
+    }
     // Global gravity field parameters
     static float g_gravityConstant = 1.0f;      // Tunable G for gameplay scale
     static float g_softeningEps    = 0.25f;     // Softening to avoid singularities in 1/r^2
@@ -37,6 +49,99 @@ namespace Physics {
     // Bond list
     static std::vector<Bond> g_bonds;
 
+    // Event scope for collisions in the world currently being stepped
+    static Core::EventBus::ScopeId g_eventScope = Core::EventBus::GlobalScope;
+
+    void setEventScope(Core::EventBus::ScopeId scope){ g_eventScope = scope; }
+    Core::EventBus::ScopeId getEventScope(){ return g_eventScope; }
+
+    // Touching pairs from the last two steps of one world, keyed by (lower, higher)
+    // packed EntityId, which unlike an address is never reused by a later object.
+    // The maps swap every step and are cleared rather than freed, so steady-state
+    // stepping does not allocate.
+    using ContactKey = std::pair<uint64_t, uint64_t>;
+    struct ContactKeyHash {
+        size_t operator()(const ContactKey& k) const {
+            return std::hash<uint64_t>()(k.first * 0x9E3779B97F4A7C15ull ^ k.second);
+        }
+    };
+    struct ContactBuffer {
+        std::unordered_map<ContactKey, Contact, ContactKeyHash> current;
+        std::unordered_map<ContactKey, Contact, ContactKeyHash> previous;
+    };
+
+    // One buffer per event scope, i.e. per stepping world
+    static std::unordered_map<Core::EventBus::ScopeId, ContactBuffer> g_contactBuffers;
+    static bool g_reportStayContacts = false;
+
+    void setReportStayContacts(bool enabled){ g_reportStayContacts = enabled; }
+    bool getReportStayContacts(){ return g_reportStayContacts; }
+    void clearContacts(){ g_contactBuffers.clear(); }
+
+    static void beginContactStep(ContactBuffer& buffer){
+        std::swap(buffer.current, buffer.previous);
+        buffer.current.clear();
+    }
+
+    static void addContact(ContactBuffer& buffer, Object* a, Object* b, const glm::vec3& point, const glm::vec3& normal, float impactForce){
+        const EntityId idA = a->entityId(), idB = b->entityId();
+        ContactKey key = std::minmax(idA.value(), idB.value());
+        Contact& contact = buffer.current[key];
+        contact.idA = idA;
+        contact.idB = idB;
+        contact.point = point;
+        contact.normal = normal;
+        contact.impactForce = impactForce;
+    }
+
+    // Live cells of the store being stepped and their objects, gathered once
+    // per step. Kept between steps so stepping does not allocate.
+    struct StepCell {
+        uint32_t index;
+        Object* obj;
+    };
+    static std::vector<StepCell> g_stepCells;
+
+    // Diff this step's pairs against the last step's and publish the transitions as one batch
+    static void endContactStep(ContactBuffer& buffer, float deltaTime){
+        PhysicsContactBatchEvent batch;
+        batch.activeCount = buffer.current.size();
+        batch.deltaTime = deltaTime;
+
+        auto& eventBus = Core::EventBus::instance();
+        size_t stayCount = 0;
+        for (auto& entry : buffer.current) {
+            Contact& contact = entry.second;
+            if (buffer.previous.count(entry.first)) {
+                contact.phase = ContactPhase::Stay;
+                ++stayCount;
+                if (g_reportStayContacts) batch.contacts.push_back(contact);
+            } else {
+                contact.phase = ContactPhase::Begin;
+                batch.contacts.push_back(contact);
+                PhysicsCollisionEvent collisionEvent(contact.idA, contact.idB, contact.point, contact.normal, contact.impactForce);
+                eventBus.publishDeferred(Core::EventBus::FramePhase::PostPhysics, collisionEvent, g_eventScope);
+            }
+        }
+
+        if (buffer.previous.size() > stayCount) {
+            // Pairs can also end because one side left the world; only report ends between live objects
+            std::unordered_set<uint64_t> live;
+            live.reserve(g_stepCells.size());
+            for (const StepCell& cell : g_stepCells) if (cell.obj->hasEntityId()) live.insert(cell.obj->entityId().value());
+            for (const auto& entry : buffer.previous) {
+                if (buffer.current.count(entry.first)) continue;
+                if (!live.count(entry.first.first) || !live.count(entry.first.second)) continue;
+                Contact contact = entry.second;
+                contact.phase = ContactPhase::End;
+                batch.contacts.push_back(contact);
+            }
+        }
+
+        if (!batch.contacts.empty())
+            eventBus.publishDeferred(Core::EventBus::FramePhase::PostPhysics, batch, g_eventScope);
+    }
+
     const std::vector<Bond>& getBonds(){ return g_bonds; }
 
     bool setBondParams(Object* a, Object* b, float restLength, float strength){
@@ -84,6 +189,23 @@ namespace Physics {
         }), g_bonds.end());
     }
 
+    // Hot store release hook: recycle the slot and drop the object's bonds
+    static void releaseBody(uint32_t slot, const Object* owner) {
+        if (!owner || slot >= g_bodies.size() || g_bodyOwners[slot] != owner) return;
+        g_bodies[slot] = RigidBody();
+        g_bodyOwners[slot] = nullptr;
+        g_freeBodies.push_back(slot);
+        g_bonds.erase(std::remove_if(g_bonds.begin(), g_bonds.end(), [owner](const Bond& bond){
+            return bond.a == owner || bond.b == owner;
+        }), g_bonds.end());
+    }
+
+    // Destroyed before the registries above, so objects that outlive them
+    // (static or leaked worlds) no longer call back into them
+    static struct BodyHookGuard {
+        ~BodyHookGuard() { ObjectHotStore::setBodyReleaseHook(nullptr); }
+    } g_bodyHookGuard;
+
     // Helper to extract & update object position via its transform
     static glm::vec3 getObjectPos(const Object* obj) {
         glm::mat4 t = obj->getTransform();
@@ -96,7 +218,27 @@ namespace Physics {
         obj->setTransform(t);
     }
 
-    void updateBodies(std::vector<std::unique_ptr<Object>>& objects,
+    // Record bounds, refreshed through the owner only when the record is stale
+    static const ObjectHot& cellBounds(const ObjectHotStore& store, const StepCell& cell) {
+        const ObjectHot& hot = store[cell.index];
+        return (hot.flags & ObjectHot::BoundsStale) ? cell.obj->bounds() : hot;
+    }
+
+    static glm::vec3 centerOfMass(const ObjectHotStore& store, const LawTarget& target) {
+        glm::vec3 sumWeighted(0.0f);
+        double totalMass = 0.0;
+        for (const StepCell& cell : g_stepCells) {
+            if (!objectMatchesTarget(*cell.obj, target)) continue;
+            float m = g_bodies[store[cell.index].body].mass;
+            if (m <= 0.0f) continue;
+            sumWeighted += glm::vec3(store[cell.index].transform[3]) * m;
+            totalMass += m;
+        }
+        if (totalMass <= 1e-8) return glm::vec3(0.0f);
+        return sumWeighted / static_cast<float>(totalMass);
+    }
+
+    void updateBodies(ObjectHotStore& objects,
                       float deltaTime,
                       float gravityAccel,
                       float airResistance,
@@ -105,11 +247,29 @@ namespace Physics {
         // We keep legacy gravity/air as fallback when no laws exist
         const auto& laws = getLaws();
 
+        // Walk the store's records in order; objects are only touched for
+        // law matching and for writing back transforms. Cells are addressed by
+        // index throughout since a custom law may add objects to the store.
+        g_stepCells.clear();
+        for (uint32_t i = 0; i < objects.records().size(); ++i) {
+            const Object* owner = objects.ownerAt(i);
+            if ((objects[i].flags & ObjectHot::Live) && owner) g_stepCells.push_back({i, const_cast<Object*>(owner)});
+        }
+
+        // 0. Every object gets a body, its mass synced from the "mass" attribute.
+        // After this the record's body slot is valid for the rest of the step.
+        for (const StepCell& cell : g_stepCells) getBodyFor(cell.obj);
+
+        // CenterGravity pulls toward the center of mass as of the start of the step
+        std::unordered_map<int, glm::vec3> centers;
+        for (const auto& law : laws) {
+            if (law.enabled && law.type == LawType::CenterGravity) centers[law.id] = centerOfMass(objects, law.target);
+        }
+
         // 1. Clear forces & apply gravity to each body
-        for (const auto& upObj : objects) {
-            if (!upObj) continue;
-            auto* obj = upObj.get();
-            RigidBody& body = getBodyFor(obj);
+        for (const StepCell& cell : g_stepCells) {
+            Object* obj = cell.obj;
+            RigidBody& body = g_bodies[objects[cell.index].body];
             clearForces(body);
             bool appliedAny = false;
             for (const auto& law : laws) {
@@ -135,8 +295,8 @@ namespace Physics {
                     }
                     case LawType::CenterGravity: {
                         // Pull toward current world center-of-mass of all eligible objects
-                        glm::vec3 com = computeWorldCenterOfMass(objects, &law.target);
-                        glm::vec3 pos = getObjectPos(obj);
+                        glm::vec3 com = centers[law.id];
+                        glm::vec3 pos = glm::vec3(objects[cell.index].transform[3]);
                         glm::vec3 delta = com - pos;
                         float len = glm::length(delta);
                         if (len > 1e-4f) {
@@ -181,17 +341,19 @@ namespace Physics {
             if (law.enabled && law.type == LawType::GravityField) { anyGravityField = true; gravityFieldTarget = law.target; break; }
         }
         if (anyGravityField) {
-            const size_t count = objects.size();
+            const size_t count = g_stepCells.size();
             for (size_t i = 0; i < count; ++i) {
-                Object* a = objects[i].get(); if (!a) continue; if (!objectMatchesTarget(*a, gravityFieldTarget)) continue;
-                glm::vec3 posA = getObjectPos(a);
-                RigidBody& bodyA = getBodyFor(a);
-                float massA = getObjectMass(a, bodyA.mass);
+                const StepCell& a = g_stepCells[i];
+                if (!objectMatchesTarget(*a.obj, gravityFieldTarget)) continue;
+                glm::vec3 posA = glm::vec3(objects[a.index].transform[3]);
+                RigidBody& bodyA = g_bodies[objects[a.index].body];
+                float massA = bodyA.mass;
                 for (size_t j = i + 1; j < count; ++j) {
-                    Object* b = objects[j].get(); if (!b) continue; if (!objectMatchesTarget(*b, gravityFieldTarget)) continue;
-                    glm::vec3 posB = getObjectPos(b);
-                    RigidBody& bodyB = getBodyFor(b);
-                    float massB = getObjectMass(b, bodyB.mass);
+                    const StepCell& b = g_stepCells[j];
+                    if (!objectMatchesTarget(*b.obj, gravityFieldTarget)) continue;
+                    glm::vec3 posB = glm::vec3(objects[b.index].transform[3]);
+                    RigidBody& bodyB = g_bodies[objects[b.index].body];
+                    float massB = bodyB.mass;
                     glm::vec3 r = posB - posA;
                     float dist2 = glm::dot(r, r) + g_softeningEps * g_softeningEps;
                     if (dist2 <= 1e-12f) continue;
@@ -222,24 +384,22 @@ namespace Physics {
         }
 
         // Auto-create bonds based on geometry rules (simple n^2 loop for now)
-        for(size_t i=0;i<objects.size();++i){
-            for(size_t j=i+1;j<objects.size();++j){
-                Object* oa = objects[i].get();
-                Object* ob = objects[j].get();
-                if(!oa||!ob) continue;
-                if(!getAutoBond(oa->getGeometryType(), ob->getGeometryType())) continue;
-                // check duplicate
-                bool exists=false; for(const auto& b : g_bonds){ if((b.a==oa&&b.b==ob)||(b.a==ob&&b.b==oa)){exists=true;break;} }
-                if(!exists) addBond(oa,ob,1.0f,10.0f);
+        if (!g_autoBondRules.empty()) {
+            for(size_t i=0;i<g_stepCells.size();++i){
+                for(size_t j=i+1;j<g_stepCells.size();++j){
+                    Object* oa = g_stepCells[i].obj;
+                    Object* ob = g_stepCells[j].obj;
+                    if(!getAutoBond(oa->getGeometryType(), ob->getGeometryType())) continue;
+                    addBond(oa,ob,1.0f,10.0f); // ignores existing pairs
+                }
             }
         }
 
         // 3. Integrate each body and update object transforms
-        for (const auto& upObj : objects) {
-            if (!upObj) continue;
-            auto* obj = upObj.get();
-            RigidBody& body = getBodyFor(obj);
-            glm::vec3 pos = getObjectPos(obj);
+        for (const StepCell& cell : g_stepCells) {
+            Object* obj = cell.obj;
+            RigidBody& body = g_bodies[objects[cell.index].body];
+            glm::vec3 pos = glm::vec3(objects[cell.index].transform[3]);
             // Use baseline unless an AirResistance law targets this object
             bool airLawForObject = false;
             for (const auto& law : laws) {
@@ -252,35 +412,29 @@ namespace Physics {
         }
 
         // 4. Detect and resolve object-object collisions (AABB) -----------
-        // First update collision zones for all objects using latest transforms
-        for(const auto& upObj : objects){
-            if(!upObj) continue;
-            upObj->updateCollisionZone(upObj->getTransform());
-        }
+        // Bounds are cached per record and recomputed only for objects that moved
+
+        ContactBuffer& contacts = g_contactBuffers[g_eventScope];
+        beginContactStep(contacts);
 
-        const size_t objCount = objects.size();
+        const size_t objCount = g_stepCells.size();
         // If at least one Collision law exists, only resolve collisions for objects matching any Collision law target
         bool anyCollisionLaw = false; for (const auto& law : laws) { if (law.enabled && law.type == LawType::Collision) { anyCollisionLaw = true; break; } }
         for(size_t i = 0; i < objCount; ++i){
-            if(!objects[i]) continue;
-            // Skip the ground placeholder at index 1 (handled separately by groundY plane)
-            if(i == 1) continue;
-            Object* a = objects[i].get();
-            // Compute AABB for object A
-            glm::vec3 minA( FLT_MAX), maxA(-FLT_MAX);
-            for(const auto& corner : a->collisionZone.corners){
-                minA = glm::min(minA, corner);
-                maxA = glm::max(maxA, corner);
-            }
+            const StepCell& cellA = g_stepCells[i];
+            // Skip the ground placeholder (handled separately by groundY plane)
+            if(objects[cellA.index].flags & ObjectHot::BaselineGround) continue;
+            Object* a = cellA.obj;
+            // AABB for object A
+            const ObjectHot& boundsA = cellBounds(objects, cellA);
+            glm::vec3 minA = boundsA.boundsMin, maxA = boundsA.boundsMax;
             for(size_t j = i + 1; j < objCount; ++j){
-                if(!objects[j]) continue;
-                if(j == 1) continue; // skip ground
-                Object* b = objects[j].get();
-                glm::vec3 minB( FLT_MAX), maxB(-FLT_MAX);
-                for(const auto& corner : b->collisionZone.corners){
-                    minB = glm::min(minB, corner);
-                    maxB = glm::max(maxB, corner);
-                }
+                const StepCell& cellB = g_stepCells[j];
+                if(objects[cellB.index].flags & ObjectHot::BaselineGround) continue; // skip ground
+                Object* b = cellB.obj;
+                const ObjectHot& boundsB = cellBounds(objects, cellB);
+                const glm::vec3& minB = boundsB.boundsMin;
+                const glm::vec3& maxB = boundsB.boundsMax;
 
                 // Check for overlap along all three axes
                 bool overlapX = (minA.x <= maxB.x) && (maxA.x >= minB.x);
@@ -323,38 +477,50 @@ namespace Physics {
                 else if(axis == 1) correction.y = pushDist * sign;
                 else correction.z = pushDist * sign;
 
-                // Apply corrections to positions
-                glm::vec3 posA = getObjectPos(a);
-                glm::vec3 posB = getObjectPos(b);
+                // Apply corrections to positions (their bounds follow on the next read)
+                glm::vec3 posA = glm::vec3(objects[cellA.index].transform[3]);
+                glm::vec3 posB = glm::vec3(objects[cellB.index].transform[3]);
                 posA += correction;
                 posB -= correction;
                 setObjectPos(a, posA);
                 setObjectPos(b, posB);
 
                 // Damp velocities along collision axis to prevent tunneling
-                RigidBody& bodyA = getBodyFor(a);
-                RigidBody& bodyB = getBodyFor(b);
+                RigidBody& bodyA = g_bodies[objects[cellA.index].body];
+                RigidBody& bodyB = g_bodies[objects[cellB.index].body];
                 if(axis == 0){ bodyA.velocity.x = 0.0f; bodyB.velocity.x = 0.0f; }
                 else if(axis == 1){ bodyA.velocity.y = 0.0f; bodyB.velocity.y = 0.0f; }
                 else { bodyA.velocity.z = 0.0f; bodyB.velocity.z = 0.0f; }
 
-                // Publish collision event for EventBus listeners
+                // Record the contact; transitions are published once the step is done
                 glm::vec3 collisionPoint = (centerA + centerB) * 0.5f;
                 glm::vec3 collisionNormal = glm::normalize(centerA - centerB);
                 float impactForce = glm::length(bodyA.velocity) + glm::length(bodyB.velocity);
-                
-                PhysicsCollisionEvent collisionEvent(a, b, collisionPoint, collisionNormal, impactForce);
-                Core::EventBus::instance().publish(collisionEvent);
-
-                // Update collision zones after correction for later pairs
-                a->updateCollisionZone(a->getTransform());
-                b->updateCollisionZone(b->getTransform());
+                addContact(contacts, a, b, collisionPoint, collisionNormal, impactForce);
             }
         }
+
+        endContactStep(contacts, deltaTime);
     }
 
     RigidBody& getBodyFor(Object* obj, float defaultMass) {
-        auto& body = g_objectBodies[obj];
+        RigidBody* existing = findBody(obj);
+        if (!existing) {
+            ObjectHotStore::setBodyReleaseHook(&releaseBody);
+            uint32_t slot;
+            if (!g_freeBodies.empty()) {
+                slot = g_freeBodies.back();
+                g_freeBodies.pop_back();
+            } else {
+                slot = static_cast<uint32_t>(g_bodies.size());
+                g_bodies.emplace_back();
+                g_bodyOwners.push_back(nullptr);
+            }
+            g_bodyOwners[slot] = obj;
+            obj->setPhysicsBody(slot);
+            existing = &g_bodies[slot];
+        }
+        auto& body = *existing;
         if (body.mass <= 0.0f) body.mass = defaultMass;
         // Keep body mass synchronized with object's declared mass attribute (if present)
         float attributeMass = getObjectMass(obj, body.mass);
@@ -364,7 +530,10 @@ namespace Physics {
 
     // Reset registry of rigid bodies (e.g., after loading a scene)
     void resetRigidBodies() {
-        g_objectBodies.clear();
+        g_bodies.clear();
+        g_bodyOwners.clear();
+        g_freeBodies.clear();
+        g_contactBuffers.clear();
     }
 
     // Clear all bonds
@@ -496,19 +665,15 @@ namespace Physics {
     void setupPhysicsEventListeners() {
         auto& eventBus = Core::EventBus::instance();
         
-        // Listen for physics collisions with high priority
-        eventBus.subscribe<PhysicsCollisionEvent>([](const PhysicsCollisionEvent& event) {
-            // Log collision details
-            std::cout << "Physics Collision: Objects " 
-                      << (event.objectA ? event.objectA->getIdentifier() : "Unknown") 
-                      << " and " 
-                      << (event.objectB ? event.objectB->getIdentifier() : "Unknown")
-                      << " collided with force " << event.impactForce 
-                      << " at point (" << event.collisionPoint.x << ", " << event.collisionPoint.y << ", " << event.collisionPoint.z << ")" << std::endl;
-            
-            // Record collision in physics registry (existing functionality)
-            if (event.objectA && event.objectB) {
-                recordCollision(*event.objectA, *event.objectB, event.impactForce);
+        // Record collisions from each step's contact batch with high priority.
+        // Only Begin contacts count: resting pairs touch every step and would
+        // otherwise flood the registry.
+        eventBus.subscribe<PhysicsContactBatchEvent>([](const PhysicsContactBatchEvent& batch) {
+            for (const auto& contact : batch.contacts) {
+                if (contact.phase != ContactPhase::Begin) continue;
+                Object* a = contact.objectA();
+                Object* b = contact.objectB();
+                if (a && b) recordCollision(*a, *b, contact.impactForce);
             }
             
             // You can add more collision response logic here:
@@ -520,34 +685,41 @@ namespace Physics {
         }, 10); // High priority for physics events
     }
 
+    // Pushes a point that lies inside an AABB out through the nearest face
+    static void pushOutOfBox(glm::vec3& position, const glm::vec3& minCorner, const glm::vec3& maxCorner) {
+        if (position.x < minCorner.x || position.x > maxCorner.x ||
+            position.y < minCorner.y || position.y > maxCorner.y ||
+            position.z < minCorner.z || position.z > maxCorner.z) return;
+
+        float dx = std::min(std::abs(position.x - minCorner.x), std::abs(position.x - maxCorner.x));
+        float dy = std::min(std::abs(position.y - minCorner.y), std::abs(position.y - maxCorner.y));
+        float dz = std::min(std::abs(position.z - minCorner.z), std::abs(position.z - maxCorner.z));
+
+        if (dx <= dy && dx <= dz) {
+            position.x = (std::abs(position.x - minCorner.x) < std::abs(position.x - maxCorner.x)) ? minCorner.x : maxCorner.x;
+        } else if (dy <= dx && dy <= dz) {
+            position.y = (std::abs(position.y - minCorner.y) < std::abs(position.y - maxCorner.y)) ? minCorner.y : maxCorner.y;
+        } else {
+            position.z = (std::abs(position.z - minCorner.z) < std::abs(position.z - maxCorner.z)) ? minCorner.z : maxCorner.z;
+        }
+    }
+
     void enforceCollisions(glm::vec3& position, const std::vector<std::unique_ptr<Object>>& objects) {
         for (const auto& obj : objects) {
-            // Update collision zone based on current transform
-            glm::mat4 transform = obj->getTransform();
-            obj->updateCollisionZone(transform);
-
-            if (obj->isPointInside(position)) {
-                // Determine the axis-aligned bounding box of the object
-                glm::vec3 minCorner = obj->collisionZone.corners[0];
-                glm::vec3 maxCorner = obj->collisionZone.corners[0];
-                for (int i = 1; i < 8; ++i) {
-                    minCorner = glm::min(minCorner, obj->collisionZone.corners[i]);
-                    maxCorner = glm::max(maxCorner, obj->collisionZone.corners[i]);
-                }
+            if (!obj) continue;
+            const ObjectHot& hot = obj->bounds();
+            pushOutOfBox(position, hot.boundsMin, hot.boundsMax);
+        }
+    }
 
-                // Push position out to nearest face
-                float dx = std::min(std::abs(position.x - minCorner.x), std::abs(position.x - maxCorner.x));
-                float dy = std::min(std::abs(position.y - minCorner.y), std::abs(position.y - maxCorner.y));
-                float dz = std::min(std::abs(position.z - minCorner.z), std::abs(position.z - maxCorner.z));
-
-                if (dx <= dy && dx <= dz) {
-                    position.x = (std::abs(position.x - minCorner.x) < std::abs(position.x - maxCorner.x)) ? minCorner.x : maxCorner.x;
-                } else if (dy <= dx && dy <= dz) {
-                    position.y = (std::abs(position.y - minCorner.y) < std::abs(position.y - maxCorner.y)) ? minCorner.y : maxCorner.y;
-                } else {
-                    position.z = (std::abs(position.z - minCorner.z) < std::abs(position.z - maxCorner.z)) ? minCorner.z : maxCorner.z;
-                }
-            }
+    void enforceCollisions(glm::vec3& position, const ObjectHotStore& objects) {
+        const auto& records = objects.records();
+        for (uint32_t i = 0; i < records.size(); ++i) {
+            const ObjectHot& hot = records[i];
+            if (!(hot.flags & ObjectHot::Live)) continue;
+            // Only objects that moved since their last read go back to the Object
+            if ((hot.flags & ObjectHot::BoundsStale) && objects.ownerAt(i)) objects.ownerAt(i)->bounds();
+            pushOutOfBox(position, hot.boundsMin, hot.boundsMax);
         }
     }
 
@@ -594,8 +766,7 @@ namespace Physics {
             // fallthrough to allow other filters as well
         }
         if (t.limitByExplicitList) {
-            bool found=false; for(const auto& id : t.objectIdentifiers){ if(obj.getIdentifier()==id){found=true;break;} }
-            if(!found) return false;
+            if(!t.objectIdentifiers.contains(obj.entityId())) return false;
         }
         if (t.limitByGeometry) {
             bool ok = false;
@@ -608,11 +779,15 @@ namespace Physics {
             if (!ok) return false;
         }
         if (t.limitByAttribute) {
-            if (!obj.hasAttribute(t.attributeKey)) return false;
-            if (!t.attributeValue.empty() && obj.getAttribute(t.attributeKey) != t.attributeValue) return false;
+            const AttributeValue* value = obj.findAttribute(t.attributeId);
+            if (!value) return false;
+            if (!t.attributeValue.empty()) {
+                const std::string* text = std::get_if<std::string>(value);
+                if (text ? *text != t.attributeValue : AttributeStore::toString(*value) != t.attributeValue) return false;
+            }
         }
         if (t.limitByTag) {
-            if (!obj.hasTag(t.tag)) return false;
+            if (!obj.hasTag(t.tagId)) return false;
         }
         return true;
     }
@@ -622,18 +797,12 @@ namespace Physics {
     // ---------------------------------------------------------------------
     float getObjectMass(Object* obj, float defaultMass) {
         if (!obj) return defaultMass;
-        if (obj->hasAttribute("mass")) {
-            const std::string& s = obj->getAttribute("mass");
-            if (!s.empty()) {
-                try {
-                    float v = std::stof(s);
-                    if (v > 0.0f && std::isfinite(v)) return v;
-                } catch (...) {}
-            }
-        }
+        static const AttributeKey massKey = AttributeStore::key("mass");
+        float v = obj->getAttributeFloat(massKey, 0.0f);
+        if (v > 0.0f && std::isfinite(v)) return v;
         // Fallback to registered rigid body mass
-        auto it = g_objectBodies.find(obj);
-        if (it != g_objectBodies.end() && it->second.mass > 0.0f) return it->second.mass;
+        const RigidBody* body = findBody(obj);
+        if (body && body->mass > 0.0f) return body->mass;
         return defaultMass;
     }
 
@@ -7,6 +7,8 @@
 #include "Singular.hpp"
 #include <string>
 #include <functional>
+#include <algorithm>
+#include <cstdint>
 
 namespace Physics {
 
@@ -32,6 +34,8 @@ namespace Physics {
 
     // Enforces collisions between a point (e.g., camera/player) and all objects' collision zones
     void enforceCollisions(glm::vec3& position, const std::vector<std::unique_ptr<Object>>& objects);
+    // Same against a World's hot store: a linear walk of the cached bounds
+    void enforceCollisions(glm::vec3& position, const ObjectHotStore& objects);
 
     // --- Flight state helpers ---
     void setFlying(bool enabled);
@@ -101,8 +105,10 @@ namespace Physics {
     // Modify parameters of an existing bond; returns true if found
     bool setBondParams(Object* a, Object* b, float restLength, float strength);
 
-    // Apply bond forces and integrate all registered object bodies
-    void updateBodies(std::vector<std::unique_ptr<Object>>& objects,
+    // Apply laws and bond forces, integrate and resolve collisions for every
+    // live object in the store. Walks the store's records rather than the
+    // objects, creating bodies for objects that have none.
+    void updateBodies(ObjectHotStore& objects,
                       float deltaTime,
                       float gravityAccel  = 9.81f,
                       float airResistance = 0.1f,
@@ -117,7 +123,6 @@ namespace Physics {
     // Record that gravity is acting between an object and the environment
     void recordGravity(const Singular& obj, const Singular& env, float strength = 1.0f);
 
-    /* TODO: Integrate this into our Event Bus-Handler system. */
     // Record an object-object collision relation
     void recordCollision(const Singular& a, const Singular& b, float strength = 1.0f);
 
@@ -133,22 +138,73 @@ namespace Physics {
     // Set up default physics event listeners (call this during initialization)
     void setupPhysicsEventListeners();
 
+    // Scope that collision events are published to (the stepping world's zone)
+    void setEventScope(Core::EventBus::ScopeId scope);
+    Core::EventBus::ScopeId getEventScope();
+
     // -----------------------------------------------------------------
     // Physics Events for EventBus integration
     // -----------------------------------------------------------------
+    // Collision events are delivered deferred, after objects may have been
+    // destroyed, so they name objects by EntityId; objectA()/objectB()
+    // resolve them (null once destroyed).
     struct PhysicsCollisionEvent {
-        Object* objectA{nullptr};
-        Object* objectB{nullptr};
+        EntityId idA;
+        EntityId idB;
         glm::vec3 collisionPoint{0.0f};
         glm::vec3 collisionNormal{0.0f};
         float impactForce{0.0f};
         std::time_t timestamp{0};
         
         PhysicsCollisionEvent() = default;
-        PhysicsCollisionEvent(Object* a, Object* b, const glm::vec3& point, const glm::vec3& normal, float force)
-            : objectA(a), objectB(b), collisionPoint(point), collisionNormal(normal), impactForce(force), timestamp(std::time(nullptr)) {}
+        PhysicsCollisionEvent(EntityId a, EntityId b, const glm::vec3& point, const glm::vec3& normal, float force)
+            : idA(a), idB(b), collisionPoint(point), collisionNormal(normal), impactForce(force), timestamp(std::time(nullptr)) {}
+
+        Object* objectA() const { return Object::fromEntityId(idA); }
+        Object* objectB() const { return Object::fromEntityId(idB); }
+
+        // One collision per pair (in either order) per physics flush
+        Core::DeferredKey coalesceKey() const {
+            return Core::DeferredKey(std::min(idA.value(), idB.value()), std::max(idA.value(), idB.value()));
+        }
+    };
+
+    // -----------------------------------------------------------------
+    // Contact buffer – persistent object pairs tracked across steps
+    // -----------------------------------------------------------------
+    enum class ContactPhase {
+        Begin,  // pair started touching this step
+        Stay,   // pair was already touching (only reported on request)
+        End     // pair stopped touching this step
+    };
+
+    struct Contact {
+        EntityId idA;
+        EntityId idB;
+        glm::vec3 point{0.0f};
+        glm::vec3 normal{0.0f};
+        float impactForce{0.0f};
+        ContactPhase phase{ContactPhase::Begin};
+
+        Object* objectA() const { return Object::fromEntityId(idA); }
+        Object* objectB() const { return Object::fromEntityId(idB); }
+    };
+
+    // All contact transitions from one physics step, published once per step.
+    // End contacts carry the last point/normal seen while touching.
+    struct PhysicsContactBatchEvent {
+        std::vector<Contact> contacts;
+        size_t activeCount{0};  // pairs touching after the step, stay or not
+        float deltaTime{0.0f};
     };
 
+    // Include Stay contacts in each batch (off by default)
+    void setReportStayContacts(bool enabled);
+    bool getReportStayContacts();
+
+    // Forget tracked contacts so the next step reports every touching pair as Begin
+    void clearContacts();
+
     // -----------------------------------------------------------------
     // Modular Physics Laws
     // -----------------------------------------------------------------
@@ -179,11 +235,25 @@ namespace Physics {
         // Filter by tag membership
         bool limitByTag = false;
         std::string tag;
+        // attributeKey and tag interned once when edited, so matching an
+        // object compares integers. Edit through the setters below.
+        AttributeKey attributeId = AttributeStore::NoKey;
+        TagId tagId = TagSet::NoTag;
         // Explicit object selection by identifier
         bool limitByExplicitList = false;
-        std::vector<std::string> objectIdentifiers;
+        EntityNameSet objectIdentifiers;
         // Runtime-only explicit object pointers (not persisted)
         std::vector<Object*> explicitObjects;
+
+        void setAttributeFilter(const std::string& key, const std::string& value) {
+            attributeKey = key;
+            attributeValue = value;
+            attributeId = key.empty() ? AttributeStore::NoKey : AttributeStore::key(key);
+        }
+        void setTagFilter(const std::string& name) {
+            tag = name;
+            tagId = name.empty() ? TagSet::NoTag : TagSet::id(name);
+        }
     };
 
     struct PhysicsLaw {
@@ -14,14 +14,14 @@ void World::update(float dt){
     if(!_cameraPos) return;
     // ground Y based on object tagged as baseline ground if exists; fall back to index 1
     float groundY = 0.0f;
-    size_t groundIdx = 1;
-    for (size_t i = 0; i < _objects.size(); ++i) {
-        if (_objects[i] && _objects[i]->hasAttribute("baseline") && _objects[i]->getAttribute("baseline") == std::string("ground")) { groundIdx = i; break; }
+    const glm::mat4* groundT = nullptr;
+    for (const auto& record : _hot->records()) {
+        if (record.flags & ObjectHot::BaselineGround) { groundT = &record.transform; break; }
     }
-    if(_objects.size()>groundIdx && _objects[groundIdx]){
-        const glm::mat4& gT = _objects[groundIdx]->getTransform();
-        float scaleY = glm::length(glm::vec3(gT[1]));
-        groundY = gT[3][1] + 0.5f*scaleY;
+    if (!groundT && _objects.size() > 1 && _objects[1]) groundT = &_objects[1]->hot().transform;
+    if (groundT) {
+        float scaleY = glm::length(glm::vec3((*groundT)[1]));
+        groundY = (*groundT)[3][1] + 0.5f*scaleY;
     }
 
     // Sub-step large delta times to avoid physics explosions during blocking operations (e.g., saving)
@@ -29,15 +29,16 @@ void World::update(float dt){
     int steps = std::max(1, (int)std::ceil(dt / maxStep));
     float stepDt = dt / steps;
 
+    Physics::setEventScope(_eventScope);
     for (int s = 0; s < steps; ++s) {
         Physics::applyGravity(*_cameraPos, physicsEnabled, static_cast<Physics::GameMode>(mode), stepDt, groundY);
         if(mode==Mode::Survival && Physics::getFlying()) Physics::setFlying(false);
         if(physicsEnabled){
-            for(const auto& up: _objects) if(up) Physics::getBodyFor(up.get());
-            Physics::updateBodies(_objects, stepDt, 9.81f, 0.1f, groundY);
-            Physics::enforceCollisions(*_cameraPos, _objects);
+            Physics::updateBodies(*_hot, stepDt, 9.81f, 0.1f, groundY);
+            Physics::enforceCollisions(*_cameraPos, *_hot);
         }
     }
+    Physics::setEventScope(Core::EventBus::GlobalScope);
 }
 
 void World::drawGround(){
@@ -94,6 +95,11 @@ void World::render() const{}
 // Minimal change: render highlights for all objects if flagged
 // Note: For now, World::render is empty; we ensure callers render objects then we overlay outlines here if needed.
 
-void World::addObject(std::unique_ptr<Object> obj){ _objects.push_back(std::move(obj)); }
+void World::addObject(std::unique_ptr<Object> obj){
+    if (!obj) return;
+    // Hot flags (baseline role included) travel with the record
+    obj->moveHotTo(*_hot);
+    _objects.push_back(std::move(obj));
+}
 
 World::~World() = default; 
\ No newline at end of file
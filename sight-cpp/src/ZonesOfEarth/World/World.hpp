@@ -23,6 +23,9 @@ public:
     void addObject(std::unique_ptr<Object> obj);
     ~World();
     const std::vector<std::unique_ptr<Object>>& objects() const { return _objects; }
+    // Transforms, bounds and flags of the owned objects in one array; what
+    // the per-frame passes should walk instead of the objects themselves
+    const ObjectHotStore& hotStore() const { return *_hot; }
     // Access owned objects (read-only / mutable)
     const std::vector<std::unique_ptr<Object>>& getOwnedObjects() const { return _objects; }
     std::vector<std::unique_ptr<Object>>& getOwnedObjectsMutable() { return _objects; }
@@ -36,6 +39,10 @@ public:
     void unload();
     Mode getMode() const { return mode; }
 
+    // Collision events raised while stepping this world go to this scope
+    void setEventScope(Core::EventBus::ScopeId scope) { _eventScope = scope; }
+    Core::EventBus::ScopeId getEventScope() const { return _eventScope; }
+
     // Draw the ground plane — temporary until its integrated into the broader object and zone creation system
     void drawGround();
 
@@ -43,8 +50,11 @@ public:
     std::string getIdentifier() const override { return "World"; }
 
 private:
+    // Declared first so it outlives the objects that release records into it
+    std::unique_ptr<ObjectHotStore> _hot = std::make_unique<ObjectHotStore>();
     std::vector<std::unique_ptr<Object>> _objects;
     glm::vec3* _cameraPos = nullptr;
     bool physicsEnabled = true;
     Mode mode = Mode::Creative;
+    Core::EventBus::ScopeId _eventScope = Core::EventBus::GlobalScope;
 }; 
\ No newline at end of file
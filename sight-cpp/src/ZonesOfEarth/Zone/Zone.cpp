@@ -2,6 +2,7 @@
 #include "../World/World.hpp"
 #include <iostream>
 #include "GLFW/glfw3.h"
+#include "Rendering/StrokeCodec.hpp"
 
 using Scope = Zone::Scope;
 
@@ -34,6 +35,7 @@ Zone::Zone(const std::string& name, Scope scope)
     // Default background tint (deep space blue)
     r = 0.05f; g = 0.05f; b = 0.1f;
     _formation.addMember(_world.get());
+    createEventScopes();
 }
 
 Zone::Zone(const std::string& name, float rF, float gF, float bF, Scope scope)
@@ -41,16 +43,28 @@ Zone::Zone(const std::string& name, float rF, float gF, float bF, Scope scope)
 {
     r = rF; g = gF; b = bF;
     _formation.addMember(_world.get());
+    createEventScopes();
 }
 
 Zone::Zone(const Zone& other)
-    : _name(other._name), _scope(other._scope), _qualities(other._qualities), _deletable(other._deletable), _world(std::make_unique<World>()), _formation(Form::ShapeType::Cube, {1.0f, 1.0f, 1.0f})
+    : Singular(other), _name(other._name), _scope(other._scope), _qualities(other._qualities), _deletable(other._deletable), _world(std::make_unique<World>()), _formation(Form::ShapeType::Cube, {1.0f, 1.0f, 1.0f})
 {
     r = other.r; g = other.g; b = other.b;
     strokes = other.strokes;
     drawR = other.drawR; drawG = other.drawG; drawB = other.drawB;
     drawMode = other.drawMode; isDrawing = other.isDrawing;
     _formation.addMember(_world.get());
+    createEventScopes();
+}
+
+// Each Zone instance gets its own scopes; copies don't share listeners. The
+// copy made by operator= hands its scopes over and releases the old ones.
+void Zone::createEventScopes()
+{
+    _eventScope = Core::EventBus::ScopeHandle(Core::EventBus::GlobalScope, _name);
+    _formationScope = Core::EventBus::ScopeHandle(_eventScope.id(), _name + "/Formations");
+    _formation.setEventScope(_formationScope.id());
+    _world->setEventScope(_eventScope.id());
 }
 
 Zone& Zone::operator=(const Zone& other)
@@ -72,6 +86,10 @@ Zone& Zone::operator=(const Zone& other)
     std::swap(isDrawing, tmp.isDrawing);
     std::swap(_world, tmp._world);
     std::swap(_formation, tmp._formation);
+    std::swap(_eventScope, tmp._eventScope);
+    std::swap(_formationScope, tmp._formationScope);
+    ++_strokesRevision;
+    syncEntityName();
     return *this;
 }
 
@@ -144,8 +162,23 @@ void Zone::endStroke() {
             currentStroke.lineWidth = 2.0f; // Default line width
         }
         
+        // Keep only the points needed to stay within StrokeTolerance of the input
+        size_t rawCount = currentStroke.points.size() / 2;
+        std::vector<glm::vec2> raw(rawCount);
+        for (size_t i = 0; i < rawCount; ++i) {
+            raw[i] = glm::vec2(currentStroke.points[2 * i], currentStroke.points[2 * i + 1]);
+        }
+        std::vector<size_t> kept = StrokeCodec::simplify(raw, StrokeTolerance);
+        currentStroke.points.clear();
+        currentStroke.points.reserve(kept.size() * 2);
+        for (size_t index : kept) {
+            currentStroke.points.push_back(raw[index].x);
+            currentStroke.points.push_back(raw[index].y);
+        }
+
         strokes.push_back(currentStroke);
-        printf("End stroke, total points: %zu\n", currentStroke.points.size() / 2);
+        _strokeRenderer.strokeAppended(++_strokesRevision);
+        printf("End stroke, total points: %zu (simplified from %zu)\n", kept.size(), rawCount);
         currentStroke.points.clear();
     }
     
@@ -156,6 +189,33 @@ void Zone::endStroke() {
 void Zone::clearArt() {
     strokes.clear();
     currentStroke.points.clear();
+    ++_strokesRevision;
+}
+
+void Zone::removeStroke(size_t index) {
+    if (index >= strokes.size()) return;
+    strokes.erase(strokes.begin() + index);
+    _strokeRenderer.strokeRemoved(index, ++_strokesRevision);
+}
+
+std::vector<uint8_t> Zone::packStrokePoints(const std::vector<float>& points) {
+    std::vector<StrokeCodec::Sample> samples(points.size() / 2);
+    for (size_t i = 0; i < samples.size(); ++i) {
+        samples[i].position = glm::vec2(points[2 * i], points[2 * i + 1]);
+    }
+    // Already simplified in endStroke(); only quantize here
+    return StrokeCodec::toBytes(StrokeCodec::encode(samples, StrokeTolerance, false));
+}
+
+std::vector<float> Zone::unpackStrokePoints(const std::vector<uint8_t>& bytes) {
+    std::vector<float> points;
+    StrokeCodec::Encoded encoded;
+    if (!StrokeCodec::fromBytes(bytes, encoded)) return points;
+    for (const auto& sample : StrokeCodec::decode(encoded)) {
+        points.push_back(sample.position.x);
+        points.push_back(sample.position.y);
+    }
+    return points;
 }
 
 void Zone::setDrawColor(float r, float g, float b) {
@@ -333,17 +393,8 @@ void Zone::renderArt() const {
     
     // Advanced brush system (secondary)
     if (brushSystem) {
-        // Draw completed strokes first (these should use their original colors and settings)
-        for (const auto& stroke : strokes) {
-            if (stroke.points.size() < 4) continue; // Need at least 2 points
-            glLineWidth(stroke.lineWidth); // Use stored line width
-            glColor3f(stroke.r, stroke.g, stroke.b); // Use original stroke colors
-            glBegin(GL_LINE_STRIP);
-            for (size_t i = 0; i < stroke.points.size(); i += 2) {
-                glVertex2f(stroke.points[i], stroke.points[i + 1]);
-            }
-            glEnd();
-        }
+        // Draw completed strokes first (baked, with their original colors and widths)
+        _strokeRenderer.draw(strokes, _strokesRevision);
         
         // Draw current stroke in progress with brush system settings
         if (isDrawing && !currentStrokePoints.empty() && currentStrokePoints.size() >= 2) {
@@ -377,15 +428,7 @@ void Zone::renderArt() const {
         glLineWidth(2.0f);
         
         // Draw legacy strokes
-        for (const auto& stroke : strokes) {
-            if (stroke.points.size() < 4) continue; // Need at least 2 points
-            glColor3f(stroke.r, stroke.g, stroke.b);
-            glBegin(GL_LINE_STRIP);
-            for (size_t i = 0; i < stroke.points.size(); i += 2) {
-                glVertex2f(stroke.points[i], stroke.points[i + 1]);
-            }
-            glEnd();
-        }
+        _strokeRenderer.draw(strokes, _strokesRevision, 2.0f);
         
         // Draw the current stroke in progress (legacy)
         if (!currentStroke.points.empty()) {
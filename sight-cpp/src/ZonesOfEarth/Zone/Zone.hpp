@@ -8,17 +8,21 @@
 #include "Form/Object/Object.hpp"
 #include "Rendering/BrushSystem.hpp"
 #include "Rendering/DesignSystem.hpp"
+#include "Rendering/StrokeRenderer.hpp"
 
 class World; // forward decl
 
 class Zone : public Singular
 {
 public:
-    struct Stroke {
-        std::vector<float> points;
-        float r, g, b;
-        float lineWidth; // Store the line width used for this stroke
-    };
+    using Stroke = ArtStroke;
+
+    // Finished strokes are simplified to within this many pixels of the input
+    static constexpr float StrokeTolerance = 0.5f;
+
+    // Packed form of Stroke::points for saving (quantized, delta-encoded)
+    static std::vector<uint8_t> packStrokePoints(const std::vector<float>& points);
+    static std::vector<float> unpackStrokePoints(const std::vector<uint8_t>& bytes);
 
     enum class Scope {
         Global,
@@ -44,6 +48,9 @@ public:
     float r, g, b;            // background tint
     std::vector<Stroke> strokes; // Each stroke has its own color (legacy)
     Stroke currentStroke; // The stroke currently being drawn (legacy)
+    // Call after editing `strokes` directly (anything other than endStroke,
+    // removeStroke or clearArt) so the baked canvas geometry is rebuilt
+    void strokesChanged() { ++_strokesRevision; }
     
     // Drawing color (default to golden)
     float drawR = 1.0f, drawG = 0.9f, drawB = 0.2f;
@@ -90,6 +97,7 @@ public:
     void continueStroke(float x, float y);
     void endStroke();
     void clearArt();
+    void removeStroke(size_t index);
     virtual void renderArt() const;
     void setDrawColor(float r, float g, float b);
     glm::vec3 getCurrentColor() const { return glm::vec3(drawR, drawG, drawB); }
@@ -174,8 +182,15 @@ private:
     Deletability _deletable;
     std::unique_ptr<World> _world; // per-zone world instance
     Formations _formation;
+    // Released with the zone; a moved-from zone owns none
+    Core::EventBus::ScopeHandle _eventScope;
+    Core::EventBus::ScopeHandle _formationScope;
+    mutable StrokeRenderer _strokeRenderer; // baked geometry for `strokes`
+    uint64_t _strokesRevision = 0;          // bumped on every change to `strokes`
     // Removed cache; formation members are rebuilt on copy
 
+    void createEventScopes();
+
 public:
 // Bruh
 // USE POINTERS!!!!!
@@ -184,6 +199,9 @@ public:
     void load();
     void unload();
 
+    // EventBus scope of this zone (child of global, parent of its formation's)
+    Core::EventBus::ScopeId getEventScope() const { return _eventScope.id(); }
+
     // Singular interface
     std::string getIdentifier() const override { return _name; }
 };